@@ -34,6 +34,13 @@
 #include <kdl/overload.h>
 
 #include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
 
 #include "BenchmarkUtils.h"
 #include "../../test/src/Catch2.h"
@@ -66,4 +73,83 @@ namespace TrenchBroom {
             }
         }, "Add objects to AABB tree");
     }
+
+    using MoveAABB = AABBTree<double, 3, size_t>;
+    using MoveBOX = MoveAABB::Box;
+
+    static std::vector<MoveBOX> makeMoveBounds(const size_t count) {
+        auto rng = std::mt19937(0u);
+        auto coordinate = std::uniform_real_distribution<double>(-4096.0, 4096.0);
+
+        auto result = std::vector<MoveBOX>{};
+        result.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            const auto min = vm::vec3d(coordinate(rng), coordinate(rng), coordinate(rng));
+            result.emplace_back(min, min + vm::vec3d(64.0, 64.0, 64.0));
+        }
+        return result;
+    }
+
+    static void printTreeQuality(const MoveAABB& tree, const char* state) {
+        printf("AABB tree %s: height %zu, SAH cost %f\n", state, tree.height(), tree.sahCost());
+    }
+
+    TEST_CASE("AABBTreeBenchmark.moveNodes", "[AABBTreeBenchmark]") {
+        constexpr auto NodeCount = size_t(50'000);
+        constexpr auto MoveCount = size_t(10'000);
+
+        const auto initialBounds = makeMoveBounds(NodeCount);
+        auto bounds = initialBounds;
+
+        auto allIndices = std::vector<size_t>(NodeCount);
+        std::iota(std::begin(allIndices), std::end(allIndices), 0u);
+
+        // every fifth node is moved
+        auto indices = std::vector<size_t>(MoveCount);
+        for (size_t i = 0; i < MoveCount; ++i) {
+            indices[i] = i * (NodeCount / MoveCount);
+        }
+
+        MoveAABB tree;
+        const auto resetTree = [&]() {
+            bounds = initialBounds;
+            tree.clearAndBuild(allIndices, [&](const size_t i) { return bounds[i]; });
+        };
+
+        const auto moveBounds = [&](const vm::vec3d& delta) {
+            for (const auto i : indices) {
+                bounds[i] = MoveBOX(bounds[i].min + delta, bounds[i].max + delta);
+            }
+        };
+
+        resetTree();
+        printTreeQuality(tree, "before moving");
+
+        for (const auto& delta : { vm::vec3d(16.0, 8.0, 0.0), vm::vec3d(2048.0, 0.0, 0.0) }) {
+            const auto description = std::to_string(MoveCount) + " of " + std::to_string(NodeCount) + " nodes by " + std::to_string(static_cast<int>(delta.x())) + " units";
+
+            benchmarkLambda(resetTree, [&]() {
+                moveBounds(delta);
+                for (const auto i : indices) {
+                    tree.remove(i);
+                    tree.insert(bounds[i], i);
+                }
+            }, "remove and insert " + description);
+            printTreeQuality(tree, "after removing and inserting");
+
+            benchmarkLambda(resetTree, [&]() {
+                moveBounds(delta);
+                for (const auto i : indices) {
+                    tree.update(bounds[i], i);
+                }
+            }, "update " + description);
+            printTreeQuality(tree, "after updating");
+
+            benchmarkLambda(resetTree, [&]() {
+                moveBounds(delta);
+                tree.updateAll(indices, [&](const size_t i) { return bounds[i]; });
+            }, "update all " + description);
+            printTreeQuality(tree, "after updating all");
+        }
+    }
 }
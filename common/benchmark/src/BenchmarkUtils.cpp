@@ -0,0 +1,149 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BenchmarkUtils.h"
+
+#include "Ensure.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <numeric>
+
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+
+namespace TrenchBroom {
+    BenchmarkStatistics computeBenchmarkStatistics(std::vector<double> timesMs) {
+        ensure(!timesMs.empty(), "at least one time must be given");
+
+        std::sort(std::begin(timesMs), std::end(timesMs));
+
+        const auto runs = timesMs.size();
+        const auto mean = std::accumulate(std::begin(timesMs), std::end(timesMs), 0.0) / static_cast<double>(runs);
+        const auto median = runs % 2u == 1u
+            ? timesMs[runs / 2u]
+            : (timesMs[runs / 2u - 1u] + timesMs[runs / 2u]) / 2.0;
+
+        auto variance = 0.0;
+        for (const auto time : timesMs) {
+            variance += (time - mean) * (time - mean);
+        }
+        variance /= static_cast<double>(runs);
+
+        return BenchmarkStatistics{runs, timesMs.front(), timesMs.back(), mean, median, std::sqrt(variance)};
+    }
+
+    static void writeJsonString(std::ostream& stream, const std::string& str) {
+        stream << "\"";
+        for (const auto c : str) {
+            if (c == '"' || c == '\\') {
+                stream << '\\';
+            }
+            stream << c;
+        }
+        stream << "\"";
+    }
+
+    void reportBenchmark(const std::string& name, const BenchmarkStatistics& statistics) {
+        if (statistics.runs == 1u) {
+            printf("Time elapsed for '%s': %fms\n", name.c_str(), statistics.meanMs);
+        } else {
+            printf("Time elapsed for '%s': median %fms, mean %fms, min %fms, max %fms, std dev %fms (%zu runs)\n",
+                   name.c_str(), statistics.medianMs, statistics.meanMs, statistics.minMs, statistics.maxMs, statistics.stdDevMs, statistics.runs);
+        }
+
+        if (const auto* resultsPath = std::getenv("TB_BENCHMARK_RESULTS")) {
+            std::ofstream stream(resultsPath, std::ios::out | std::ios::app);
+            if (stream) {
+                stream << "{\"name\":";
+                writeJsonString(stream, name);
+                stream << ",\"runs\":" << statistics.runs;
+                stream << ",\"min_ms\":" << statistics.minMs;
+                stream << ",\"max_ms\":" << statistics.maxMs;
+                stream << ",\"mean_ms\":" << statistics.meanMs;
+                stream << ",\"median_ms\":" << statistics.medianMs;
+                stream << ",\"std_dev_ms\":" << statistics.stdDevMs;
+                stream << "}\n";
+            }
+        }
+    }
+
+    static std::atomic<size_t> liveAllocationCount(0u);
+    static std::atomic<size_t> liveAllocationBytes(0u);
+
+    AllocationStatistics liveAllocations() {
+        return AllocationStatistics{liveAllocationCount, liveAllocationBytes};
+    }
+
+    /**
+     * Returns the size that the allocator reserved for the given block, which includes any rounding. The size is not
+     * stored in a header in front of the block because on Windows, blocks allocated by the operator new of a DLL may
+     * be freed by the replaced operator delete, and vice versa.
+     */
+    static size_t allocationSize(void* ptr) {
+#if defined(_WIN32)
+        return _msize(ptr);
+#elif defined(__APPLE__)
+        return malloc_size(ptr);
+#else
+        return malloc_usable_size(ptr);
+#endif
+    }
+
+    static void* countedAllocate(const size_t size) {
+        auto* ptr = std::malloc(size == 0u ? 1u : size);
+        if (ptr != nullptr) {
+            ++liveAllocationCount;
+            liveAllocationBytes += allocationSize(ptr);
+        }
+        return ptr;
+    }
+
+    static void countedDeallocate(void* ptr) {
+        if (ptr != nullptr) {
+            --liveAllocationCount;
+            liveAllocationBytes -= allocationSize(ptr);
+            std::free(ptr);
+        }
+    }
+}
+
+// the array and nothrow variants of these call the replaced functions
+void* operator new(const size_t size) {
+    if (auto* ptr = TrenchBroom::countedAllocate(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    TrenchBroom::countedDeallocate(ptr);
+}
+
+void operator delete(void* ptr, size_t /* size */) noexcept {
+    TrenchBroom::countedDeallocate(ptr);
+}
@@ -21,6 +21,8 @@
 
 #include <chrono>
 #include <string>
+#include <utility>
+#include <vector>
 
 #ifdef __GNUC__
 #define TB_NOINLINE __attribute__((noinline))
@@ -28,6 +30,43 @@
 #define TB_NOINLINE
 #endif
 
+namespace TrenchBroom {
+    /**
+     * The number of times a benchmark is repeated by benchmarkLambda unless specified otherwise.
+     */
+    static constexpr size_t DefaultBenchmarkRuns = 5;
+
+    struct BenchmarkStatistics {
+        size_t runs;
+        double minMs;
+        double maxMs;
+        double meanMs;
+        double medianMs;
+        double stdDevMs;
+    };
+
+    BenchmarkStatistics computeBenchmarkStatistics(std::vector<double> timesMs);
+
+    /**
+     * Prints the given statistics. If the environment variable TB_BENCHMARK_RESULTS is set to a file path, the
+     * statistics are also appended to that file as a single line JSON object, so that the results of different
+     * builds can be compared.
+     */
+    void reportBenchmark(const std::string& name, const BenchmarkStatistics& statistics);
+
+    struct AllocationStatistics {
+        size_t count;
+        size_t bytes;
+    };
+
+    /**
+     * Returns the number and the total requested size of the memory blocks that are currently allocated with the
+     * global operator new. The benchmark executable replaces the global operator new and operator delete to track
+     * them. Memory allocated with malloc or with an over-aligned operator new is not tracked.
+     */
+    AllocationStatistics liveAllocations();
+}
+
 // the noinline is so you can see the timeLambda when profiling
 template<class L>
 TB_NOINLINE static void timeLambda(L&& lambda, const std::string& message) {
@@ -35,8 +74,35 @@ TB_NOINLINE static void timeLambda(L&& lambda, const std::string& message) {
     lambda();
     const auto end = std::chrono::high_resolution_clock::now();
 
-    printf("Time elapsed for '%s': %fms\n", message.c_str(),
-           std::chrono::duration<double>(end - start).count() * 1000.0);
+    const auto timeMs = std::chrono::duration<double>(end - start).count() * 1000.0;
+    TrenchBroom::reportBenchmark(message, TrenchBroom::computeBenchmarkStatistics({ timeMs }));
 }
 
+/**
+ * Runs the given setup and lambda the given number of times and reports statistics over the time spent in the
+ * lambda. The setup is not timed, it can be used to restore the state that the lambda modifies.
+ */
+template<class S, class L>
+TB_NOINLINE static TrenchBroom::BenchmarkStatistics benchmarkLambda(S&& setup, L&& lambda, const std::string& message, const size_t runs = TrenchBroom::DefaultBenchmarkRuns) {
+    std::vector<double> timesMs;
+    timesMs.reserve(runs);
 
+    for (size_t i = 0; i < runs; ++i) {
+        setup();
+
+        const auto start = std::chrono::high_resolution_clock::now();
+        lambda();
+        const auto end = std::chrono::high_resolution_clock::now();
+
+        timesMs.push_back(std::chrono::duration<double>(end - start).count() * 1000.0);
+    }
+
+    const auto statistics = TrenchBroom::computeBenchmarkStatistics(std::move(timesMs));
+    TrenchBroom::reportBenchmark(message, statistics);
+    return statistics;
+}
+
+template<class L>
+TB_NOINLINE static TrenchBroom::BenchmarkStatistics benchmarkLambda(L&& lambda, const std::string& message, const size_t runs = TrenchBroom::DefaultBenchmarkRuns) {
+    return benchmarkLambda([]() {}, std::forward<L>(lambda), message, runs);
+}
@@ -0,0 +1,89 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Assets/ModelDefinition.h"
+#include "EL/EvaluationContext.h"
+#include "EL/Expression.h"
+#include "EL/Value.h"
+#include "EL/VariableStore.h"
+#include "IO/ELParser.h"
+
+#include <string>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace EL {
+        static constexpr size_t NumEvaluations = 100'000;
+
+        // a model expression as found in Quake FGD files
+        static const std::string ModelExpression = R"({{
+            spawnflags & 1 -> { "path": ":progs/armor.mdl", "skin": 0 },
+            spawnflags & 2 -> { "path": ":progs/armor.mdl", "skin": 1 },
+            spawnflags & 4 -> { "path": ":progs/armor.mdl", "skin": 2 },
+            false -> ":progs/unused.mdl",
+            model
+        }})";
+
+        static std::vector<VariableTable> makeVariableStores() {
+            std::vector<VariableTable> result;
+            result.reserve(NumEvaluations);
+
+            for (size_t i = 0; i < NumEvaluations; ++i) {
+                auto& variableStore = result.emplace_back();
+                variableStore.declare("spawnflags", Value(std::to_string(i % 8u)));
+                variableStore.declare("model", Value(":progs/player.mdl"));
+                variableStore.declare("origin", Value(std::to_string(i) + " 0 0"));
+                variableStore.declare("targetname", Value("name_" + std::to_string(i)));
+            }
+
+            return result;
+        }
+
+        TEST_CASE("ExpressionBenchmark.evaluateModelExpression", "[ExpressionBenchmark]") {
+            const auto variableStores = makeVariableStores();
+
+            const auto expression = IO::ELParser::parseStrict(ModelExpression);
+            timeLambda([&]() {
+                for (const auto& variableStore : variableStores) {
+                    const auto context = EvaluationContext(variableStore);
+                    expression.evaluate(context);
+                }
+            }, "evaluate unoptimized model expression " + std::to_string(NumEvaluations) + " times");
+
+            auto optimizedExpression = IO::ELParser::parseStrict(ModelExpression);
+            optimizedExpression.optimize();
+            timeLambda([&]() {
+                for (const auto& variableStore : variableStores) {
+                    const auto context = EvaluationContext(variableStore);
+                    optimizedExpression.evaluate(context);
+                }
+            }, "evaluate optimized model expression " + std::to_string(NumEvaluations) + " times");
+
+            const auto modelDefinition = Assets::ModelDefinition(optimizedExpression);
+            timeLambda([&]() {
+                for (const auto& variableStore : variableStores) {
+                    modelDefinition.modelSpecification(variableStore);
+                }
+            }, "compute model specification " + std::to_string(NumEvaluations) + " times");
+        }
+    }
+}
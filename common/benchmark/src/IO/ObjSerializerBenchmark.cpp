@@ -0,0 +1,64 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IO/NodeWriter.h"
+#include "IO/ObjSerializer.h"
+#include "IO/Path.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/Entity.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/WorldNode.h"
+
+#include <kdl/result.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+
+#include <memory>
+#include <string>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        static constexpr size_t NumBrushes = 50'000;
+
+        TEST_CASE("ObjSerializerBenchmark.writeMap", "[ObjSerializerBenchmark]") {
+            const vm::bbox3 worldBounds(8192.0);
+
+            Model::WorldNode map(Model::Entity(), Model::MapFormat::Standard);
+            const Model::BrushBuilder builder(map.mapFormat(), worldBounds);
+
+            for (size_t i = 0; i < NumBrushes; ++i) {
+                const auto x = static_cast<FloatType>(i % 100u) * 64.0 - 3200.0;
+                const auto y = static_cast<FloatType>(i / 100u) * 8.0 - 2000.0;
+                const auto textureName = "texture" + std::to_string(i % 32u);
+                map.defaultLayer()->addChild(new Model::BrushNode(builder.createCuboid(vm::bbox3(vm::vec3(x, y, 0), vm::vec3(x + 32.0, y + 4.0, 64.0)), textureName).value()));
+            }
+
+            timeLambda([&]() {
+                NodeWriter writer(map, std::make_unique<ObjFileSerializer>(Path("ObjSerializerBenchmark.obj")));
+                writer.writeMap();
+            }, "export " + std::to_string(NumBrushes) + " brushes to OBJ");
+        }
+    }
+}
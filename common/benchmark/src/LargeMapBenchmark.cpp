@@ -0,0 +1,557 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Logger.h"
+#include "Assets/Palette.h"
+#include "Assets/Texture.h"
+#include "IO/DiskFileSystem.h"
+#include "IO/DiskIO.h"
+#include "IO/File.h"
+#include "IO/IdMipTextureReader.h"
+#include "IO/NodeWriter.h"
+#include "IO/Path.h"
+#include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushError.h"
+#include "Model/BrushNode.h"
+#include "Model/EditorContext.h"
+#include "Model/EntityNode.h"
+#include "Model/GroupNode.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/PickResult.h"
+#include "Model/VisibilityState.h"
+#include "Model/WorldNode.h"
+#include "Renderer/BrushRendererBrushCache.h"
+#include "View/Autosaver.h"
+#include "View/MapDocument.h"
+#include "View/MapDocumentCommandFacade.h"
+#include "View/NodeClipboard.h"
+#include "View/PasteType.h"
+
+#include <kdl/overload.h>
+#include <kdl/result.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/ray.h>
+#include <vecmath/vec.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "MapGenerator.h"
+#include "../../test/src/Catch2.h"
+#include "../../test/src/Model/TestGame.h"
+
+namespace TrenchBroom {
+    static const auto LargeMapWorldBounds = vm::bbox3(16384.0);
+
+    static MapGeneratorConfig largeMapConfig() {
+        auto config = MapGeneratorConfig();
+        config.brushCount = 20'000u;
+        config.facesPerBrush = 6u;
+        config.pointEntityCount = 2'000u;
+        config.brushEntityCount = 200u;
+        config.textureCount = 128u;
+        config.layerCount = 3u;
+        config.groupsPerLayer = 4u;
+        config.groupDepth = 3u;
+        return config;
+    }
+
+    static std::string largeMapDescription(const MapGeneratorConfig& config) {
+        return std::to_string(config.brushCount) + " brushes";
+    }
+
+    static std::vector<Model::BrushNode*> collectBrushNodes(Model::Node& node) {
+        std::vector<Model::BrushNode*> result;
+        node.accept(kdl::overload(
+            [] (auto&& thisLambda, Model::WorldNode* world)   { world->visitChildren(thisLambda); },
+            [] (auto&& thisLambda, Model::LayerNode* layer)   { layer->visitChildren(thisLambda); },
+            [] (auto&& thisLambda, Model::GroupNode* group)   { group->visitChildren(thisLambda); },
+            [] (auto&& thisLambda, Model::EntityNode* entity) { entity->visitChildren(thisLambda); },
+            [&](Model::BrushNode* brush)                      { result.push_back(brush); }
+        ));
+        return result;
+    }
+
+    static std::vector<Model::Node*> collectNodes(Model::Node& node) {
+        std::vector<Model::Node*> result;
+        node.accept(kdl::overload(
+            [&](auto&& thisLambda, Model::WorldNode* world)   { result.push_back(world); world->visitChildren(thisLambda); },
+            [&](auto&& thisLambda, Model::LayerNode* layer)   { result.push_back(layer); layer->visitChildren(thisLambda); },
+            [&](auto&& thisLambda, Model::GroupNode* group)   { result.push_back(group); group->visitChildren(thisLambda); },
+            [&](auto&& thisLambda, Model::EntityNode* entity) { result.push_back(entity); entity->visitChildren(thisLambda); },
+            [&](Model::BrushNode* brush)                      { result.push_back(brush); }
+        ));
+        return result;
+    }
+
+    static std::string writeMap(const Model::WorldNode& world) {
+        std::stringstream stream;
+        IO::NodeWriter writer(world, stream);
+        writer.writeMap();
+        return stream.str();
+    }
+
+    static std::shared_ptr<View::MapDocument> makeDocument(const MapGeneratorConfig& config) {
+        auto document = View::MapDocumentCommandFacade::newMapDocument();
+        document->newDocument(Model::MapFormat::Standard, LargeMapWorldBounds, std::make_shared<Model::TestGame>());
+        document->addNodes(generateMapNodes(*document->world(), document->worldBounds(), config));
+        return document;
+    }
+
+    TEST_CASE("LargeMapBenchmark.generateMap", "[LargeMapBenchmark]") {
+        // the generator is deterministic, so the same configuration must always produce the same map
+        auto config = largeMapConfig();
+        config.brushCount = 1'000u;
+        config.pointEntityCount = 100u;
+        config.brushEntityCount = 10u;
+
+        const auto world1 = generateMap(Model::MapFormat::Standard, LargeMapWorldBounds, config);
+        const auto world2 = generateMap(Model::MapFormat::Standard, LargeMapWorldBounds, config);
+        CHECK(collectBrushNodes(*world1).size() == config.brushCount);
+        CHECK(writeMap(*world1) == writeMap(*world2));
+    }
+
+    TEST_CASE("LargeMapBenchmark.createBrushes", "[LargeMapBenchmark]") {
+        const auto config = largeMapConfig();
+
+        benchmarkLambda([&]() {
+            generateMap(Model::MapFormat::Standard, LargeMapWorldBounds, config);
+        }, "generate map with " + largeMapDescription(config), 3u);
+    }
+
+    TEST_CASE("LargeMapBenchmark.memoryPerBrush", "[LargeMapBenchmark]") {
+        const auto config = largeMapConfig();
+
+        // generating the map once fills the node pools, so that the measured map reuses their slots and the
+        // measurement does not depend on how many pool blocks earlier benchmarks left behind
+        generateMap(Model::MapFormat::Standard, LargeMapWorldBounds, config);
+
+        const auto before = liveAllocations();
+        const auto world = generateMap(Model::MapFormat::Standard, LargeMapWorldBounds, config);
+        const auto after = liveAllocations();
+
+        const auto nodes = collectNodes(*world);
+        const auto brushCount = collectBrushNodes(*world).size();
+        REQUIRE(brushCount == config.brushCount);
+
+        size_t entityCount = 0u;
+        size_t parentCount = 0u;
+        for (const auto* node : nodes) {
+            if (dynamic_cast<const Model::EntityNode*>(node) != nullptr) {
+                ++entityCount;
+            }
+            if (node->hasChildren()) {
+                ++parentCount;
+            }
+        }
+
+        // the pooled nodes take up their slots in the pool blocks, but no allocations of their own
+        const auto pooledBytes = brushCount * sizeof(Model::BrushNode) + entityCount * sizeof(Model::EntityNode);
+        const auto heapBytes = after.bytes - before.bytes;
+        const auto heapCount = after.count - before.count;
+        const auto bytes = heapBytes + pooledBytes;
+
+        // Derive the old layout from the measurement: every node had two inline vectors instead of two pointers, nodes
+        // with children did not allocate their child vector separately, the pooled nodes were allocated one by one,
+        // and every brush node allocated its render cache when it was created. The padding that was removed by
+        // grouping the flags of a node is not accounted for.
+        const auto vectorBytes = sizeof(std::vector<Model::Node*>);
+        const auto inlineVectorBytes = 2u * (vectorBytes - sizeof(std::unique_ptr<std::vector<Model::Node*>>));
+        const auto cacheBytes = sizeof(Renderer::BrushRendererBrushCache);
+        const auto oldBytes = bytes + nodes.size() * inlineVectorBytes - parentCount * vectorBytes + brushCount * cacheBytes;
+        const auto oldCount = heapCount - parentCount + brushCount + entityCount + brushCount;
+
+        printf("Memory of %s (%zu nodes): %zu bytes in %zu heap allocations, %zu bytes per brush\n",
+            largeMapDescription(config).c_str(), nodes.size(), bytes, heapCount, bytes / brushCount);
+        printf("Memory of %s with the old node layout: %zu bytes in %zu heap allocations, %zu bytes per brush\n",
+            largeMapDescription(config).c_str(), oldBytes, oldCount, oldBytes / brushCount);
+        printf("Render cache per rendered brush: %zu bytes, allocated from a pool\n", cacheBytes);
+    }
+
+    TEST_CASE("LargeMapBenchmark.parseAndSave", "[LargeMapBenchmark]") {
+        const auto config = largeMapConfig();
+        const auto world = generateMap(Model::MapFormat::Standard, LargeMapWorldBounds, config);
+
+        std::string mapText;
+        benchmarkLambda([&]() {
+            mapText = writeMap(*world);
+        }, "save map with " + largeMapDescription(config));
+
+        std::unique_ptr<Model::WorldNode> parsedWorld;
+        benchmarkLambda([&]() {
+            IO::TestParserStatus status;
+            IO::WorldReader reader(mapText, Model::MapFormat::Standard);
+            parsedWorld = reader.read(LargeMapWorldBounds, status);
+        }, "parse map with " + largeMapDescription(config), 3u);
+
+        REQUIRE(parsedWorld != nullptr);
+        CHECK(collectBrushNodes(*parsedWorld).size() == config.brushCount);
+    }
+
+    TEST_CASE("LargeMapBenchmark.csgSubtract", "[LargeMapBenchmark]") {
+        const auto config = largeMapConfig();
+        const auto world = generateMap(Model::MapFormat::Standard, LargeMapWorldBounds, config);
+        const auto brushNodes = collectBrushNodes(*world);
+
+        const auto builder = Model::BrushBuilder(world->mapFormat(), LargeMapWorldBounds);
+        std::vector<Model::Brush> subtrahends;
+        for (size_t i = 0; i < 100u; ++i) {
+            const auto position = vm::vec3(static_cast<FloatType>(i % 10u), static_cast<FloatType>(i / 10u), 0.0) * 512.0 - vm::vec3(2560.0, 2560.0, 256.0);
+            subtrahends.push_back(builder.createCuboid(vm::bbox3(position, position + vm::vec3(256.0, 256.0, 512.0)), "cutter").value());
+        }
+
+        size_t resultCount = 0u;
+        benchmarkLambda([&]() {
+            resultCount = 0u;
+            for (const auto& subtrahend : subtrahends) {
+                for (const auto* brushNode : brushNodes) {
+                    const auto& minuend = brushNode->brush();
+                    if (minuend.bounds().intersects(subtrahend.bounds())) {
+                        minuend.subtract(world->mapFormat(), LargeMapWorldBounds, "texture", subtrahend)
+                            .visit(kdl::overload(
+                                [&](const std::vector<Model::Brush>& result) { resultCount += result.size(); },
+                                [] (const Model::BrushError&)                 {}
+                            ));
+                    }
+                }
+            }
+        }, "subtract " + std::to_string(subtrahends.size()) + " brushes from " + largeMapDescription(config));
+        CHECK(resultCount > 0u);
+    }
+
+    TEST_CASE("LargeMapBenchmark.pick", "[LargeMapBenchmark]") {
+        const auto config = largeMapConfig();
+        auto document = makeDocument(config);
+
+        std::vector<vm::ray3> pickRays;
+        for (int x = -20; x < 20; ++x) {
+            for (int y = -20; y < 20; ++y) {
+                pickRays.emplace_back(vm::vec3(x * 200, y * 200, 8000), vm::vec3::neg_z());
+            }
+        }
+
+        size_t hitCount = 0u;
+        benchmarkLambda([&]() {
+            hitCount = 0u;
+            for (const auto& pickRay : pickRays) {
+                Model::PickResult pickResult;
+                document->pick(pickRay, pickResult);
+                hitCount += pickResult.size();
+            }
+        }, "pick " + largeMapDescription(config) + " with " + std::to_string(pickRays.size()) + " rays");
+        CHECK(hitCount > 0u);
+    }
+
+    TEST_CASE("LargeMapBenchmark.evaluateVisibility", "[LargeMapBenchmark]") {
+        const auto config = largeMapConfig();
+        const auto world = generateMap(Model::MapFormat::Standard, LargeMapWorldBounds, config);
+        const auto nodes = collectNodes(*world);
+
+        // a hidden layer makes the groups and brush entities in it check all of their children
+        REQUIRE_FALSE(world->customLayers().empty());
+        world->customLayers().front()->setVisibilityState(Model::VisibilityState::Visibility_Hidden);
+
+        Model::EditorContext editorContext;
+        size_t selectableCount = 0u;
+        const auto evaluateSelectable = [&]() {
+            selectableCount = 0u;
+            for (const auto* node : nodes) {
+                if (editorContext.selectable(node)) {
+                    ++selectableCount;
+                }
+            }
+        };
+
+        const auto description = std::to_string(nodes.size()) + " nodes of " + largeMapDescription(config);
+        benchmarkLambda([&]() {
+            // changing the editor context invalidates all cached visibilities
+            editorContext.reset();
+        }, evaluateSelectable, "evaluate selectability of " + description);
+        const auto uncachedCount = selectableCount;
+
+        benchmarkLambda(evaluateSelectable, "evaluate cached selectability of " + description);
+        CHECK(selectableCount == uncachedCount);
+        CHECK(selectableCount > 0u);
+        CHECK(selectableCount < nodes.size());
+    }
+
+    TEST_CASE("LargeMapBenchmark.selectAndUndo", "[LargeMapBenchmark]") {
+        const auto config = largeMapConfig();
+        auto document = makeDocument(config);
+
+        benchmarkLambda([&]() {
+            document->selectAllNodes();
+            document->deselectAll();
+        }, "select and deselect all nodes of " + largeMapDescription(config));
+
+        document->selectAllNodes();
+        REQUIRE(document->translateObjects(vm::vec3(16.0, 16.0, 0.0)));
+
+        benchmarkLambda([&]() {
+            document->undoCommand();
+            document->redoCommand();
+        }, "undo and redo translating " + largeMapDescription(config));
+    }
+
+    TEST_CASE("LargeMapBenchmark.transformGroup", "[LargeMapBenchmark]") {
+        auto config = largeMapConfig();
+        config.pointEntityCount = 0u;
+        config.brushEntityCount = 0u;
+        config.layerCount = 1u;
+        config.groupsPerLayer = 0u;
+        auto document = makeDocument(config);
+
+        document->selectAllNodes();
+        auto* group = document->groupSelection("group");
+        REQUIRE(group != nullptr);
+        REQUIRE(group->childCount() == config.brushCount);
+
+        document->deselectAll();
+        document->select(group);
+
+        benchmarkLambda([&]() {
+            REQUIRE(document->translateObjects(vm::vec3(16.0, 16.0, 0.0)));
+            REQUIRE(document->translateObjects(vm::vec3(-16.0, -16.0, 0.0)));
+        }, "translate a group containing " + largeMapDescription(config) + " back and forth");
+    }
+
+    TEST_CASE("LargeMapBenchmark.copyAndPaste", "[LargeMapBenchmark]") {
+        const auto config = largeMapConfig();
+        auto document = makeDocument(config);
+
+        // every run pastes into the original map, so the paste transaction of the previous run is undone
+        auto pasted = false;
+        const auto resetDocument = [&]() {
+            if (pasted) {
+                document->undoCommand();
+            }
+            document->deselectAll();
+            document->selectAllNodes();
+            pasted = true;
+        };
+
+        benchmarkLambda(resetDocument, [&]() {
+            const auto str = document->serializeSelectedNodes();
+            const View::Transaction transaction(document, "Paste");
+            CHECK(document->paste(str) == View::PasteType::Node);
+        }, "copy and paste " + largeMapDescription(config) + " as text", 3u);
+
+        pasted = false;
+        View::NodeClipboard clipboard;
+        benchmarkLambda(resetDocument, [&]() {
+            const auto mapFormat = document->world()->mapFormat();
+            const auto id = clipboard.setNodes(mapFormat, document->worldBounds(), document->cloneSelectedNodes());
+            const View::Transaction transaction(document, "Paste");
+            CHECK(document->paste(clipboard.cloneNodes(id, mapFormat, document->worldBounds())) == View::PasteType::Node);
+        }, "copy and paste " + largeMapDescription(config) + " through the node clipboard", 3u);
+    }
+
+    TEST_CASE("LargeMapBenchmark.validateIssues", "[LargeMapBenchmark]") {
+        const auto config = largeMapConfig();
+        auto document = makeDocument(config);
+
+        const auto& issueGenerators = document->world()->registeredIssueGenerators();
+        size_t issueCount = 0u;
+        const auto validateIssues = [&](Model::Node* node) {
+            node->invalidateIssues();
+            issueCount += node->issues(issueGenerators).size();
+        };
+
+        benchmarkLambda([&]() {
+            issueCount = 0u;
+            document->world()->accept(kdl::overload(
+                [&](auto&& thisLambda, Model::WorldNode* world)   { validateIssues(world); world->visitChildren(thisLambda); },
+                [&](auto&& thisLambda, Model::LayerNode* layer)   { validateIssues(layer); layer->visitChildren(thisLambda); },
+                [&](auto&& thisLambda, Model::GroupNode* group)   { validateIssues(group); group->visitChildren(thisLambda); },
+                [&](auto&& thisLambda, Model::EntityNode* entity) { validateIssues(entity); entity->visitChildren(thisLambda); },
+                [&](Model::BrushNode* brush)                      { validateIssues(brush); }
+            ));
+        }, "validate issues of " + largeMapDescription(config));
+    }
+
+    /**
+     * Returns a Quake mip texture with the given name and size whose pixels are filled with a pattern.
+     */
+    static std::shared_ptr<IO::File> makeMipTexture(const std::string& name, const size_t size) {
+        static constexpr size_t MipLevels = 4u;
+        static constexpr size_t HeaderSize = 16u + 2u * 4u + MipLevels * 4u;
+
+        size_t fileSize = HeaderSize;
+        for (size_t i = 0; i < MipLevels; ++i) {
+            fileSize += (size >> i) * (size >> i);
+        }
+
+        auto buffer = std::make_unique<char[]>(fileSize);
+        std::memset(buffer.get(), 0, HeaderSize);
+        std::strncpy(buffer.get(), name.c_str(), 15u);
+
+        const auto writeInt = [&](const size_t offset, const size_t value) {
+            const auto int32 = static_cast<int32_t>(value);
+            std::memcpy(buffer.get() + offset, &int32, sizeof(int32));
+        };
+
+        writeInt(16u, size);
+        writeInt(20u, size);
+
+        size_t offset = HeaderSize;
+        for (size_t i = 0; i < MipLevels; ++i) {
+            writeInt(24u + i * 4u, offset);
+
+            const auto mipSize = (size >> i) * (size >> i);
+            for (size_t j = 0; j < mipSize; ++j) {
+                buffer[offset + j] = static_cast<char>((j * 7u + i) % 255u);
+            }
+            offset += mipSize;
+        }
+
+        return std::make_shared<IO::OwningBufferFile>(IO::Path(name + ".D"), std::move(buffer), fileSize);
+    }
+
+    TEST_CASE("LargeMapBenchmark.autosave", "[LargeMapBenchmark]") {
+        using namespace std::literals::chrono_literals;
+
+        const auto config = largeMapConfig();
+        auto document = makeDocument(config);
+
+        const auto dir = IO::Disk::getCurrentWorkingDir() + IO::Path("LargeMapBenchmark_autosave");
+        IO::Disk::ensureDirectoryExists(dir);
+        document->saveDocumentAs(dir + IO::Path("large.map"));
+
+        benchmarkLambda([&]() {
+            document->saveDocumentTo(dir + IO::Path("large_copy.map"));
+        }, "save " + largeMapDescription(config) + " on the calling thread", 3u);
+
+        NullLogger logger;
+        View::Autosaver autosaver(document, 0s);
+
+        // only the snapshot is taken on the calling thread, the backup is written in the background
+        benchmarkLambda([&]() {
+            autosaver.waitForPendingSave(logger);
+            document->addNode(new Model::EntityNode(), document->currentLayer());
+        }, [&]() {
+            autosaver.triggerAutosave(logger);
+        }, "stall the calling thread to autosave " + largeMapDescription(config), 3u);
+
+        autosaver.waitForPendingSave(logger);
+    }
+
+    static std::string readFile(const IO::Path& path) {
+        std::ifstream stream(path.asString(), std::ios::in | std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+
+    static void writeFile(const IO::Path& path, const std::string& contents) {
+        std::ofstream stream(path.asString(), std::ios::out | std::ios::binary);
+        stream << contents;
+    }
+
+    TEST_CASE("LargeMapBenchmark.autosaveJournal", "[LargeMapBenchmark]") {
+        using namespace std::literals::chrono_literals;
+
+        const auto config = largeMapConfig();
+        auto document = makeDocument(config);
+
+        const auto dir = IO::Disk::getCurrentWorkingDir() + IO::Path("LargeMapBenchmark_journal");
+        IO::Disk::ensureDirectoryExists(dir);
+        document->saveDocumentAs(dir + IO::Path("large.map"));
+
+        const auto backupPath = dir + IO::Path("autosave/large.1.map");
+        const auto journalPath = dir + IO::Path("autosave/large.journal");
+
+        static constexpr size_t EditCount = 20u;
+        static constexpr size_t BrushesPerEdit = 4u;
+
+        NullLogger logger;
+        {
+            View::Autosaver autosaver(document, 0s, 50u, EditCount);
+            autosaver.triggerAutosave(logger);
+            autosaver.waitForPendingSave(logger);
+
+            // every autosave after the first one only appends the moved brushes to the journal
+            const auto brushes = collectBrushNodes(*document->world());
+            REQUIRE(brushes.size() >= EditCount * BrushesPerEdit);
+            for (size_t i = 0u; i < EditCount; ++i) {
+                const auto first = std::next(std::begin(brushes), static_cast<std::ptrdiff_t>(i * BrushesPerEdit));
+                document->select(std::vector<Model::Node*>(first, std::next(first, BrushesPerEdit)));
+                REQUIRE(document->translateObjects(vm::vec3(16.0, 0.0, 0.0)));
+                document->deselectAll();
+
+                autosaver.triggerAutosave(logger);
+                autosaver.waitForPendingSave(logger);
+            }
+        }
+
+        const auto backupSize = readFile(backupPath).size();
+        const auto journal = readFile(journalPath);
+        REQUIRE(!journal.empty());
+
+        printf("Bytes written per autosave of %s: full backup %zu, journal entry %zu\n",
+            largeMapDescription(config).c_str(), backupSize, journal.size() / EditCount);
+
+        // recovery replays the journal into a new backup and deletes it, so it is restored before every run
+        benchmarkLambda([&]() {
+            writeFile(journalPath, journal);
+        }, [&]() {
+            View::Autosaver autosaver(document, 0s, 50u, EditCount);
+            autosaver.triggerAutosave(logger);
+            autosaver.waitForPendingSave(logger);
+        }, "recover " + largeMapDescription(config) + " from a journal with " + std::to_string(EditCount) + " entries", 3u);
+    }
+
+    TEST_CASE("LargeMapBenchmark.loadTextures", "[LargeMapBenchmark]") {
+        const auto config = largeMapConfig();
+
+        std::vector<std::shared_ptr<IO::File>> files;
+        for (size_t i = 0; i < config.textureCount; ++i) {
+            files.push_back(makeMipTexture("texture" + std::to_string(i), 256u));
+        }
+
+        std::vector<unsigned char> paletteData(768u);
+        for (size_t i = 0; i < paletteData.size(); ++i) {
+            paletteData[i] = static_cast<unsigned char>(i % 256u);
+        }
+
+        const IO::DiskFileSystem fs(IO::Disk::getCurrentWorkingDir());
+        const IO::TextureReader::TextureNameStrategy nameStrategy;
+        NullLogger logger;
+        const IO::IdMipTextureReader reader(nameStrategy, fs, logger, Assets::Palette(paletteData));
+
+        std::vector<Assets::Texture> textures;
+        benchmarkLambda([&]() {
+            textures.clear();
+            for (const auto& file : files) {
+                textures.push_back(reader.readTexture(file));
+            }
+        }, "read " + std::to_string(files.size()) + " mip textures");
+        CHECK(textures.size() == files.size());
+    }
+}
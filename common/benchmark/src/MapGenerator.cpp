@@ -0,0 +1,203 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapGenerator.h"
+
+#include "Ensure.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/Entity.h"
+#include "Model/EntityNode.h"
+#include "Model/EntityProperties.h"
+#include "Model/Group.h"
+#include "Model/GroupNode.h"
+#include "Model/Layer.h"
+#include "Model/LayerNode.h"
+#include "Model/WorldNode.h"
+
+#include <kdl/result.h>
+#include <kdl/string_utils.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/constants.h>
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+
+namespace TrenchBroom {
+    /**
+     * The standard distributions produce different values on different standard library implementations, so we
+     * derive all random values directly from the engine to keep the generated maps identical on all platforms.
+     */
+    static size_t randomIndex(std::mt19937& random, const size_t count) {
+        return static_cast<size_t>(random()) % count;
+    }
+
+    static FloatType randomCoordinate(std::mt19937& random, const FloatType min, const FloatType max, const FloatType gridSize) {
+        const auto steps = static_cast<size_t>((max - min) / gridSize);
+        return min + static_cast<FloatType>(randomIndex(random, steps + 1u)) * gridSize;
+    }
+
+    static vm::vec3 randomPosition(std::mt19937& random, const MapGeneratorConfig& config, const FloatType margin) {
+        const auto max = config.mapSize / 2.0 - margin;
+        return vm::vec3(
+            randomCoordinate(random, -max, max, 8.0),
+            randomCoordinate(random, -max, max, 8.0),
+            randomCoordinate(random, -max, max, 8.0));
+    }
+
+    /**
+     * Creates a prism whose base is a regular polygon with the configured number of sides, rounded to integer
+     * coordinates.
+     */
+    static Model::BrushNode* createBrushNode(std::mt19937& random, const Model::BrushBuilder& builder, const MapGeneratorConfig& config) {
+        static constexpr FloatType MaxRadius = 128.0;
+        static constexpr FloatType MaxHeight = 256.0;
+
+        const auto sides = config.facesPerBrush - 2u;
+        const auto center = randomPosition(random, config, MaxRadius + MaxHeight);
+        const auto radius = randomCoordinate(random, 16.0, MaxRadius, 8.0);
+        const auto height = randomCoordinate(random, 16.0, MaxHeight, 8.0);
+        const auto textureName = "texture" + std::to_string(randomIndex(random, config.textureCount));
+
+        std::vector<vm::vec3> points;
+        points.reserve(2u * sides);
+        for (size_t i = 0; i < sides; ++i) {
+            const auto angle = vm::C::two_pi() * static_cast<FloatType>(i) / static_cast<FloatType>(sides);
+            const auto x = std::round(center.x() + radius * std::cos(angle));
+            const auto y = std::round(center.y() + radius * std::sin(angle));
+            points.emplace_back(x, y, center.z());
+            points.emplace_back(x, y, center.z() + height);
+        }
+
+        return new Model::BrushNode(builder.createBrush(points, textureName).value());
+    }
+
+    static Model::EntityNode* createPointEntityNode(std::mt19937& random, const MapGeneratorConfig& config) {
+        const auto origin = randomPosition(random, config, 16.0);
+        return new Model::EntityNode({
+            {Model::PropertyKeys::Classname, "light"},
+            {Model::PropertyKeys::Origin, kdl::str_to_string(origin.x(), " ", origin.y(), " ", origin.z())},
+            {"light", std::to_string(100u + randomIndex(random, 200u))}
+        });
+    }
+
+    static Model::EntityNode* createBrushEntityNode(std::mt19937& random, const Model::BrushBuilder& builder, const MapGeneratorConfig& config, const size_t index) {
+        auto* entityNode = new Model::EntityNode({
+            {Model::PropertyKeys::Classname, "func_door"},
+            {"targetname", "door" + std::to_string(index)}
+        });
+        for (size_t i = 0; i < config.brushesPerBrushEntity; ++i) {
+            entityNode->addChild(createBrushNode(random, builder, config));
+        }
+        return entityNode;
+    }
+
+    /**
+     * Returns the nodes to which the generated objects of the given layer are added: the innermost groups of the
+     * layer's group hierarchies, or the layer itself if it contains no groups.
+     */
+    static std::vector<Model::Node*> createGroupNodes(Model::Node* layerNode, const MapGeneratorConfig& config, std::vector<Model::Node*>& layerChildren) {
+        if (config.groupsPerLayer == 0u) {
+            return { layerNode };
+        }
+
+        std::vector<Model::Node*> result;
+        for (size_t i = 0; i < config.groupsPerLayer; ++i) {
+            auto* groupNode = new Model::GroupNode(Model::Group("group" + std::to_string(i)));
+            layerChildren.push_back(groupNode);
+
+            for (size_t depth = 1; depth < config.groupDepth; ++depth) {
+                auto* childGroupNode = new Model::GroupNode(Model::Group("group" + std::to_string(i) + "_" + std::to_string(depth)));
+                groupNode->addChild(childGroupNode);
+                groupNode = childGroupNode;
+            }
+
+            result.push_back(groupNode);
+        }
+        return result;
+    }
+
+    std::map<Model::Node*, std::vector<Model::Node*>> generateMapNodes(Model::WorldNode& world, const vm::bbox3& worldBounds, const MapGeneratorConfig& config) {
+        ensure(config.facesPerBrush >= 5u, "brushes must have at least five faces");
+        ensure(config.textureCount > 0u, "at least one texture is required");
+        ensure(config.layerCount > 0u, "at least one layer is required");
+
+        auto random = std::mt19937(config.seed);
+        const auto builder = Model::BrushBuilder(world.mapFormat(), worldBounds);
+
+        std::map<Model::Node*, std::vector<Model::Node*>> result;
+
+        std::vector<Model::Node*> containers;
+        {
+            auto& defaultLayerChildren = result[world.defaultLayer()];
+            const auto groupNodes = createGroupNodes(world.defaultLayer(), config, defaultLayerChildren);
+            containers.insert(std::end(containers), std::begin(groupNodes), std::end(groupNodes));
+        }
+
+        for (size_t i = 1; i < config.layerCount; ++i) {
+            auto layer = Model::Layer("layer" + std::to_string(i));
+            layer.setSortIndex(static_cast<int>(i));
+
+            auto* layerNode = new Model::LayerNode(std::move(layer));
+            result[&world].push_back(layerNode);
+
+            std::vector<Model::Node*> layerChildren;
+            const auto groupNodes = createGroupNodes(layerNode, config, layerChildren);
+            layerNode->addChildren(layerChildren);
+            containers.insert(std::end(containers), std::begin(groupNodes), std::end(groupNodes));
+        }
+
+        const auto addToContainer = [&](Model::Node* node) {
+            auto* container = containers[randomIndex(random, containers.size())];
+            if (container == world.defaultLayer()) {
+                result[container].push_back(node);
+            } else {
+                container->addChild(node);
+            }
+        };
+
+        const auto brushEntityCount = std::min(config.brushEntityCount, config.brushCount / std::max(config.brushesPerBrushEntity, size_t(1)));
+        for (size_t i = 0; i < brushEntityCount; ++i) {
+            addToContainer(createBrushEntityNode(random, builder, config, i));
+        }
+
+        const auto worldBrushCount = config.brushCount - brushEntityCount * config.brushesPerBrushEntity;
+        for (size_t i = 0; i < worldBrushCount; ++i) {
+            addToContainer(createBrushNode(random, builder, config));
+        }
+
+        for (size_t i = 0; i < config.pointEntityCount; ++i) {
+            addToContainer(createPointEntityNode(random, config));
+        }
+
+        return result;
+    }
+
+    std::unique_ptr<Model::WorldNode> generateMap(const Model::MapFormat mapFormat, const vm::bbox3& worldBounds, const MapGeneratorConfig& config) {
+        auto world = std::make_unique<Model::WorldNode>(Model::Entity(), mapFormat);
+        for (const auto& [parent, children] : generateMapNodes(*world, worldBounds, config)) {
+            parent->addChildren(children);
+        }
+        return world;
+    }
+}
@@ -0,0 +1,72 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "FloatType.h"
+#include "Model/MapFormat.h"
+
+#include <vecmath/forward.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        class Node;
+        class WorldNode;
+    }
+
+    /**
+     * Controls the contents of a synthetic map. The same configuration always generates the same map.
+     */
+    struct MapGeneratorConfig {
+        /** The total number of brushes, including those that belong to brush entities. */
+        size_t brushCount = 10'000u;
+        /** The number of faces of each brush; brushes are prisms, so this must be at least 5. */
+        size_t facesPerBrush = 6u;
+        size_t pointEntityCount = 1'000u;
+        size_t brushEntityCount = 100u;
+        size_t brushesPerBrushEntity = 4u;
+        /** The number of distinct texture names used by the brushes. */
+        size_t textureCount = 64u;
+        /** The number of layers, including the default layer. */
+        size_t layerCount = 1u;
+        /** The number of top level groups in each layer. If this is 0, no groups are generated. */
+        size_t groupsPerLayer = 0u;
+        /** The nesting depth of each top level group. */
+        size_t groupDepth = 1u;
+        /** The generated objects are placed within a cube of this size centered at the origin. */
+        FloatType mapSize = 8192.0;
+        unsigned int seed = 0u;
+    };
+
+    /**
+     * Generates the layers, groups, entities and brushes of a synthetic map for the given world. The nodes are not
+     * added to the world; the returned map contains them by their parent node so that they can be added by calling
+     * MapDocument::addNodes or by adding them to their parents directly.
+     */
+    std::map<Model::Node*, std::vector<Model::Node*>> generateMapNodes(Model::WorldNode& world, const vm::bbox3& worldBounds, const MapGeneratorConfig& config);
+
+    /**
+     * Returns a new world of the given format that contains a synthetic map.
+     */
+    std::unique_ptr<Model::WorldNode> generateMap(Model::MapFormat mapFormat, const vm::bbox3& worldBounds, const MapGeneratorConfig& config);
+}
@@ -0,0 +1,151 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushError.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushFaceAttributes.h"
+#include "Model/MapFormat.h"
+#include "Model/ModelUtils.h"
+
+#include <kdl/result.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
+#include <vecmath/vec.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        static constexpr size_t NumBrushes = 50'000;
+
+        static std::vector<Brush> makeBrushes(const vm::bbox3& worldBounds) {
+            const BrushBuilder builder(MapFormat::Standard, worldBounds);
+
+            std::vector<Brush> result;
+            result.reserve(NumBrushes);
+
+            for (size_t i = 0; i < NumBrushes; ++i) {
+                const auto x = static_cast<FloatType>(i % 100u) * 64.0 - 3200.0;
+                const auto y = static_cast<FloatType>(i / 100u) * 8.0 - 2000.0;
+                result.push_back(builder.createCuboid(vm::bbox3(vm::vec3(x, y, 0), vm::vec3(x + 32.0, y + 4.0, 64.0)), "texture").value());
+            }
+
+            return result;
+        }
+
+        static size_t transformBrushes(const vm::bbox3& worldBounds, std::vector<Brush>& brushes, const vm::mat4x4& transformation) {
+            size_t transformed = 0;
+            for (auto& brush : brushes) {
+                if (brush.transform(worldBounds, transformation, false).is_success()) {
+                    ++transformed;
+                }
+            }
+            return transformed;
+        }
+
+        TEST_CASE("BrushBenchmark.transform", "[BrushBenchmark]") {
+            const vm::bbox3 worldBounds(8192.0);
+            auto brushes = makeBrushes(worldBounds);
+
+            size_t transformed = 0;
+            timeLambda([&]() {
+                transformed = transformBrushes(worldBounds, brushes, vm::translation_matrix(vm::vec3(16, 16, 0)));
+            }, "translate " + std::to_string(NumBrushes) + " brushes");
+            CHECK(transformed == NumBrushes);
+
+            timeLambda([&]() {
+                transformed = transformBrushes(worldBounds, brushes, vm::rotation_matrix(0.0, 0.0, vm::to_radians(90.0)));
+            }, "rotate " + std::to_string(NumBrushes) + " brushes by 90 degrees");
+            CHECK(transformed == NumBrushes);
+
+            timeLambda([&]() {
+                transformed = transformBrushes(worldBounds, brushes, vm::mirror_matrix<FloatType>(vm::axis::x));
+            }, "mirror " + std::to_string(NumBrushes) + " brushes, which rebuilds their geometry");
+            CHECK(transformed == NumBrushes);
+        }
+
+        static size_t estimateTotalMemorySize(const std::vector<Brush>& brushes) {
+            size_t result = 0u;
+            for (const auto& brush : brushes) {
+                result += estimateMemorySize(brush);
+            }
+            return result;
+        }
+
+        TEST_CASE("BrushBenchmark.copyAndChangeTexture", "[BrushBenchmark]") {
+            const vm::bbox3 worldBounds(8192.0);
+            const auto brushes = makeBrushes(worldBounds);
+            const auto unsharedSize = estimateTotalMemorySize(brushes);
+
+            // duplicating brushes and taking undo snapshots both copy the brushes
+            std::vector<Brush> copies;
+            timeLambda([&]() {
+                copies = brushes;
+            }, "copy " + std::to_string(NumBrushes) + " brushes");
+
+            timeLambda([&]() {
+                for (auto& brush : copies) {
+                    for (auto& face : brush.faces()) {
+                        auto attributes = face.attributes();
+                        attributes.setTextureName("other");
+                        face.setAttributes(attributes);
+                    }
+                }
+            }, "change the texture of " + std::to_string(NumBrushes) + " copied brushes");
+            CHECK(copies.front().geometryShareCount() == 2u);
+
+            const auto sharedSize = estimateTotalMemorySize(copies);
+            printf("Estimated memory held by %zu brush snapshots: %zu bytes, %zu bytes without shared geometry\n",
+                NumBrushes, sharedSize, unsharedSize);
+        }
+
+        TEST_CASE("BrushBenchmark.copyFaces", "[BrushBenchmark]") {
+            const vm::bbox3 worldBounds(8192.0);
+            const auto brushes = makeBrushes(worldBounds);
+
+            size_t faceCount = 0u;
+            for (const auto& brush : brushes) {
+                faceCount += brush.faceCount();
+            }
+
+            // the texture coordinate system is copied along with each face
+            std::vector<BrushFace> faces;
+            benchmarkLambda([&]() {
+                faces.clear();
+                faces.reserve(faceCount);
+            }, [&]() {
+                for (const auto& brush : brushes) {
+                    for (const auto& face : brush.faces()) {
+                        faces.push_back(face);
+                    }
+                }
+            }, "copy " + std::to_string(faceCount) + " faces");
+            CHECK(faces.size() == faceCount);
+        }
+    }
+}
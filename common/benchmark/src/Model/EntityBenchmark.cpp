@@ -0,0 +1,102 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/Entity.h"
+#include "Model/EntityProperties.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        static constexpr size_t NumEntities = 100'000;
+
+        static std::vector<Entity> makeEntities() {
+            std::vector<Entity> result;
+            result.reserve(NumEntities);
+
+            for (size_t i = 0; i < NumEntities; ++i) {
+                const auto index = std::to_string(i);
+                result.emplace_back(std::vector<EntityProperty>{
+                    EntityProperty("_color", "255 255 255"),
+                    EntityProperty("light", "300"),
+                    EntityProperty("style", "0"),
+                    EntityProperty("wait", "1"),
+                    EntityProperty("delay", "0.5"),
+                    EntityProperty("angle", "90"),
+                    EntityProperty(PropertyKeys::Spawnflags, "1"),
+                    EntityProperty(PropertyKeys::Origin, index + " 0 0"),
+                    EntityProperty(PropertyKeys::Target, "target_" + index),
+                    EntityProperty(PropertyKeys::Targetname, "name_" + index),
+                    EntityProperty(PropertyKeys::Classname, "light"),
+                });
+            }
+
+            return result;
+        }
+
+        TEST_CASE("EntityBenchmark.propertyLookup", "[EntityBenchmark]") {
+            const auto entities = makeEntities();
+            const auto targetnameByValue = std::string("targetname");
+
+            size_t found = 0;
+            timeLambda([&]() {
+                for (size_t i = 0; i < 10; ++i) {
+                    for (const auto& entity : entities) {
+                        found += entity.property(PropertyKeys::Targetname) != nullptr ? 1u : 0u;
+                        found += entity.property(PropertyKeys::Target) != nullptr ? 1u : 0u;
+                        found += entity.property(PropertyKeys::Killtarget) != nullptr ? 1u : 0u;
+                    }
+                }
+            }, "look up well known properties of " + std::to_string(entities.size()) + " entities 10 times");
+            CHECK(found == 2u * 10u * NumEntities);
+
+            found = 0;
+            timeLambda([&]() {
+                for (size_t i = 0; i < 10; ++i) {
+                    for (const auto& entity : entities) {
+                        found += entity.property(targetnameByValue) != nullptr ? 1u : 0u;
+                        found += entity.property("delay") != nullptr ? 1u : 0u;
+                        found += entity.property("missing") != nullptr ? 1u : 0u;
+                    }
+                }
+            }, "look up other properties of " + std::to_string(entities.size()) + " entities 10 times");
+            CHECK(found == 2u * 10u * NumEntities);
+        }
+
+        TEST_CASE("EntityBenchmark.propertyUpdate", "[EntityBenchmark]") {
+            auto entities = makeEntities();
+
+            timeLambda([&]() {
+                for (auto& entity : entities) {
+                    entity.addOrUpdateProperty(PropertyKeys::Targetname, "renamed");
+                    entity.property(PropertyKeys::Targetname);
+                }
+            }, "update and look up targetname of " + std::to_string(entities.size()) + " entities");
+
+            // this is only a sizeof estimate, it does not include the heap memory of the property strings
+            const auto bytesPerEntity = sizeof(Entity) + 11u * sizeof(EntityProperty);
+            printf("sizeof estimate of an entity with 11 properties (excluding heap memory): %zu bytes\n", bytesPerEntity);
+        }
+    }
+}
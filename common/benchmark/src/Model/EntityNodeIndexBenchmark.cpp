@@ -0,0 +1,123 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/Entity.h"
+#include "Model/EntityNode.h"
+#include "Model/EntityNodeIndex.h"
+#include "Model/EntityProperties.h"
+
+#include <kdl/vector_utils.h>
+
+#include <string>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        static constexpr size_t NumEntities = 100'000;
+        static constexpr size_t NumRenamedEntities = 10'000;
+
+        static std::vector<EntityNode*> makeEntityNodes() {
+            std::vector<EntityNode*> result;
+            result.reserve(NumEntities);
+
+            for (size_t i = 0; i < NumEntities; ++i) {
+                const auto index = std::to_string(i);
+                result.push_back(new EntityNode(Entity({
+                    EntityProperty(PropertyKeys::Classname, "light"),
+                    EntityProperty(PropertyKeys::Origin, index + " 0 0"),
+                    EntityProperty(PropertyKeys::Targetname, "name_" + index),
+                    EntityProperty(PropertyKeys::Target, "name_" + std::to_string((i + 1u) % NumEntities)),
+                    EntityProperty("light", "300"),
+                    EntityProperty("style", "0"),
+                })));
+            }
+
+            return result;
+        }
+
+        static void addEntityNodes(EntityNodeIndex& index, const std::vector<EntityNode*>& nodes) {
+            for (auto* node : nodes) {
+                index.addEntityNode(node);
+            }
+        }
+
+        static void renameTargetnames(EntityNodeIndex& index, const std::vector<EntityNode*>& nodes, const std::string& prefix) {
+            for (size_t i = 0; i < NumRenamedEntities; ++i) {
+                auto* node = nodes[i];
+                const auto& oldName = *node->entity().property(PropertyKeys::Targetname);
+                const auto newName = prefix + oldName;
+
+                index.removeProperty(node, PropertyKeys::Targetname, oldName);
+                index.addProperty(node, PropertyKeys::Targetname, newName);
+
+                // link resolution looks up the entities that target the renamed entity
+                index.findEntityNodes(EntityNodeIndexQuery::numbered(PropertyKeys::Target), newName);
+            }
+        }
+
+        TEST_CASE("EntityNodeIndexBenchmark.addEntityNodes", "[EntityNodeIndexBenchmark]") {
+            auto nodes = makeEntityNodes();
+
+            {
+                EntityNodeIndex index;
+                timeLambda([&]() {
+                    addEntityNodes(index, nodes);
+                }, "add " + std::to_string(nodes.size()) + " entity nodes to index individually");
+            }
+
+            {
+                EntityNodeIndex index;
+                timeLambda([&]() {
+                    const auto batch = EntityNodeIndexBatch(index);
+                    addEntityNodes(index, nodes);
+                }, "add " + std::to_string(nodes.size()) + " entity nodes to index in a batch");
+            }
+
+            kdl::vec_clear_and_delete(nodes);
+        }
+
+        TEST_CASE("EntityNodeIndexBenchmark.renameTargetnames", "[EntityNodeIndexBenchmark]") {
+            auto nodes = makeEntityNodes();
+
+            {
+                EntityNodeIndex index;
+                addEntityNodes(index, nodes);
+
+                timeLambda([&]() {
+                    renameTargetnames(index, nodes, "renamed_");
+                }, "rename targetname of " + std::to_string(NumRenamedEntities) + " entities individually");
+            }
+
+            {
+                EntityNodeIndex index;
+                addEntityNodes(index, nodes);
+
+                timeLambda([&]() {
+                    const auto batch = EntityNodeIndexBatch(index);
+                    renameTargetnames(index, nodes, "renamed_");
+                }, "rename targetname of " + std::to_string(NumRenamedEntities) + " entities in a batch");
+            }
+
+            kdl::vec_clear_and_delete(nodes);
+        }
+    }
+}
@@ -0,0 +1,94 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "Logger.h"
+#include "IO/DiskIO.h"
+#include "IO/Path.h"
+#include "Model/GameConfig.h"
+#include "Model/GameFileSystem.h"
+
+#include <miniz/miniz.h>
+
+#include <string>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        static constexpr size_t NumPackages = 200;
+        static constexpr size_t NumFilesPerPackage = 500;
+
+        static void createPackage(const IO::Path& path, const size_t packageIndex) {
+            mz_zip_archive archive;
+            mz_zip_zero_struct(&archive);
+
+            REQUIRE(mz_zip_writer_init_file(&archive, path.asString().c_str(), 0));
+            for (size_t i = 0; i < NumFilesPerPackage; ++i) {
+                const auto name = "textures/pak" + std::to_string(packageIndex) + "/texture" + std::to_string(i) + ".tga";
+                const auto contents = std::string(256, static_cast<char>(i));
+                REQUIRE(mz_zip_writer_add_mem(&archive, name.c_str(), contents.data(), contents.size(), MZ_DEFAULT_LEVEL));
+            }
+            REQUIRE(mz_zip_writer_finalize_archive(&archive));
+            REQUIRE(mz_zip_writer_end(&archive));
+        }
+
+        TEST_CASE("GameFileSystemBenchmark.mountPackages", "[GameFileSystemBenchmark]") {
+            const auto gamePath = IO::Disk::getCurrentWorkingDir() + IO::Path("GameFileSystemBenchmark");
+            IO::Disk::ensureDirectoryExists(gamePath + IO::Path("baseq3"));
+            for (size_t i = 0; i < NumPackages; ++i) {
+                createPackage(gamePath + IO::Path("baseq3/pak" + std::to_string(i) + ".pk3"), i);
+            }
+
+            const auto config = GameConfig(
+                "Quake3",
+                IO::Path(),
+                IO::Path(),
+                false,
+                std::vector<MapFormatConfig>(),
+                FileSystemConfig(
+                    IO::Path("baseq3"),
+                    PackageFormatConfig("pk3", "zip")
+                ),
+                TextureConfig(
+                    TexturePackageConfig(IO::Path("textures")),
+                    PackageFormatConfig(std::vector<std::string>{ "tga", "jpg" }, "image"),
+                    IO::Path(),
+                    "_tb_textures",
+                    IO::Path(),
+                    std::vector<std::string>()
+                ),
+                EntityConfig(),
+                FaceAttribsConfig(),
+                std::vector<SmartTag>(),
+                std::nullopt, // soft map bounds
+                {} // compilation tools
+            );
+
+            NullLogger logger;
+            benchmarkLambda([&]() {
+                GameFileSystem fs;
+                fs.initialize(config, gamePath, {}, logger);
+                CHECK(fs.fileExists(IO::Path("textures/pak199/texture499.tga")));
+            }, "mount " + std::to_string(NumPackages) + " packages with " + std::to_string(NumFilesPerPackage) + " files each");
+        }
+    }
+}
@@ -0,0 +1,65 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IO/Path.h"
+#include "Model/PortalFile.h"
+
+#include <vecmath/polygon.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        static constexpr size_t NumPortals = 500'000;
+
+        static void writePortalFile(const std::string& path) {
+            std::ofstream stream(path, std::ios::out | std::ios::binary);
+            stream << "PRT1\n" << NumPortals << "\n" << NumPortals << "\n";
+
+            for (size_t i = 0; i < NumPortals; ++i) {
+                const auto x = std::to_string(i % 1000u) + ".5";
+                const auto y = std::to_string(i / 1000u) + ".25";
+                stream << "4 " << i << " " << (i + 1u) << " "
+                       << "(" << x << " " << y << " 0 ) "
+                       << "(" << x << " " << y << " 64 ) "
+                       << "(" << x << " -" << y << " 64 ) "
+                       << "(" << x << " -" << y << " 0 )\n";
+            }
+        }
+
+        TEST_CASE("PortalFileBenchmark.load", "[PortalFileBenchmark]") {
+            const auto path = std::string("PortalFileBenchmark.prt");
+            writePortalFile(path);
+
+            size_t numPortals = 0;
+            timeLambda([&]() {
+                const auto portalFile = PortalFile(IO::Path(path));
+                numPortals = portalFile.portals().size();
+            }, "load portal file with " + std::to_string(NumPortals) + " portals");
+            CHECK(numPortals == NumPortals);
+
+            std::remove(path.c_str());
+        }
+    }
+}
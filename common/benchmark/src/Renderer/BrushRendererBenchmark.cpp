@@ -26,6 +26,7 @@
 #include "Model/MapFormat.h"
 #include "Model/WorldNode.h"
 #include "Renderer/BrushRenderer.h"
+#include "Renderer/BrushRendererBrushCache.h"
 
 #include <kdl/result.h>
 
@@ -129,6 +130,30 @@ namespace TrenchBroom {
             kdl::vec_clear_and_delete(brushes);
             kdl::vec_clear_and_delete(textures);
         }
+
+        TEST_CASE("BrushRendererBenchmark.validateVertexCache", "[BrushRendererBenchmark]") {
+            auto brushesTextures = makeBrushes();
+            std::vector<Model::BrushNode*> brushes = brushesTextures.first;
+            std::vector<Assets::Texture*> textures = brushesTextures.second;
+
+            size_t vertexCount = 0u;
+            benchmarkLambda([&]() {
+                for (auto* brushNode : brushes) {
+                    brushNode->invalidateVertexCache();
+                }
+            }, [&]() {
+                vertexCount = 0u;
+                for (auto* brushNode : brushes) {
+                    auto& cache = brushNode->brushRendererBrushCache();
+                    cache.validateVertexCache(brushNode);
+                    vertexCount += cache.cachedVertices().size();
+                }
+            }, "build the vertex caches of " + std::to_string(brushes.size()) + " brushes");
+            CHECK(vertexCount == brushes.size() * 24u);
+
+            kdl::vec_clear_and_delete(brushes);
+            kdl::vec_clear_and_delete(textures);
+        }
     }
 }
 
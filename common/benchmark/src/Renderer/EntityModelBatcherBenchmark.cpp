@@ -0,0 +1,70 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/EntityNode.h"
+#include "Renderer/EntityModelBatcher.h"
+#include "Renderer/TexturedIndexRangeRenderer.h"
+
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
+#include <vecmath/vec.h>
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace Renderer {
+        static constexpr size_t NumEntities = 50'000;
+        static constexpr size_t NumModels = 20;
+
+        TEST_CASE("EntityModelBatcherBenchmark.buildBatches", "[EntityModelBatcherBenchmark]") {
+            std::vector<std::unique_ptr<TexturedIndexRangeRenderer>> renderers;
+            for (size_t i = 0; i < NumModels; ++i) {
+                renderers.push_back(std::make_unique<TexturedIndexRangeRenderer>());
+            }
+
+            std::vector<std::unique_ptr<Model::EntityNode>> entityNodes;
+            for (size_t i = 0; i < NumEntities; ++i) {
+                entityNodes.push_back(std::make_unique<Model::EntityNode>());
+            }
+
+            EntityModelBatcher batcher;
+            size_t batchCount = 0u;
+
+            benchmarkLambda([&]() {
+                batcher.clear();
+            }, [&]() {
+                for (size_t i = 0; i < NumEntities; ++i) {
+                    const auto position = vm::vec3f(static_cast<float>(i % 100u), static_cast<float>(i / 100u), 0.0f) * 64.0f;
+                    batcher.setInstance(entityNodes[i].get(), renderers[i % NumModels].get(), vm::translation_matrix(position));
+                }
+                batchCount = batcher.batches().size();
+            }, "build model batches for " + std::to_string(NumEntities) + " entities");
+
+            // every batch needs one vertex array and texture setup instead of one per entity
+            printf("%zu entities use %zu model batches\n", batcher.instanceCount(), batchCount);
+            CHECK(batchCount == NumModels);
+        }
+    }
+}
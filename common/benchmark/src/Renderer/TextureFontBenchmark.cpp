@@ -0,0 +1,85 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Renderer/AttrString.h"
+#include "Renderer/FontGlyph.h"
+#include "Renderer/FontTexture.h"
+#include "Renderer/TextureFont.h"
+
+#include <vecmath/vec.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace Renderer {
+        static constexpr size_t NumLabels = 20'000;
+        static constexpr size_t NumClassnames = 100;
+
+        static std::unique_ptr<TextureFont> makeFont() {
+            const size_t cellCount = 10u;
+            const size_t cellSize = 16u;
+            const unsigned char firstChar = ' ';
+            const unsigned char charCount = 95u;
+
+            std::vector<FontGlyph> glyphs;
+            for (size_t i = 0u; i < charCount; ++i) {
+                glyphs.emplace_back((i % cellCount) * cellSize, (i / cellCount) * cellSize, 8u, 12u, 9u);
+            }
+
+            return std::make_unique<TextureFont>(std::make_unique<FontTexture>(cellCount, cellSize, 1u), glyphs, 14, firstChar, charCount);
+        }
+
+        static std::vector<AttrString> makeLabels() {
+            // like a large map, many entities share the same classname
+            std::vector<AttrString> result;
+            result.reserve(NumLabels);
+            for (size_t i = 0u; i < NumLabels; ++i) {
+                result.emplace_back("entity_classname_" + std::to_string(i % NumClassnames));
+            }
+            return result;
+        }
+
+        TEST_CASE("TextureFontBenchmark.layout", "[TextureFontBenchmark]") {
+            auto font = makeFont();
+            const auto labels = makeLabels();
+
+            size_t vertexCount = 0u;
+            timeLambda([&]() {
+                for (const auto& label : labels) {
+                    const auto vertices = font->quads(label, true);
+                    const auto size = font->measure(label);
+                    vertexCount += vertices.size() + (size.x() > 0.0f ? 1u : 0u);
+                }
+            }, "lay out " + std::to_string(NumLabels) + " labels without cache");
+
+            timeLambda([&]() {
+                for (const auto& label : labels) {
+                    vertexCount += font->layout(label)->vertices.size();
+                }
+            }, "lay out " + std::to_string(NumLabels) + " labels with cache");
+
+            CHECK(vertexCount > 0u);
+        }
+    }
+}
@@ -0,0 +1,74 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FileLogger.h"
+#include "Logger.h"
+#include "IO/Path.h"
+#include "IO/PathQt.h"
+#include "View/Console.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace View {
+        static constexpr size_t NumThreads = 4;
+        static constexpr size_t NumMessagesPerThread = 250'000;
+        static constexpr size_t NumRepetitions = 100;
+
+        TEST_CASE("ConsoleBenchmark.logFromThreads", "[ConsoleBenchmark]") {
+            // don't flood the application's log file
+            const auto logFilePath = IO::pathFromQString(QDir::tempPath()) + IO::Path("ConsoleBenchmark.log");
+            {
+                FileLogger fileLogger(logFilePath);
+                Console console(fileLogger);
+
+                timeLambda([&]() {
+                    std::vector<std::thread> threads;
+                    for (size_t i = 0; i < NumThreads; ++i) {
+                        threads.emplace_back([&, i]() {
+                            // loading a map typically logs the same warning for many objects
+                            for (size_t j = 0; j < NumMessagesPerThread; ++j) {
+                                console.warn() << "Thread " << i << ": could not load texture " << j / NumRepetitions;
+                            }
+                        });
+                    }
+
+                    for (auto& thread : threads) {
+                        thread.join();
+                    }
+                }, "log " + std::to_string(NumThreads * NumMessagesPerThread) + " messages from " + std::to_string(NumThreads) + " threads");
+
+                timeLambda([&]() {
+                    QCoreApplication::processEvents();
+                }, "show logged messages");
+            }
+
+            QFile::remove(IO::pathAsQString(logFilePath));
+        }
+    }
+}
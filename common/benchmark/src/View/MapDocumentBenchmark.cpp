@@ -0,0 +1,95 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/ChangeBrushFaceAttributesRequest.h"
+#include "Model/MapFormat.h"
+#include "Model/WorldNode.h"
+#include "View/MapDocument.h"
+#include "View/MapDocumentCommandFacade.h"
+
+#include <kdl/result.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+#include "../../test/src/Model/TestGame.h"
+
+namespace TrenchBroom {
+    namespace View {
+        static constexpr size_t NumBrushes = 50'000;
+
+        static std::shared_ptr<MapDocument> makeDocument() {
+            auto document = MapDocumentCommandFacade::newMapDocument();
+            document->newDocument(Model::MapFormat::Standard, vm::bbox3(8192.0), std::make_shared<Model::TestGame>());
+
+            const auto builder = Model::BrushBuilder(Model::MapFormat::Standard, document->worldBounds());
+
+            auto brushNodes = std::vector<Model::Node*>{};
+            brushNodes.reserve(NumBrushes);
+
+            for (size_t i = 0; i < NumBrushes; ++i) {
+                const auto x = static_cast<FloatType>(i % 100u) * 64.0 - 3200.0;
+                const auto y = static_cast<FloatType>(i / 100u) * 8.0 - 2000.0;
+                brushNodes.push_back(new Model::BrushNode(builder.createCuboid(vm::bbox3(vm::vec3(x, y, 0), vm::vec3(x + 32.0, y + 4.0, 64.0)), "texture").value()));
+            }
+
+            document->addNodes(brushNodes, document->parentForNodes());
+            document->select(brushNodes);
+
+            return document;
+        }
+
+        TEST_CASE("MapDocumentBenchmark.transformObjects", "[MapDocumentBenchmark]") {
+            auto document = makeDocument();
+
+            bool success = false;
+            timeLambda([&]() {
+                success = document->translateObjects(vm::vec3(16, 16, 0));
+            }, "translate " + std::to_string(NumBrushes) + " brushes");
+            CHECK(success);
+
+            timeLambda([&]() {
+                success = document->rotateObjects(vm::vec3::zero(), vm::vec3::pos_z(), vm::to_radians(90.0));
+            }, "rotate " + std::to_string(NumBrushes) + " brushes");
+            CHECK(success);
+        }
+
+        TEST_CASE("MapDocumentBenchmark.setFaceAttributes", "[MapDocumentBenchmark]") {
+            auto document = makeDocument();
+
+            auto request = Model::ChangeBrushFaceAttributesRequest();
+            request.setXOffset(8.0f);
+            request.setRotation(45.0f);
+
+            bool success = false;
+            timeLambda([&]() {
+                success = document->setFaceAttributes(request);
+            }, "set attributes of all faces of " + std::to_string(NumBrushes) + " brushes");
+            CHECK(success);
+        }
+    }
+}
@@ -0,0 +1,113 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Assets/Texture.h"
+#include "Assets/TextureNameIndex.h"
+#include "View/CellLayout.h"
+
+#include <kdl/string_compare.h>
+#include <kdl/vector_utils.h>
+
+#include <string>
+#include <vector>
+
+#include <QVariant>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace View {
+        static constexpr size_t NumTextures = 50'000;
+
+        static std::vector<Assets::Texture> makeTextures() {
+            static const auto Prefixes = std::vector<std::string>{ "base", "brick", "metal", "sky", "trim", "wood", "tech", "liquid" };
+
+            std::vector<Assets::Texture> result;
+            result.reserve(NumTextures);
+
+            for (size_t i = 0; i < NumTextures; ++i) {
+                const auto& prefix = Prefixes[i % Prefixes.size()];
+                result.emplace_back(prefix + "/" + prefix + "_" + std::to_string(i), 64, 64);
+            }
+
+            return result;
+        }
+
+        // mimics the filtering and sorting that the texture browser performed before the name index was added
+        static std::vector<const Assets::Texture*> filterAndSortTextures(std::vector<const Assets::Texture*> textures, const std::string& pattern) {
+            textures = kdl::vec_erase_if(std::move(textures), [&](const auto* texture) {
+                return !kdl::ci::str_contains(texture->name(), pattern);
+            });
+            return kdl::vec_sort(std::move(textures), [](const auto* lhs, const auto* rhs) {
+                return kdl::ci::string_less()(lhs->name(), rhs->name());
+            });
+        }
+
+        static void layoutTextures(const std::vector<const Assets::Texture*>& textures) {
+            auto layout = CellLayout();
+            layout.setWidth(1024.0f);
+            layout.setOuterMargin(5.0f);
+            layout.setGroupMargin(5.0f);
+            layout.setRowMargin(15.0f);
+            layout.setCellMargin(10.0f);
+            layout.setTitleMargin(2.0f);
+            layout.setCellWidth(64.0f, 64.0f);
+            layout.setCellHeight(64.0f, 128.0f);
+
+            for (size_t i = 0; i < textures.size(); ++i) {
+                layout.addItem(QVariant(static_cast<qulonglong>(i)), 64.0f, 64.0f, 64.0f, 32.0f);
+            }
+            layout.height();
+        }
+
+        TEST_CASE("TextureBrowserLayoutBenchmark.filterAndLayout", "[TextureBrowserLayoutBenchmark]") {
+            const auto textures = makeTextures();
+            const auto texturePointers = kdl::vec_transform(textures, [](const auto& texture) { return &texture; });
+
+            // simulates typing into the filter box
+            const auto patterns = std::vector<std::string>{ "", "b", "br", "bri", "bric", "brick", "brick_", "brick_1", "brick_12" };
+
+            timeLambda([&]() {
+                for (const auto& pattern : patterns) {
+                    layoutTextures(filterAndSortTextures(texturePointers, pattern));
+                }
+            }, "filter, sort and lay out " + std::to_string(NumTextures) + " textures by scanning names");
+
+            const auto sortedTexturePointers = filterAndSortTextures(texturePointers, "");
+
+            auto index = Assets::TextureNameIndex();
+            timeLambda([&]() {
+                index = Assets::TextureNameIndex(sortedTexturePointers);
+            }, "build name index of " + std::to_string(NumTextures) + " textures");
+
+            timeLambda([&]() {
+                for (const auto& pattern : patterns) {
+                    layoutTextures(index.findTextures(pattern));
+                }
+            }, "filter and lay out " + std::to_string(NumTextures) + " textures using the name index");
+
+            timeLambda([&]() {
+                for (const auto& pattern : patterns) {
+                    index.findTextures(pattern);
+                }
+            }, "filter " + std::to_string(NumTextures) + " textures using the name index");
+        }
+    }
+}
@@ -0,0 +1,99 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/PickResult.h"
+#include "Renderer/PerspectiveCamera.h"
+#include "View/Grid.h"
+#include "View/VertexHandleManager.h"
+
+#include <vecmath/ray.h>
+#include <vecmath/segment.h>
+#include <vecmath/vec.h>
+
+#include <string>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace View {
+        static constexpr size_t NumHandlesPerAxis = 50;
+        static constexpr size_t NumHandles = NumHandlesPerAxis * NumHandlesPerAxis * 40;
+        static constexpr int NumPickRaysPerAxis = 10;
+
+        static vm::vec3 makePosition(const size_t i) {
+            const auto x = i % NumHandlesPerAxis;
+            const auto y = (i / NumHandlesPerAxis) % NumHandlesPerAxis;
+            const auto z = i / (NumHandlesPerAxis * NumHandlesPerAxis);
+            return vm::vec3(static_cast<FloatType>(x), static_cast<FloatType>(y), static_cast<FloatType>(z)) * 64.0;
+        }
+
+        static Renderer::PerspectiveCamera makeCamera() {
+            const Renderer::Camera::Viewport viewport(0, 0, 1920, 1080);
+            return Renderer::PerspectiveCamera(90.0f, 1.0f, 8000.0f, viewport, vm::vec3f(1600.0f, -1024.0f, 1280.0f), vm::vec3f::pos_y(), vm::vec3f::pos_z());
+        }
+
+        static std::vector<vm::ray3> makePickRays(const Renderer::Camera& camera) {
+            std::vector<vm::ray3> result;
+            for (int x = 0; x < NumPickRaysPerAxis; ++x) {
+                for (int y = 0; y < NumPickRaysPerAxis; ++y) {
+                    result.emplace_back(camera.pickRay(x * 1920 / NumPickRaysPerAxis, y * 1080 / NumPickRaysPerAxis));
+                }
+            }
+            return result;
+        }
+
+        TEST_CASE("VertexHandleManagerBenchmark.pick", "[VertexHandleManagerBenchmark]") {
+            VertexHandleManager manager;
+            for (size_t i = 0; i < NumHandles; ++i) {
+                manager.add(makePosition(i));
+            }
+
+            const auto camera = makeCamera();
+            const auto pickRays = makePickRays(camera);
+
+            timeLambda([&]() {
+                for (const auto& pickRay : pickRays) {
+                    Model::PickResult pickResult;
+                    manager.pick(pickRay, camera, pickResult);
+                }
+            }, "pick " + std::to_string(NumHandles) + " vertex handles with " + std::to_string(pickRays.size()) + " rays");
+        }
+
+        TEST_CASE("VertexHandleManagerBenchmark.pickGridHandle", "[VertexHandleManagerBenchmark]") {
+            EdgeHandleManager manager;
+            for (size_t i = 0; i < NumHandles; ++i) {
+                const auto position = makePosition(i);
+                manager.add(vm::segment3(position, position + vm::vec3(64, 0, 0)));
+            }
+
+            const auto camera = makeCamera();
+            const auto pickRays = makePickRays(camera);
+            const Grid grid(4);
+
+            timeLambda([&]() {
+                for (const auto& pickRay : pickRays) {
+                    Model::PickResult pickResult;
+                    manager.pickGridHandle(pickRay, camera, grid, pickResult);
+                }
+            }, "pick grid handles of " + std::to_string(NumHandles) + " edge handles with " + std::to_string(pickRays.size()) + " rays");
+        }
+    }
+}
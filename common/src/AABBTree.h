@@ -27,9 +27,12 @@
 #include <vecmath/ray.h>
 #include <vecmath/intersection.h>
 
+#include <algorithm>
 #include <cassert>
 #include <iosfwd>
+#include <tuple>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom {
@@ -149,16 +152,15 @@ namespace TrenchBroom {
             virtual void appendTo(std::ostream& str, const std::string& indent, size_t level) const = 0;
 
             virtual void checkParentPointers(const Node* expectedParent) const = 0;
-        protected:
             /**
-             * Updates the bounds of this node.
+             * Updates the bounds of this node. The bounds of the ancestors must be updated by the caller.
              *
              * @param bounds the new bounds
              */
             void setBounds(const Box& bounds) {
                 m_bounds = bounds;
             }
-
+        protected:
             /**
              * Appends a textual representation of this node's bounds to the given output stream.
              *
@@ -178,12 +180,14 @@ namespace TrenchBroom {
             Node* m_left;
             Node* m_right;
             size_t m_height;
+            bool m_refitPending;
         public:
             InnerNode(Node* left, Node* right) :
                 Node(merge(left->bounds(), right->bounds())),
                 m_left(left),
                 m_right(right),
-                m_height(0) {
+                m_height(0),
+                m_refitPending(false) {
                 assert(m_left != nullptr);
                 assert(m_right != nullptr);
 
@@ -211,6 +215,56 @@ namespace TrenchBroom {
                 return this->m_parent->updateAndReturnRoot();
             }
 
+        public: // refitting
+            /**
+             * Marks this node and its ancestors to be refit by refitMarked.
+             */
+            void markForRefit() {
+                if (!m_refitPending) {
+                    m_refitPending = true;
+                    if (this->m_parent != nullptr) {
+                        this->m_parent->markForRefit();
+                    }
+                }
+            }
+
+            /**
+             * Recomputes the bounds of the marked nodes in this subtree, children first. Appends the topmost subtrees
+             * whose surface area has grown by more than the given factor to the given vector.
+             */
+            void refitMarked(const T maxGrowth, std::vector<InnerNode*>& degradedNodes) {
+                if (!m_refitPending) {
+                    return;
+                }
+                m_refitPending = false;
+
+                const auto firstDegradedNode = degradedNodes.size();
+                for (auto* child : { m_left, m_right }) {
+                    if (child->height() > 1u) {
+                        static_cast<InnerNode*>(child)->refitMarked(maxGrowth, degradedNodes);
+                    }
+                }
+
+                const auto oldArea = surfaceArea(this->bounds());
+                updateBounds();
+                if (surfaceArea(this->bounds()) > maxGrowth * oldArea) {
+                    // this subtree contains the degraded subtrees found so far
+                    degradedNodes.resize(firstDegradedNode);
+                    degradedNodes.push_back(this);
+                }
+            }
+
+            /**
+             * Recomputes the bounds of this node and its ancestors. Stops at the first node whose bounds don't change.
+             */
+            void refitAncestors() {
+                const auto oldBounds = this->bounds();
+                updateBounds();
+                if (this->m_parent != nullptr && this->bounds() != oldBounds) {
+                    this->m_parent->refitAncestors();
+                }
+            }
+
             /**
              * One of our direct children is being swapped for a new node.
              *
@@ -549,6 +603,9 @@ namespace TrenchBroom {
         /**
          * Updates the node with the given data with the given new bounds.
          *
+         * If the new bounds are contained in the bounds of the grandparent of the node, the node stays where it is and
+         * only the bounds of its ancestors are refit. Otherwise, the node is removed and inserted again.
+         *
          * @param newBounds the new bounds of the node
          * @param data the node data of the node to update
          *
@@ -557,10 +614,137 @@ namespace TrenchBroom {
         void update(const Box& newBounds, const U& data) {
             check(newBounds);
 
-            if (!remove(data)) {
+            auto* leaf = findLeaf(data);
+            if (canRefit(leaf, newBounds)) {
+                leaf->setBounds(newBounds);
+                if (auto* parent = leaf->m_parent) {
+                    parent->refitAncestors();
+                }
+            } else {
+                remove(data);
+                insert(newBounds, data);
+            }
+        }
+
+        /**
+         * Updates the nodes with the given data with their new bounds.
+         *
+         * Nodes whose new bounds are contained in the bounds of their grandparents stay where they are, and the bounds
+         * of their ancestors are refit in a single bottom up pass. The other nodes are removed and inserted again.
+         * Afterwards, every subtree whose surface area has grown by more than the given factor is rebuilt.
+         *
+         * @param objects the data of the nodes to update, a list of DataType
+         * @param getBounds a function from DataType -> Box to compute the new bounds of each object
+         * @param maxGrowth the factor by which the surface area of a subtree may grow before it is rebuilt
+         *
+         * @throws NodeTreeException if no node with any of the given data can be found in this tree, or if any of the
+         * new bounds contains NaN
+         */
+        template <typename DataList, typename GetBounds>
+        void updateAll(const DataList& objects, GetBounds&& getBounds, const T maxGrowth = T(2)) {
+            // find all leaves first so that the tree is not changed if any of them cannot be found
+            auto leavesToRefit = std::vector<std::pair<LeafNode*, Box>>{};
+            auto dataToReinsert = std::vector<std::pair<U, Box>>{};
+            for (const U& object : objects) {
+                auto* leaf = findLeaf(object);
+                const auto newBounds = getBounds(object);
+                check(newBounds);
+
+                if (canRefit(leaf, newBounds)) {
+                    leavesToRefit.emplace_back(leaf, newBounds);
+                } else {
+                    dataToReinsert.emplace_back(object, newBounds);
+                }
+            }
+
+            // removing a leaf only deletes the leaf and its parent, so the leaves to refit remain valid
+            for (const auto& [data, newBounds] : dataToReinsert) {
+                remove(data);
+                insert(newBounds, data);
+            }
+
+            for (const auto& [leaf, newBounds] : leavesToRefit) {
+                leaf->setBounds(newBounds);
+                if (auto* parent = leaf->m_parent) {
+                    parent->markForRefit();
+                }
+            }
+
+            if (!empty() && m_root->height() > 1u) {
+                auto degradedNodes = std::vector<InnerNode*>{};
+                static_cast<InnerNode*>(m_root)->refitMarked(maxGrowth, degradedNodes);
+
+                for (auto* node : degradedNodes) {
+                    rebuildSubtree(node);
+                }
+            }
+        }
+    private:
+        /**
+         * A leaf can be refit without changing the bounds of the nodes above its grandparent if the grandparent
+         * contains the new bounds.
+         */
+        static bool canRefit(const LeafNode* leaf, const Box& newBounds) {
+            const auto* parent = leaf->m_parent;
+            return parent == nullptr || parent->m_parent == nullptr || parent->m_parent->bounds().contains(newBounds);
+        }
+
+        LeafNode* findLeaf(const U& data) const {
+            const auto it = m_leafForData.find(data);
+            if (it == m_leafForData.end()) {
                 throw NodeTreeException("AABB node not found");
             }
-            insert(newBounds, data);
+            return it->second;
+        }
+
+        /**
+         * Replaces the given subtree by a new subtree that contains the same data.
+         */
+        void rebuildSubtree(InnerNode* subtree) {
+            auto leaves = std::vector<std::pair<Box, U>>{};
+            LambdaVisitor visitor(
+                [](const InnerNode*) { return true; },
+                [&](const LeafNode* leaf) { leaves.emplace_back(leaf->bounds(), leaf->data()); }
+            );
+            static_cast<const Node*>(subtree)->accept(visitor);
+
+            Node* newSubtree = nullptr;
+            for (const auto& [bounds, data] : leaves) {
+                LeafNode* leaf;
+                if (newSubtree == nullptr) {
+                    leaf = new LeafNode(bounds, data);
+                    newSubtree = leaf;
+                } else {
+                    std::tie(newSubtree, leaf) = newSubtree->insert(bounds, data);
+                }
+                m_leafForData[data] = leaf;
+            }
+
+            if (auto* parent = subtree->m_parent) {
+                m_root = parent->replaceChild(subtree, newSubtree);
+            } else {
+                newSubtree->m_parent = nullptr;
+                m_root = newSubtree;
+            }
+            delete subtree;
+        }
+
+        /**
+         * Returns half of the surface area of the given bounds.
+         */
+        static T surfaceArea(const Box& bounds) {
+            const auto size = bounds.size();
+            auto result = T(0);
+            for (size_t i = 0; i < S; ++i) {
+                auto faceArea = T(1);
+                for (size_t j = 0; j < S; ++j) {
+                    if (j != i) {
+                        faceArea *= size[j];
+                    }
+                }
+                result += faceArea;
+            }
+            return result;
         }
     private:
         void check(const Box& bounds) const {
@@ -576,6 +760,7 @@ namespace TrenchBroom {
             if (!empty()) {
                 delete m_root;
                 m_root = nullptr;
+                m_leafForData.clear();
             }
         }
 
@@ -613,6 +798,32 @@ namespace TrenchBroom {
             return empty() ? 0 : m_root->height();
         }
 
+        /**
+         * Returns the cost of this tree according to the surface area heuristic. This is the expected number of nodes
+         * whose bounds are tested by a query that hits the root of this tree, assuming that the probability of a query
+         * hitting a node is proportional to its surface area. A lower cost indicates a better tree.
+         *
+         * @return the cost of this tree, or 0 if this tree is empty
+         */
+        T sahCost() const {
+            if (empty()) {
+                return T(0);
+            }
+
+            const auto rootArea = surfaceArea(m_root->bounds());
+            if (rootArea == T(0)) {
+                return T(0);
+            }
+
+            auto totalArea = T(0);
+            LambdaVisitor visitor(
+                [&](const InnerNode* innerNode) { totalArea += surfaceArea(innerNode->bounds()); return true; },
+                [&](const LeafNode* leaf) { totalArea += surfaceArea(leaf->bounds()); }
+            );
+            m_root->accept(visitor);
+            return totalArea / rootArea;
+        }
+
         /**
          * Finds every data item in this tree whose bounding box intersects with the given ray and retuns a list of those items.
          *
@@ -652,6 +863,45 @@ namespace TrenchBroom {
             }
         }
 
+        /**
+         * Finds every data item in this tree whose bounding box intersects with the given box and returns a list of those
+         * items.
+         *
+         * @param box the box to test
+         * @return a list containing all found data items
+         */
+        List findIntersectors(const Box& box) const {
+            List result;
+            findIntersectors(box, std::back_inserter(result));
+            return result;
+        }
+
+        /**
+         * Finds every data item in this tree whose bounding box intersects with the given box and appends it to the given
+         * output iterator.
+         *
+         * @tparam O the output iterator type
+         * @param box the box to test
+         * @param out the output iterator to append to
+         */
+        template <typename O>
+        void findIntersectors(const Box& box, O out) const {
+            if (!empty()) {
+                LambdaVisitor visitor(
+                    [&](const InnerNode* innerNode) {
+                        return innerNode->bounds().intersects(box);
+                    },
+                    [&](const LeafNode* leaf) {
+                        if (leaf->bounds().intersects(box)) {
+                            out = leaf->data();
+                            ++out;
+                        }
+                    }
+                );
+                m_root->accept(visitor);
+            }
+        }
+
         /**
          * Finds every data item in this tree whose bounding box contains the given point and returns a list of those items.
          *
@@ -22,6 +22,7 @@
 #include "Exceptions.h"
 #include "Logger.h"
 #include "Macros.h"
+#include "Profiler.h"
 #include "Assets/EntityModel.h"
 #include "Assets/ModelDefinition.h"
 #include "IO/EntityModelLoader.h"
@@ -150,6 +151,7 @@ namespace TrenchBroom {
         }
 
         std::unique_ptr<EntityModel> EntityModelManager::loadModel(const IO::Path& path) const {
+            TB_PROFILE_SCOPE("EntityModelManager::loadModel");
             ensure(m_loader != nullptr, "loader is null");
             return m_loader->initializeModel(path, m_logger);
         }
@@ -89,7 +89,8 @@ namespace TrenchBroom {
         m_expression(EL::LiteralExpression(EL::Value::Undefined), line, column) {}
 
         ModelDefinition::ModelDefinition(const EL::Expression& expression) :
-        m_expression(expression) {}
+        m_expression(expression),
+        m_variables(m_expression.variables()) {}
 
         bool operator==(const ModelDefinition& lhs, const ModelDefinition& rhs) {
             return lhs.m_expression.asString() == rhs.m_expression.asString();
@@ -112,11 +113,39 @@ namespace TrenchBroom {
             const size_t line = m_expression.line();
             const size_t column = m_expression.column();
             m_expression = EL::Expression(EL::SwitchExpression(std::move(cases)), line, column);
+            m_expression.optimize();
+
+            m_variables = m_expression.variables();
+            m_cache.clear();
         }
 
+        static constexpr size_t MaxCachedModelSpecifications = 1024u;
+
         ModelSpecification ModelDefinition::modelSpecification(const EL::VariableStore& variableStore) const {
+            auto key = CacheKey{};
+            key.reserve(m_variables.size());
+            for (const auto& variable : m_variables) {
+                const auto value = variableStore.value(variable);
+                if (value.type() == EL::ValueType::String) {
+                    key.emplace_back(value.type(), value.stringValue());
+                } else {
+                    key.emplace_back(value.type(), value.asString());
+                }
+            }
+
+            if (const auto it = m_cache.find(key); it != std::end(m_cache)) {
+                return it->second;
+            }
+
             const EL::EvaluationContext context(variableStore);
-            return convertToModel(m_expression.evaluate(context));
+            auto result = convertToModel(m_expression.evaluate(context));
+
+            if (m_cache.size() >= MaxCachedModelSpecifications) {
+                m_cache.clear();
+            }
+            m_cache.emplace(std::move(key), result);
+
+            return result;
         }
 
         ModelSpecification ModelDefinition::defaultModelSpecification() const {
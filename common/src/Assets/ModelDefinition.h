@@ -23,6 +23,10 @@
 #include "IO/Path.h"
 
 #include <iosfwd>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Assets {
@@ -48,6 +52,13 @@ namespace TrenchBroom {
         class ModelDefinition {
         private:
             EL::Expression m_expression;
+            std::vector<std::string> m_variables;
+
+            /**
+             * The evaluation results, keyed by the types and values of the variables read by the expression.
+             */
+            using CacheKey = std::vector<std::pair<EL::ValueType, std::string>>;
+            mutable std::map<CacheKey, ModelSpecification> m_cache;
         public:
             ModelDefinition();
             ModelDefinition(size_t line, size_t column);
@@ -62,6 +73,9 @@ namespace TrenchBroom {
             /**
              * Evaluates the model expresion, using the given variable store to interpolate variables.
              *
+             * The results are cached by the values of the variables that the expression reads, so entities which
+             * agree in these values share a single evaluation. This function is not thread safe.
+             *
              * @param variableStore the variable store to use when interpolating variables
              * @return the model specification
              *
@@ -26,6 +26,7 @@
 
 #include <vecmath/forward.h>
 
+#include <atomic>
 #include <set>
 #include <string>
 #include <vector>
@@ -84,7 +85,8 @@ namespace TrenchBroom {
             size_t m_height;
             Color m_averageColor;
 
-            size_t m_usageCount;
+            // brush faces can be copied on several threads at once, e.g. when a bulk edit is applied in parallel
+            std::atomic<size_t> m_usageCount;
             bool m_overridden;
 
             GLenum m_format;
@@ -109,8 +111,8 @@ namespace TrenchBroom {
             Texture(const Texture&) = delete;
             Texture& operator=(const Texture&) = delete;
             
-            Texture(Texture&& other) = default;
-            Texture& operator=(Texture&& other) = default;
+            Texture(Texture&& other);
+            Texture& operator=(Texture&& other);
 
             ~Texture();
 
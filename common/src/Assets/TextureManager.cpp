@@ -19,10 +19,13 @@
 
 #include "TextureManager.h"
 
+#include "Ensure.h"
 #include "Exceptions.h"
 #include "Logger.h"
+#include "Profiler.h"
 #include "Assets/Texture.h"
 #include "Assets/TextureCollection.h"
+#include "Assets/TextureNameIndex.h"
 #include "IO/TextureLoader.h"
 
 #include <kdl/map_utils.h>
@@ -65,6 +68,7 @@ namespace TrenchBroom {
         TextureManager::~TextureManager() = default;
 
         void TextureManager::setTextureCollections(const std::vector<IO::Path>& paths, IO::TextureLoader& loader) {
+            TB_PROFILE_SCOPE("TextureManager::setTextureCollections");
             auto collections = std::move(m_collections);
             clear();
 
@@ -122,6 +126,9 @@ namespace TrenchBroom {
             m_texturesByName.clear();
             m_textures.clear();
 
+            m_textureNameIndex = TextureNameIndex();
+            m_collectionNameIndices.clear();
+
             // Remove logging because it might fail when the document is already destroyed.
         }
 
@@ -158,6 +165,15 @@ namespace TrenchBroom {
             return m_collections;
         }
 
+        const TextureNameIndex& TextureManager::textureNameIndex() const {
+            return m_textureNameIndex;
+        }
+
+        const TextureNameIndex& TextureManager::collectionNameIndex(const size_t collectionIndex) const {
+            ensure(collectionIndex < m_collectionNameIndices.size(), "collection index out of range");
+            return m_collectionNameIndices[collectionIndex];
+        }
+
         void TextureManager::resetTextureMode() {
             if (m_resetTextureMode) {
                 for (auto& collection : m_collections) {
@@ -195,6 +211,11 @@ namespace TrenchBroom {
             }
 
             m_textures = kdl::vec_transform(kdl::map_values(m_texturesByName), [](auto* t) { return const_cast<const Texture*>(t); });
+
+            m_textureNameIndex = TextureNameIndex(m_textures);
+            m_collectionNameIndices = kdl::vec_transform(m_collections, [](const auto& collection) {
+                return TextureNameIndex(kdl::vec_transform(collection.textures(), [](const auto& t) { return &t; }));
+            });
         }
     }
 }
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "Assets/TextureCollection.h"
+#include "Assets/TextureNameIndex.h"
 
 #include <map>
 #include <string>
@@ -51,6 +52,9 @@ namespace TrenchBroom {
             TextureMap m_texturesByName;
             std::vector<const Texture*> m_textures;
 
+            TextureNameIndex m_textureNameIndex;
+            std::vector<TextureNameIndex> m_collectionNameIndices;
+
             int m_minFilter;
             int m_magFilter;
             bool m_resetTextureMode;
@@ -73,6 +77,17 @@ namespace TrenchBroom {
             
             const std::vector<const Texture*>& textures() const;
             const std::vector<TextureCollection>& collections() const;
+
+            /**
+             * Returns an index of the textures returned by textures(), sorted by name.
+             */
+            const TextureNameIndex& textureNameIndex() const;
+
+            /**
+             * Returns an index of the textures of the collection with the given index, in the order in which they
+             * appear in the collection.
+             */
+            const TextureNameIndex& collectionNameIndex(size_t collectionIndex) const;
         private:
             void resetTextureMode();
             void prepare();
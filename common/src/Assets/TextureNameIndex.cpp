@@ -0,0 +1,97 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TextureNameIndex.h"
+
+#include "Assets/Texture.h"
+
+#include <kdl/string_format.h>
+
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Assets {
+        static std::uint32_t trigram(const std::string& str, const size_t offset) {
+            return static_cast<std::uint32_t>(static_cast<unsigned char>(str[offset])) << 16
+                 | static_cast<std::uint32_t>(static_cast<unsigned char>(str[offset + 1u])) << 8
+                 | static_cast<std::uint32_t>(static_cast<unsigned char>(str[offset + 2u]));
+        }
+
+        TextureNameIndex::TextureNameIndex() = default;
+
+        TextureNameIndex::TextureNameIndex(std::vector<const Texture*> textures) :
+        m_textures(std::move(textures)) {
+            m_names.reserve(m_textures.size());
+            for (size_t i = 0u; i < m_textures.size(); ++i) {
+                const auto& name = m_names.emplace_back(kdl::str_to_lower(m_textures[i]->name()));
+                for (size_t j = 0u; j + 3u <= name.size(); ++j) {
+                    auto& indices = m_trigrams[trigram(name, j)];
+                    // a trigram can occur more than once in a name
+                    if (indices.empty() || indices.back() != i) {
+                        indices.push_back(i);
+                    }
+                }
+            }
+        }
+
+        const std::vector<const Texture*>& TextureNameIndex::textures() const {
+            return m_textures;
+        }
+
+        std::vector<const Texture*> TextureNameIndex::findTextures(const std::string& pattern) const {
+            if (pattern.empty()) {
+                return m_textures;
+            }
+
+            const auto lowerPattern = kdl::str_to_lower(pattern);
+            std::vector<const Texture*> result;
+
+            if (lowerPattern.size() < 3u) {
+                for (size_t i = 0u; i < m_names.size(); ++i) {
+                    if (m_names[i].find(lowerPattern) != std::string::npos) {
+                        result.push_back(m_textures[i]);
+                    }
+                }
+                return result;
+            }
+
+            const std::vector<size_t>* candidates = nullptr;
+            for (size_t j = 0u; j + 3u <= lowerPattern.size(); ++j) {
+                const auto it = m_trigrams.find(trigram(lowerPattern, j));
+                if (it == std::end(m_trigrams)) {
+                    return result;
+                }
+                if (candidates == nullptr || it->second.size() < candidates->size()) {
+                    candidates = &it->second;
+                }
+            }
+
+            for (const auto i : *candidates) {
+                if (m_names[i].find(lowerPattern) != std::string::npos) {
+                    result.push_back(m_textures[i]);
+                }
+            }
+
+            return result;
+        }
+    }
+}
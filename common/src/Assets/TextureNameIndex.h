@@ -0,0 +1,59 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Assets {
+        class Texture;
+
+        /**
+         * Finds the textures whose names contain a given string, ignoring case.
+         *
+         * The lowercase names of the textures are split into trigrams, and each trigram maps to the textures
+         * whose names contain it. A query only has to check the textures listed for the rarest trigram of the
+         * pattern instead of every texture.
+         */
+        class TextureNameIndex {
+        private:
+            std::vector<const Texture*> m_textures;
+            std::vector<std::string> m_names;
+            std::unordered_map<std::uint32_t, std::vector<size_t>> m_trigrams;
+        public:
+            TextureNameIndex();
+            explicit TextureNameIndex(std::vector<const Texture*> textures);
+
+            /**
+             * Returns all indexed textures in the order in which they were passed to the constructor.
+             */
+            const std::vector<const Texture*>& textures() const;
+
+            /**
+             * Returns the textures whose names contain the given pattern, ignoring case. The textures are returned
+             * in the order in which they were passed to the constructor.
+             */
+            std::vector<const Texture*> findTextures(const std::string& pattern) const;
+        };
+    }
+}
@@ -24,6 +24,7 @@
 #include "EL/EvaluationContext.h"
 
 #include <kdl/overload.h>
+#include <kdl/vector_utils.h>
 
 #include <algorithm>
 #include <sstream>
@@ -121,6 +122,16 @@ namespace TrenchBroom {
             }
         }
 
+        std::vector<std::string> Expression::variables() const {
+            std::vector<std::string> result;
+            appendVariables(result);
+            return kdl::vec_sort_and_remove_duplicates(std::move(result));
+        }
+
+        void Expression::appendVariables(std::vector<std::string>& variables) const {
+            std::visit([&](const auto& e) { e.appendVariables(variables); }, *m_expression);
+        }
+
         size_t Expression::line() const {
             return m_line;
         }
@@ -196,6 +207,8 @@ namespace TrenchBroom {
         const Value& LiteralExpression::evaluate(const EvaluationContext&) const {
             return m_value;
         }
+
+        void LiteralExpression::appendVariables(std::vector<std::string>&) const {}
         
         std::ostream& operator<<(std::ostream& str, const LiteralExpression& exp) {
             str << exp.m_value;
@@ -208,6 +221,13 @@ namespace TrenchBroom {
         Value VariableExpression::evaluate(const EvaluationContext& context) const {
             return context.variableValue(m_variableName);
         }
+
+        void VariableExpression::appendVariables(std::vector<std::string>& variables) const {
+            // the auto range parameter is declared by the enclosing subscript expression
+            if (m_variableName != SubscriptExpression::AutoRangeParameterName()) {
+                variables.push_back(m_variableName);
+            }
+        }
         
         std::ostream& operator<<(std::ostream& str, const VariableExpression& exp) {
             str << exp.m_variableName;
@@ -251,6 +271,12 @@ namespace TrenchBroom {
             }
         }
 
+        void ArrayExpression::appendVariables(std::vector<std::string>& variables) const {
+            for (const auto& expression : m_elements) {
+                expression.appendVariables(variables);
+            }
+        }
+
         std::ostream& operator<<(std::ostream& str, const ArrayExpression& exp) {
             str << "[ ";
             size_t i = 0u;
@@ -292,6 +318,12 @@ namespace TrenchBroom {
             }
         }
 
+        void MapExpression::appendVariables(std::vector<std::string>& variables) const {
+            for (const auto& entry : m_elements) {
+                entry.second.appendVariables(variables);
+            }
+        }
+
         std::ostream& operator<<(std::ostream& str, const MapExpression& exp) {
             str << "{ ";
             size_t i = 0u;
@@ -334,6 +366,10 @@ namespace TrenchBroom {
             }
         }
 
+        void UnaryExpression::appendVariables(std::vector<std::string>& variables) const {
+            m_operand.appendVariables(variables);
+        }
+
         std::ostream& operator<<(std::ostream& str, const UnaryExpression& exp) {
             switch (exp.m_operator) {
                 case UnaryOperator::Plus:
@@ -451,9 +487,22 @@ namespace TrenchBroom {
             const auto rightOptimized = m_rightOperand.optimize();
             if (leftOptimized && rightOptimized) {
                 return LiteralExpression(evaluate(EvaluationContext()));
-            } else {
-                return std::nullopt;
             }
+
+            // the right operand of a case is never evaluated if its condition is false
+            if (leftOptimized && m_operator == BinaryOperator::Case) {
+                const auto leftValue = m_leftOperand.evaluate(EvaluationContext());
+                if (leftValue.convertibleTo(ValueType::Boolean) && !leftValue.convertTo(ValueType::Boolean).booleanValue()) {
+                    return LiteralExpression(Value::Undefined);
+                }
+            }
+
+            return std::nullopt;
+        }
+
+        void BinaryExpression::appendVariables(std::vector<std::string>& variables) const {
+            m_leftOperand.appendVariables(variables);
+            m_rightOperand.appendVariables(variables);
         }
 
         size_t BinaryExpression::precedence() const {
@@ -588,6 +637,11 @@ namespace TrenchBroom {
             }
         }
 
+        void SubscriptExpression::appendVariables(std::vector<std::string>& variables) const {
+            m_leftOperand.appendVariables(variables);
+            m_rightOperand.appendVariables(variables);
+        }
+
         std::ostream& operator<<(std::ostream& str, const SubscriptExpression& exp) {
             str << exp.m_leftOperand << "[" << exp.m_rightOperand << "]";
             return str;
@@ -608,20 +662,41 @@ namespace TrenchBroom {
         
         std::optional<LiteralExpression> SwitchExpression::optimize() {
             bool allOptimized = true;
-            
-            for (auto& case_ : m_cases) {
-                allOptimized &= case_.optimize();
-                if (allOptimized) {
-                    auto result = case_.evaluate(EvaluationContext());
-                    if (!result.undefined()) {
-                        return LiteralExpression(std::move(result));
-                    }
+
+            auto it = std::begin(m_cases);
+            while (it != std::end(m_cases)) {
+                if (!it->optimize()) {
+                    allOptimized = false;
+                    ++it;
+                    continue;
+                }
+
+                auto result = it->evaluate(EvaluationContext());
+                if (result.undefined()) {
+                    // a case that always yields undefined is always skipped
+                    it = m_cases.erase(it);
+                } else if (allOptimized) {
+                    return LiteralExpression(std::move(result));
+                } else {
+                    // the cases following a case that always yields a value are never evaluated
+                    m_cases.erase(std::next(it), std::end(m_cases));
+                    break;
                 }
             }
-            
+
+            if (m_cases.empty()) {
+                return LiteralExpression(Value::Undefined);
+            }
+
             return std::nullopt;
         }
 
+        void SwitchExpression::appendVariables(std::vector<std::string>& variables) const {
+            for (const auto& case_ : m_cases) {
+                case_.appendVariables(variables);
+            }
+        }
+
         std::ostream& operator<<(std::ostream& str, const SwitchExpression& exp) {
             str << "{{ ";
             size_t i = 0u;
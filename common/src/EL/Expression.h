@@ -75,6 +75,13 @@ namespace TrenchBroom {
             Value evaluate(const EvaluationContext& context) const;
             bool optimize();
 
+            /**
+             * Returns the names of the variables which this expression reads from its evaluation context. The
+             * result is sorted and contains no duplicates.
+             */
+            std::vector<std::string> variables() const;
+            void appendVariables(std::vector<std::string>& variables) const;
+
             size_t line() const;
             size_t column() const;
 
@@ -93,6 +100,7 @@ namespace TrenchBroom {
             LiteralExpression(Value value);
             
             const Value& evaluate(const EvaluationContext& context) const;
+            void appendVariables(std::vector<std::string>& variables) const;
             
             friend std::ostream& operator<<(std::ostream& str, const LiteralExpression& exp);
         };
@@ -104,6 +112,7 @@ namespace TrenchBroom {
             VariableExpression(std::string variableName);
             
             Value evaluate(const EvaluationContext& context) const;
+            void appendVariables(std::vector<std::string>& variables) const;
             
             friend std::ostream& operator<<(std::ostream& str, const VariableExpression& exp);
         };
@@ -116,6 +125,7 @@ namespace TrenchBroom {
             
             Value evaluate(const EvaluationContext& context) const;
             std::optional<LiteralExpression> optimize();
+            void appendVariables(std::vector<std::string>& variables) const;
             
             friend std::ostream& operator<<(std::ostream& str, const ArrayExpression& exp);
         };
@@ -128,6 +138,7 @@ namespace TrenchBroom {
 
             Value evaluate(const EvaluationContext& context) const;
             std::optional<LiteralExpression> optimize();
+            void appendVariables(std::vector<std::string>& variables) const;
             
             friend std::ostream& operator<<(std::ostream& str, const MapExpression& exp);
         };
@@ -149,6 +160,7 @@ namespace TrenchBroom {
 
             Value evaluate(const EvaluationContext& context) const;
             std::optional<LiteralExpression> optimize();
+            void appendVariables(std::vector<std::string>& variables) const;
             
             friend std::ostream& operator<<(std::ostream& str, const UnaryExpression& exp);
         };
@@ -190,6 +202,7 @@ namespace TrenchBroom {
 
             Value evaluate(const EvaluationContext& context) const;
             std::optional<LiteralExpression> optimize();
+            void appendVariables(std::vector<std::string>& variables) const;
             
             size_t precedence() const;
 
@@ -207,6 +220,7 @@ namespace TrenchBroom {
             
             Value evaluate(const EvaluationContext& context) const;
             std::optional<LiteralExpression> optimize();
+            void appendVariables(std::vector<std::string>& variables) const;
             
             friend std::ostream& operator<<(std::ostream& str, const SubscriptExpression& exp);
         };
@@ -219,6 +233,7 @@ namespace TrenchBroom {
 
             Value evaluate(const EvaluationContext& context) const;
             std::optional<LiteralExpression> optimize();
+            void appendVariables(std::vector<std::string>& variables) const;
             
             friend std::ostream& operator<<(std::ostream& str, const SwitchExpression& exp);
         };
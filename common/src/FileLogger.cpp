@@ -51,11 +51,30 @@ namespace TrenchBroom {
         return Instance;
     }
 
+    void FileLogger::flush() {
+        std::lock_guard<std::recursive_timed_mutex> lock(m_mutex);
+        if (m_file != nullptr) {
+            std::fflush(m_file);
+        }
+    }
+
+    bool FileLogger::tryFlush(const std::chrono::milliseconds timeout) {
+        std::unique_lock<std::recursive_timed_mutex> lock(m_mutex, timeout);
+        if (!lock.owns_lock()) {
+            return false;
+        }
+
+        if (m_file != nullptr) {
+            std::fflush(m_file);
+        }
+        return true;
+    }
+
     void FileLogger::doLog(const LogLevel /* level */, const std::string& message) {
         assert(m_file != nullptr);
+        std::lock_guard<std::recursive_timed_mutex> lock(m_mutex);
         if (m_file != nullptr) {
             std::fprintf(m_file, "%s\n", message.c_str());
-            std::fflush(m_file);
         }
     }
 
@@ -22,6 +22,9 @@
 #include "Macros.h"
 #include "Logger.h"
 
+#include <chrono>
+#include <cstdio>
+#include <mutex>
 #include <string>
 
 class QString;
@@ -31,14 +34,36 @@ namespace TrenchBroom {
         class Path;
     }
 
+    /**
+     * Writes log messages to a file. Messages can be logged from any thread. They are buffered and written to disk
+     * when the buffer is full or when flush is called.
+     */
     class FileLogger : public Logger {
     private:
         FILE* m_file;
+        /**
+         * Recursive so that the crash handler can flush the log even if the crash happened while this thread was
+         * logging a message.
+         */
+        std::recursive_timed_mutex m_mutex;
     public:
         explicit FileLogger(const IO::Path& filePath);
         ~FileLogger() override;
 
         static FileLogger& instance();
+
+        /**
+         * Writes all buffered messages to the log file.
+         */
+        void flush();
+
+        /**
+         * Like flush, but gives up if the log file cannot be locked within the given timeout, e.g. because another
+         * thread crashed while it was logging a message. For use by the crash handler, which must not block.
+         *
+         * Returns true if the log file was flushed.
+         */
+        bool tryFlush(std::chrono::milliseconds timeout);
     private:
         void doLog(LogLevel level, const std::string& message) override;
         void doLog(LogLevel level, const QString& message) override;
@@ -49,6 +49,10 @@ namespace TrenchBroom {
             return std::move(m_next);
         }
 
+        void FileSystem::setNext(std::shared_ptr<FileSystem> next) {
+            m_next = std::move(next);
+        }
+
         bool FileSystem::canMakeAbsolute(const Path& path) const {
             return !path.isAbsolute();
         }
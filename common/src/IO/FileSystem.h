@@ -55,6 +55,14 @@ namespace TrenchBroom {
             const FileSystem& next() const;
             std::shared_ptr<FileSystem> releaseNext();
 
+            /**
+             * Sets the next file system in the search path, replacing the current one. This allows file systems to be
+             * created independently of each other, e.g. on different threads, and to be chained afterwards.
+             *
+             * @param next the next file system in the search path
+             */
+            void setNext(std::shared_ptr<FileSystem> next);
+
             bool canMakeAbsolute(const Path& path) const;
             Path makeAbsolute(const Path& path) const;
 
@@ -20,26 +20,49 @@
 #include "ObjSerializer.h"
 
 #include "Ensure.h"
+#include "Exceptions.h"
 #include "Assets/Texture.h"
+#include "IO/DiskIO.h"
 #include "IO/Path.h"
 #include "Model/BrushNode.h"
 #include "Model/BrushFace.h"
 #include "Model/BrushGeometry.h"
 #include "Model/Polyhedron.h"
 
-#include <map>
+#include <kdl/parallel.h>
+#include <kdl/vector_utils.h>
+
+#include <vecmath/vec.h>
+
+#include <fmt/format.h>
+
+#include <array>
+#include <cstdio>
 
 namespace TrenchBroom {
     namespace IO {
-        ObjFileSerializer::IndexedVertex::IndexedVertex(const size_t i_vertex, const size_t i_texCoords, const size_t i_normal) :
-        vertex(i_vertex),
-        texCoords(i_texCoords),
-        normal(i_normal) {}
+        static const size_t BrushBatchSize = 4096u;
+
+        ObjFileSerializer::SectionFile::SectionFile(Path path) :
+        m_path(std::move(path)),
+        m_file(openPathAsFILE(m_path, "w+")) {
+            if (m_file == nullptr) {
+                throw FileSystemException("Cannot create temporary file for OBJ export: " + m_path.asString());
+            }
+        }
+
+        ObjFileSerializer::SectionFile::~SectionFile() {
+            std::fclose(m_file);
+            try {
+                Disk::deleteFile(m_path);
+            } catch (const FileSystemException&) {
+                // a leftover temporary file is not worth failing the export for
+            }
+        }
 
-        ObjFileSerializer::Face::Face(IndexedVertexList i_verts, std::string i_textureName, const Assets::Texture* i_texture) :
-        verts(std::move(i_verts)),
-        textureName(std::move(i_textureName)),
-        texture(i_texture) {}
+        std::FILE* ObjFileSerializer::SectionFile::file() const {
+            return m_file;
+        }
 
         ObjFileSerializer::ObjFileSerializer(const Path& path) :
         m_objPath(path),
@@ -47,37 +70,49 @@ namespace TrenchBroom {
         m_objFile(m_objPath, true),
         m_mtlFile(m_mtlPath, true),
         m_stream(m_objFile.file),
-        m_mtlStream(m_mtlFile.file),
-        m_currentObject({ 0, 0, {} }) {
+        m_mtlStream(m_mtlFile.file) {
             ensure(m_stream != nullptr, "stream is null");
             ensure(m_mtlStream != nullptr, "mtl stream is null");
         }
 
-        void ObjFileSerializer::doBeginFile(const std::vector<const Model::Node*>& /* rootNodes */) {}
+        ObjFileSerializer::~ObjFileSerializer() = default;
+
+        void ObjFileSerializer::doBeginFile(const std::vector<const Model::Node*>& /* rootNodes */) {
+            m_texCoordSection = std::make_unique<SectionFile>(m_objPath.addExtension("texcoords.tmp"));
+            m_normalSection = std::make_unique<SectionFile>(m_objPath.addExtension("normals.tmp"));
+            m_objectSection = std::make_unique<SectionFile>(m_objPath.addExtension("objects.tmp"));
+
+            std::fprintf(m_stream, "mtllib %s\n", m_mtlPath.filename().c_str());
+            std::fprintf(m_stream, "# vertices\n");
+        }
 
         void ObjFileSerializer::doEndFile() {
+            writePendingBrushes();
             writeMtlFile();
 
-            std::fprintf(m_stream, "mtllib %s\n", m_mtlPath.filename().c_str());
-            writeVertices();
-            std::fprintf(m_stream, "\n");
-            writeTexCoords();
-            std::fprintf(m_stream, "\n");
-            writeNormals();
-            std::fprintf(m_stream, "\n");
-            writeObjects();
+            appendSection("texture coordinates", m_texCoordSection->file());
+            appendSection("face normals", m_normalSection->file());
+            appendSection("objects", m_objectSection->file());
+
+            m_texCoordSection.reset();
+            m_normalSection.reset();
+            m_objectSection.reset();
         }
 
-        void ObjFileSerializer::writeMtlFile() {
-            std::map<std::string, const Assets::Texture*> usedTextures;
+        void ObjFileSerializer::appendSection(const std::string& title, std::FILE* section) {
+            std::fprintf(m_stream, "\n");
+            std::fprintf(m_stream, "# %s\n", title.c_str());
 
-            for (const Object& object : m_objects) {
-                for (const Face& face : object.faces) {
-                    usedTextures[face.textureName] = face.texture;
-                }
+            std::rewind(section);
+            std::array<char, 64 * 1024> buffer;
+            size_t count;
+            while ((count = std::fread(buffer.data(), 1u, buffer.size(), section)) > 0u) {
+                std::fwrite(buffer.data(), 1u, count, m_stream);
             }
+        }
 
-            for (const auto& [textureName, texture] : usedTextures) {
+        void ObjFileSerializer::writeMtlFile() {
+            for (const auto& [textureName, texture] : m_usedTextures) {
                 std::fprintf(m_mtlStream, "newmtl %s\n", textureName.c_str());
                 if (texture != nullptr && !texture->relativePath().isEmpty()) {
                     std::fprintf(m_mtlStream, "map_Kd %s\n\n", texture->relativePath().asString().c_str());
@@ -85,91 +120,96 @@ namespace TrenchBroom {
             }
         }
 
-        void ObjFileSerializer::writeVertices() {
-            std::fprintf(m_stream, "# vertices\n");
-            for (const vm::vec3& elem : m_vertices.list())
-                std::fprintf(m_stream, "v %.17g %.17g %.17g\n", elem.x(), elem.z(), -elem.y()); // no idea why I have to switch Y and Z
-        }
+        void ObjFileSerializer::doBeginEntity(const Model::Node* /* node */) {}
+        void ObjFileSerializer::doEndEntity(const Model::Node* /* node */) {}
+        void ObjFileSerializer::doEntityProperty(const Model::EntityProperty& /* property */) {}
 
-        void ObjFileSerializer::writeTexCoords() {
-            std::fprintf(m_stream, "# texture coordinates\n");
-            for (const vm::vec2f& elem : m_texCoords.list()) {
-                // multiplying Y by -1 needed to get the UV's to appear correct in Blender and UE4
-                // (see: https://github.com/TrenchBroom/TrenchBroom/issues/2851 )
-                std::fprintf(m_stream, "vt %.17g %.17g\n", static_cast<double>(elem.x()), static_cast<double>(-elem.y()));
+        void ObjFileSerializer::doBrush(const Model::BrushNode* brush) {
+            m_pendingBrushes.push_back(PendingBrush{brush, entityNo(), brushNo()});
+            if (m_pendingBrushes.size() == BrushBatchSize) {
+                writePendingBrushes();
             }
         }
 
-        void ObjFileSerializer::writeNormals() {
-            std::fprintf(m_stream, "# face normals\n");
-            for (const vm::vec3& elem : m_normals.list()) {
-                std::fprintf(m_stream, "vn %.17g %.17g %.17g\n", elem.x(), elem.z(), -elem.y()); // no idea why I have to switch Y and Z
-            }
+        void ObjFileSerializer::doBrushFace(const Model::BrushFace& face) {
+            writePendingBrushes();
+            writeFace(collectFace(face));
         }
 
-        void ObjFileSerializer::writeObjects() {
-            std::fprintf(m_stream, "# objects\n");
-            for (const Object& object : m_objects) {
-                std::fprintf(m_stream, "o entity%lu_brush%lu\n",
-                             static_cast<unsigned long>(object.entityNo),
-                             static_cast<unsigned long>(object.brushNo));
-
-                writeFaces(object.faces);
-                std::fprintf(m_stream, "\n");
-            }
-        }
+        void ObjFileSerializer::writePendingBrushes() {
+            const auto faces = kdl::vec_parallel_transform(m_pendingBrushes, [](PendingBrush&& pendingBrush) {
+                return kdl::vec_transform(pendingBrush.brushNode->brush().faces(), [](const Model::BrushFace& face) {
+                    return collectFace(face);
+                });
+            });
 
-        void ObjFileSerializer::writeFaces(const FaceList& faces) {
-            for (const Face& face : faces) {
-                std::fprintf(m_stream, "usemtl %s\n", face.textureName.c_str());
-                std::fprintf(m_stream, "f");
-                for (const IndexedVertex& vertex : face.verts) {
-                    std::fprintf(m_stream, " %lu/%lu/%lu",
-                                 static_cast<unsigned long>(vertex.vertex) + 1,
-                                 static_cast<unsigned long>(vertex.texCoords) + 1,
-                                 static_cast<unsigned long>(vertex.normal) + 1);
-                }
-                std::fprintf(m_stream, "\n");
+            for (size_t i = 0u; i < m_pendingBrushes.size(); ++i) {
+                writeBrush(m_pendingBrushes[i], faces[i]);
             }
+            m_pendingBrushes.clear();
         }
 
-        void ObjFileSerializer::doBeginEntity(const Model::Node* /* node */) {}
-        void ObjFileSerializer::doEndEntity(const Model::Node* /* node */) {}
-        void ObjFileSerializer::doEntityProperty(const Model::EntityProperty& /* property */) {}
+        void ObjFileSerializer::writeBrush(const PendingBrush& brush, const std::vector<FaceData>& faces) {
+            fmt::print(m_objectSection->file(), "o entity{}_brush{}\n", brush.entityNo, brush.brushNo);
 
-        void ObjFileSerializer::doBrush(const Model::BrushNode* brush) {
-            m_currentObject.entityNo = entityNo();
-            m_currentObject.brushNo = brushNo();
             // Vertex positions inserted from now on should get new indices
             m_vertices.clearIndices();
 
-            for (const Model::BrushFace& face : brush->brush().faces()) {
-                doBrushFace(face);
+            for (const FaceData& faceData : faces) {
+                writeFace(faceData);
             }
 
-            m_objects.push_back(m_currentObject);
-            m_currentObject.faces.clear();
+            fmt::print(m_objectSection->file(), "\n");
         }
 
-        void ObjFileSerializer::doBrushFace(const Model::BrushFace& face) {
+        ObjFileSerializer::FaceData ObjFileSerializer::collectFace(const Model::BrushFace& face) {
+            auto faceData = FaceData{&face, {}, {}};
+            faceData.positions.reserve(face.vertexCount());
+            faceData.texCoords.reserve(face.vertexCount());
+
+            for (const Model::BrushVertex* vertex : face.vertices()) {
+                faceData.positions.push_back(vertex->position());
+                faceData.texCoords.push_back(face.textureCoords(vertex->position()));
+            }
+            return faceData;
+        }
+
+        void ObjFileSerializer::writeFace(const FaceData& faceData) {
+            const Model::BrushFace& face = *faceData.face;
+
             const vm::vec3& normal = face.boundary().normal;
-            const size_t normalIndex = m_normals.index(normal);
+            const auto [normalIndex, newNormal] = m_normals.index(normal);
+            if (newNormal) {
+                // no idea why I have to switch Y and Z
+                fmt::print(m_normalSection->file(), "vn {:.17g} {:.17g} {:.17g}\n", normal.x(), normal.z(), -normal.y());
+            }
 
-            IndexedVertexList indexedVertices;
-            indexedVertices.reserve(face.vertexCount());
+            const auto& textureName = face.attributes().textureName();
+            m_usedTextures.insert_or_assign(textureName, face.texture());
 
-            for (const Model::BrushVertex* vertex : face.vertices()) {
-                const vm::vec3& position = vertex->position();
-                const vm::vec2f texCoords = face.textureCoords(position);
+            fmt::print(m_objectSection->file(), "usemtl {}\nf", textureName);
+
+            for (size_t i = 0u; i < faceData.positions.size(); ++i) {
+                const vm::vec3& position = faceData.positions[i];
+                const auto [vertexIndex, newVertex] = m_vertices.index(position);
+                if (newVertex) {
+                    // no idea why I have to switch Y and Z
+                    fmt::print(m_stream, "v {:.17g} {:.17g} {:.17g}\n", position.x(), position.z(), -position.y());
+                }
 
-                const size_t vertexIndex = m_vertices.index(position);
-                const size_t texCoordsIndex = m_texCoords.index(texCoords);
+                const vm::vec2f& texCoord = faceData.texCoords[i];
+                const auto [texCoordsIndex, newTexCoords] = m_texCoords.index(texCoord);
+                if (newTexCoords) {
+                    // multiplying Y by -1 needed to get the UV's to appear correct in Blender and UE4
+                    // (see: https://github.com/TrenchBroom/TrenchBroom/issues/2851 )
+                    fmt::print(m_texCoordSection->file(), "vt {:.17g} {:.17g}\n", static_cast<double>(texCoord.x()), static_cast<double>(-texCoord.y()));
+                }
 
-                indexedVertices.push_back(IndexedVertex(vertexIndex, texCoordsIndex, normalIndex));
+                // .obj indices are 1-based
+                fmt::print(m_objectSection->file(), " {}/{}/{}", vertexIndex + 1u, texCoordsIndex + 1u, normalIndex + 1u);
             }
 
-            m_currentObject.faces.push_back(Face(indexedVertices, face.attributes().textureName(), face.texture()));
+            fmt::print(m_objectSection->file(), "\n");
         }
     }
 }
-
@@ -20,15 +20,21 @@
 #pragma once
 
 #include "FloatType.h"
+#include "Macros.h"
 #include "IO/NodeSerializer.h"
 #include "IO/IOUtils.h"
 #include "IO/Path.h"
 
 #include <vecmath/forward.h>
+#include <vecmath/vec.h>
 
 #include <cstdio>
+#include <functional>
 #include <map>
+#include <memory>
 #include <string>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom {
@@ -46,26 +52,41 @@ namespace TrenchBroom {
     namespace IO {
         class ObjFileSerializer : public NodeSerializer {
         private:
+            struct VecHash {
+                template <typename T, size_t S>
+                size_t operator()(const vm::vec<T,S>& v) const {
+                    size_t result = 0u;
+                    for (size_t i = 0u; i < S; ++i) {
+                        result = result * 31u + std::hash<T>()(v[i]);
+                    }
+                    return result;
+                }
+            };
+
+            /**
+             * Assigns consecutive indices to distinct values. The values themselves are not stored beyond what is
+             * necessary to recognize them when they are indexed again, since the caller writes every new value out
+             * when it is indexed for the first time.
+             */
             template <typename V>
             class IndexMap {
-            public:
-                using List = std::vector<V>;
             private:
-                using Map = std::map<V, size_t>;
+                using Map = std::unordered_map<V, size_t, VecHash>;
                 Map m_map;
-                List m_list;
+                size_t m_count;
             public:
-                const List& list() const {
-                    return m_list;
-                }
+                IndexMap() :
+                m_count(0u) {}
 
-                size_t index(const V& v) {
-                    const auto it = m_map.insert({ v, m_list.size() }).first;
-                    const size_t index = it->second;
-                    if (index == m_list.size()) {
-                        m_list.push_back(v);
+                /**
+                 * Returns the index of the given value, and whether the value was assigned a new index.
+                 */
+                std::tuple<size_t, bool> index(const V& v) {
+                    const auto [it, inserted] = m_map.try_emplace(v, m_count);
+                    if (inserted) {
+                        ++m_count;
                     }
-                    return index;
+                    return { it->second, inserted };
                 }
 
                 /**
@@ -77,33 +98,35 @@ namespace TrenchBroom {
                 }
             };
 
-            struct IndexedVertex {
-                size_t vertex;
-                size_t texCoords;
-                size_t normal;
-
-                IndexedVertex(size_t i_vertex, size_t i_texCoords, size_t i_normal);
-            };
-
-            using IndexedVertexList = std::vector<IndexedVertex>;
+            /**
+             * A temporary file that one section of the OBJ file is written to. It is created next to the OBJ file rather
+             * than with std::tmpfile, which creates its files in the root directory of the system drive on Windows, where
+             * users usually cannot write. The file is deleted when this is destroyed.
+             */
+            class SectionFile {
+            private:
+                Path m_path;
+                std::FILE* m_file;
+            public:
+                explicit SectionFile(Path path);
+                ~SectionFile();
 
-            struct Face {
-                IndexedVertexList verts;
-                std::string textureName;
-                const Assets::Texture* texture;
+                std::FILE* file() const;
 
-                Face(IndexedVertexList i_verts, std::string i_textureName, const Assets::Texture* i_texture);
+                deleteCopyAndMove(SectionFile)
             };
 
-            using FaceList = std::vector<Face>;
-
-            struct Object {
-                size_t entityNo;
-                size_t brushNo;
-                FaceList faces;
+            struct FaceData {
+                const Model::BrushFace* face;
+                std::vector<vm::vec3> positions;
+                std::vector<vm::vec2f> texCoords;
             };
 
-            using ObjectList = std::vector<Object>;
+            struct PendingBrush {
+                const Model::BrushNode* brushNode;
+                ObjectNo entityNo;
+                ObjectNo brushNo;
+            };
 
             Path m_objPath;
             Path m_mtlPath;
@@ -118,28 +141,44 @@ namespace TrenchBroom {
             IndexMap<vm::vec2f> m_texCoords;
             IndexMap<vm::vec3> m_normals;
 
-            Object m_currentObject;
-            ObjectList m_objects;
+            /**
+             * The vertices are written directly to the OBJ file. The sections that follow them are written to
+             * temporary files as the brushes are serialized, and these are appended to the OBJ file in doEndFile.
+             */
+            std::unique_ptr<SectionFile> m_texCoordSection;
+            std::unique_ptr<SectionFile> m_normalSection;
+            std::unique_ptr<SectionFile> m_objectSection;
+
+            /**
+             * Brushes are collected in batches whose face vertices and texture coordinates are computed in parallel.
+             * The batches are then written in serialization order so that the indices do not depend on the number of
+             * threads.
+             */
+            std::vector<PendingBrush> m_pendingBrushes;
+
+            std::map<std::string, const Assets::Texture*> m_usedTextures;
         public:
             explicit ObjFileSerializer(const Path& path);
+            ~ObjFileSerializer() override;
         private:
             void doBeginFile(const std::vector<const Model::Node*>& rootNodes) override;
             void doEndFile() override;
 
             void writeMtlFile();
 
-            void writeVertices();
-            void writeTexCoords();
-            void writeNormals();
-            void writeObjects();
-            void writeFaces(const FaceList& faces);
-
             void doBeginEntity(const Model::Node* node) override;
             void doEndEntity(const Model::Node* node) override;
             void doEntityProperty(const Model::EntityProperty& property) override;
 
             void doBrush(const Model::BrushNode* brush) override;
             void doBrushFace(const Model::BrushFace& face) override;
+
+            void writePendingBrushes();
+            void writeBrush(const PendingBrush& brush, const std::vector<FaceData>& faces);
+            void writeFace(const FaceData& faceData);
+            static FaceData collectFace(const Model::BrushFace& face);
+
+            void appendSection(const std::string& title, std::FILE* section);
         };
     }
 }
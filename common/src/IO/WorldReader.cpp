@@ -19,10 +19,12 @@
 
 #include "WorldReader.h"
 
+#include "Profiler.h"
 #include "IO/ParserStatus.h"
 #include "Color.h"
 #include "Model/BrushNode.h"
 #include "Model/Entity.h"
+#include "Model/EntityNodeIndex.h"
 #include "Model/EntityProperties.h"
 #include "Model/LayerNode.h"
 #include "Model/LockState.h"
@@ -41,11 +43,14 @@ namespace TrenchBroom {
         MapReader(std::move(str), sourceAndTargetMapFormat, sourceAndTargetMapFormat),
         m_world(std::make_unique<Model::WorldNode>(Model::Entity(), sourceAndTargetMapFormat)) {
             m_world->disableNodeTreeUpdates();
+            m_world->entityNodeIndex().beginBatch();
         }
 
         std::unique_ptr<Model::WorldNode> WorldReader::read(const vm::bbox3& worldBounds, ParserStatus& status) {
+            TB_PROFILE_SCOPE("WorldReader::read");
             readEntities(worldBounds, status);
             sanitizeLayerSortIndicies(status);
+            m_world->entityNodeIndex().endBatch();
             m_world->rebuildNodeTree();
             m_world->enableNodeTreeUpdates();
             return std::move(m_world);
@@ -23,6 +23,7 @@
 #include "FloatType.h"
 #include "Polyhedron.h"
 #include "Polyhedron_Matcher.h"
+#include "Profiler.h"
 #include "Model/BrushError.h"
 #include "Model/BrushFace.h"
 #include "Model/BrushGeometry.h"
@@ -62,12 +63,12 @@ namespace TrenchBroom {
 
         Brush::Brush(const Brush& other) :
         m_faces(other.m_faces),
-        m_geometry(other.m_geometry ? std::make_unique<BrushGeometry>(*other.m_geometry, CopyCallback()) : nullptr) {
+        m_geometry(other.m_geometry) {
+            // the copied faces are not linked to any geometry, so they are linked to the shared geometry here
             if (m_geometry) {
-                for (BrushFaceGeometry* faceGeometry : m_geometry->faces()) {
+                for (const BrushFaceGeometry* faceGeometry : m_geometry->faces()) {
                     if (const auto faceIndex = faceGeometry->payload()) {
-                        BrushFace& face = m_faces[*faceIndex];
-                        face.setGeometry(faceGeometry);
+                        m_faces[*faceIndex].setGeometry(faceGeometry);
                     }
                 }
             }
@@ -95,6 +96,7 @@ namespace TrenchBroom {
         m_faces(std::move(faces)) {}
 
         kdl::result<Brush, BrushError> Brush::create(const vm::bbox3& worldBounds, std::vector<BrushFace> faces) {
+            TB_PROFILE_SCOPE("Brush::create");
             Brush brush(std::move(faces));
             return brush.updateGeometryFromFaces(worldBounds)
                 .and_then([&]() { return std::move(brush); });
@@ -145,11 +147,80 @@ namespace TrenchBroom {
             return kdl::void_success;
         }
         
+        /**
+         * Applies the given transformation to the existing geometry instead of rebuilding it from the already
+         * transformed faces. This is only possible if the transformation is affine, invertible and preserves
+         * orientation, because then it cannot change the topology of the brush.
+         *
+         * Returns false if the transformation is not suitable or if the transformed geometry does not match the
+         * transformed faces, e.g. because the face points were rounded. In that case, the geometry must be rebuilt.
+         */
+        bool Brush::transformGeometry(const vm::bbox3& worldBounds, const vm::mat4x4& transformation) {
+            if (transformation[0][3] != 0.0 || transformation[1][3] != 0.0 || transformation[2][3] != 0.0 || transformation[3][3] != 1.0) {
+                return false;
+            }
+
+            if (vm::compute_determinant(transformation) <= vm::C::almost_zero()) {
+                return false;
+            }
+
+            // the current geometry may be shared with other brushes, so the transformation is applied to a copy
+            auto geometry = std::make_unique<BrushGeometry>(*m_geometry, CopyCallback());
+            geometry->transform(transformation);
+
+            // Correct vertex positions and heal short edges just like updateGeometryFromFaces does
+            const auto edgeCount = geometry->edgeCount();
+            geometry->correctVertexPositions();
+            if (!geometry->healEdges() || geometry->edgeCount() != edgeCount) {
+                return false;
+            }
+
+            if (!worldBounds.contains(geometry->bounds())) {
+                return false;
+            }
+
+            for (BrushFaceGeometry* faceGeometry : geometry->faces()) {
+                const auto& boundary = m_faces[*faceGeometry->payload()].boundary();
+                faceGeometry->setPlane(boundary);
+
+                for (const BrushHalfEdge* halfEdge : faceGeometry->boundary()) {
+                    if (boundary.point_status(halfEdge->origin()->position()) != vm::plane_status::inside) {
+                        return false;
+                    }
+                }
+            }
+
+            for (BrushFaceGeometry* faceGeometry : geometry->faces()) {
+                m_faces[*faceGeometry->payload()].setGeometry(faceGeometry);
+            }
+
+            // A rebuilt geometry adds the faces in sorted order, so the faces are sorted to keep the face order (and
+            // the order in which the faces are written to map files) independent of how the geometry was obtained.
+            BrushFace::sortFaces(m_faces);
+
+            std::unordered_map<const BrushFaceGeometry*, size_t> faceIndices;
+            for (size_t i = 0u; i < m_faces.size(); ++i) {
+                faceIndices[m_faces[i].geometry()] = i;
+            }
+            for (BrushFaceGeometry* faceGeometry : geometry->faces()) {
+                faceGeometry->setPayload(faceIndices.at(faceGeometry));
+            }
+            m_geometry = std::move(geometry);
+
+            assert(checkFaceLinks());
+
+            return true;
+        }
+
         const vm::bbox3& Brush::bounds() const {
             ensure(m_geometry != nullptr, "geometry is null");
             return m_geometry->bounds();
         }
 
+        size_t Brush::geometryShareCount() const {
+            return m_geometry ? static_cast<size_t>(m_geometry.use_count()) : 0u;
+        }
+
         std::optional<size_t> Brush::findFace(const std::string& textureName) const {
             return kdl::vec_index_of(m_faces, [&](const BrushFace& face) { return face.attributes().textureName() == textureName; });
         }
@@ -724,7 +795,7 @@ namespace TrenchBroom {
             return updateFacesFromGeometry(worldBounds, matcher, newGeometry, uvLock);
         }
 
-        std::tuple<bool, vm::mat4x4> Brush::findTransformForUVLock(const PolyhedronMatcher<BrushGeometry>& matcher, BrushFaceGeometry* left, BrushFaceGeometry* right) {
+        std::tuple<bool, vm::mat4x4> Brush::findTransformForUVLock(const PolyhedronMatcher<BrushGeometry>& matcher, const BrushFaceGeometry* left, const BrushFaceGeometry* right) {
             std::vector<vm::vec3> unmovedVerts;
             std::vector<std::pair<vm::vec3, vm::vec3>> movedVerts;
 
@@ -869,7 +940,11 @@ namespace TrenchBroom {
                     return BrushError::InvalidFace;
                 }
             }
-            
+
+            if (transformGeometry(worldBounds, transformation)) {
+                return kdl::void_success;
+            }
+
             return updateGeometryFromFaces(worldBounds);
         }
 
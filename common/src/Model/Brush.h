@@ -52,7 +52,13 @@ namespace TrenchBroom {
             using EdgeList = BrushEdgeList;
         private:
             std::vector<BrushFace> m_faces;
-            std::unique_ptr<BrushGeometry> m_geometry;
+
+            /**
+             * The geometry is never modified once it has been linked to the faces. Copies of a brush share its
+             * geometry, and every operation that changes the geometry replaces it with a new polyhedron. This way,
+             * copying a brush or changing only the attributes of its faces never copies the polyhedron.
+             */
+            std::shared_ptr<const BrushGeometry> m_geometry;
         public:
             Brush();
 
@@ -69,8 +75,14 @@ namespace TrenchBroom {
             Brush(std::vector<BrushFace> faces);
 
             kdl::result<void, BrushError> updateGeometryFromFaces(const vm::bbox3& worldBounds);
+            bool transformGeometry(const vm::bbox3& worldBounds, const vm::mat4x4& transformation);
         public:
             const vm::bbox3& bounds() const;
+
+            /**
+             * Returns the number of brushes that share the geometry of this brush, including this brush.
+             */
+            size_t geometryShareCount() const;
         public: // face management:
             std::optional<size_t> findFace(const std::string& textureName) const;
             std::optional<size_t> findFace(const vm::vec3& normal) const;
@@ -182,7 +194,7 @@ namespace TrenchBroom {
              * @param right the face of the right polyhedron
              * @return {true, transform} if a transform could be found, otherwise {false, unspecified}
              */
-            static std::tuple<bool, vm::mat4x4> findTransformForUVLock(const PolyhedronMatcher<BrushGeometry>& matcher, BrushFaceGeometry* left, BrushFaceGeometry* right);
+            static std::tuple<bool, vm::mat4x4> findTransformForUVLock(const PolyhedronMatcher<BrushGeometry>& matcher, const BrushFaceGeometry* left, const BrushFaceGeometry* right);
             
             /**
              * Helper function to apply UV lock to the face `right`.
@@ -48,6 +48,7 @@
 
 #include <sstream>
 #include <string>
+#include <variant>
 
 namespace TrenchBroom {
     namespace Model {
@@ -65,7 +66,7 @@ namespace TrenchBroom {
         m_boundary(other.m_boundary),
         m_attributes(other.m_attributes),
         m_textureReference(other.m_textureReference),
-        m_texCoordSystem(other.m_texCoordSystem ? other.m_texCoordSystem->clone() : nullptr),
+        m_texCoordSystem(other.m_texCoordSystem),
         m_geometry(nullptr),
         m_lineNumber(other.m_lineNumber),
         m_lineCount(other.m_lineCount),
@@ -110,47 +111,37 @@ namespace TrenchBroom {
 
         kdl::result<BrushFace, BrushError> BrushFace::create(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attributes, const MapFormat mapFormat) {
             return Model::isParallelTexCoordSystem(mapFormat)
-                   ? BrushFace::create(point0, point1, point2, attributes, std::make_unique<ParallelTexCoordSystem>(point0, point1, point2, attributes))
-                   : BrushFace::create(point0, point1, point2, attributes, std::make_unique<ParaxialTexCoordSystem>(point0, point1, point2, attributes));
+                   ? BrushFace::create(point0, point1, point2, attributes, ParallelTexCoordSystem(point0, point1, point2, attributes))
+                   : BrushFace::create(point0, point1, point2, attributes, ParaxialTexCoordSystem(point0, point1, point2, attributes));
         }
 
         kdl::result<BrushFace, BrushError> BrushFace::createFromStandard(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& inputAttribs, const MapFormat mapFormat) {
             assert(mapFormat != MapFormat::Unknown);
 
-            std::unique_ptr<TexCoordSystem> texCoordSystem;
-            BrushFaceAttributes attribs("");
-
             if (Model::isParallelTexCoordSystem(mapFormat)) {
                 // Convert paraxial to parallel
-                std::tie(texCoordSystem, attribs) = ParallelTexCoordSystem::fromParaxial(point0, point1, point2, inputAttribs);
+                auto [texCoordSystem, attribs] = ParallelTexCoordSystem::fromParaxial(point0, point1, point2, inputAttribs);
+                return BrushFace::create(point0, point1, point2, attribs, std::move(texCoordSystem));
             } else {
                 // Pass through paraxial
-                texCoordSystem = std::make_unique<ParaxialTexCoordSystem>(point0, point1, point2, inputAttribs);
-                attribs = inputAttribs;
+                return BrushFace::create(point0, point1, point2, inputAttribs, ParaxialTexCoordSystem(point0, point1, point2, inputAttribs));
             }
-
-            return BrushFace::create(point0, point1, point2, attribs, std::move(texCoordSystem));
         }
 
         kdl::result<BrushFace, BrushError> BrushFace::createFromValve(const vm::vec3& point1, const vm::vec3& point2, const vm::vec3& point3, const BrushFaceAttributes& inputAttribs, const vm::vec3& texAxisX, const vm::vec3& texAxisY, MapFormat mapFormat) {
             assert(mapFormat != MapFormat::Unknown);
 
-            std::unique_ptr<TexCoordSystem> texCoordSystem;
-            BrushFaceAttributes attribs("");
-
             if (Model::isParallelTexCoordSystem(mapFormat)) {
                 // Pass through parallel
-                texCoordSystem = std::make_unique<ParallelTexCoordSystem>(texAxisX, texAxisY);
-                attribs = inputAttribs;
+                return BrushFace::create(point1, point2, point3, inputAttribs, ParallelTexCoordSystem(texAxisX, texAxisY));
             } else {
                 // Convert parallel to paraxial
-                std::tie(texCoordSystem, attribs) = ParaxialTexCoordSystem::fromParallel(point1, point2, point3, inputAttribs, texAxisX, texAxisY);
+                auto [texCoordSystem, attribs] = ParaxialTexCoordSystem::fromParallel(point1, point2, point3, inputAttribs, texAxisX, texAxisY);
+                return BrushFace::create(point1, point2, point3, attribs, std::move(texCoordSystem));
             }
-
-            return BrushFace::create(point1, point2, point3, attribs, std::move(texCoordSystem));
         }
 
-        kdl::result<BrushFace, BrushError> BrushFace::create(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attributes, std::unique_ptr<TexCoordSystem> texCoordSystem) {
+        kdl::result<BrushFace, BrushError> BrushFace::create(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attributes, TexCoordSystemVariant texCoordSystem) {
             Points points = {{ vm::correct(point0), vm::correct(point1), vm::correct(point2) }};
             const auto [result, plane] = vm::from_points(points[0], points[1], points[2]);
             if (result) {
@@ -160,7 +151,7 @@ namespace TrenchBroom {
             }
         }
 
-        BrushFace::BrushFace(const BrushFace::Points& points, const vm::plane3& boundary, const BrushFaceAttributes& attributes, std::unique_ptr<TexCoordSystem> texCoordSystem) :
+        BrushFace::BrushFace(const BrushFace::Points& points, const vm::plane3& boundary, const BrushFaceAttributes& attributes, TexCoordSystemVariant texCoordSystem) :
         m_points(points),
         m_boundary(boundary),
         m_attributes(attributes),
@@ -169,15 +160,13 @@ namespace TrenchBroom {
         m_lineNumber(0),
         m_lineCount(0),
         m_selected(false),
-        m_markedToRenderFace(false) {
-            ensure(m_texCoordSystem != nullptr, "texCoordSystem is null");
-        }
+        m_markedToRenderFace(false) {}
 
         bool operator==(const BrushFace& lhs, const BrushFace& rhs) {
             return lhs.m_points == rhs.m_points &&
             lhs.m_boundary == rhs.m_boundary &&
             lhs.m_attributes == rhs.m_attributes &&
-            *lhs.m_texCoordSystem == *rhs.m_texCoordSystem &&
+            lhs.texCoordSystem() == rhs.texCoordSystem() &&
             lhs.m_lineNumber == rhs.m_lineNumber &&
             lhs.m_lineCount == rhs.m_lineCount &&
             lhs.m_selected == rhs.m_selected;
@@ -215,11 +204,11 @@ namespace TrenchBroom {
         }
 
         std::unique_ptr<TexCoordSystemSnapshot> BrushFace::takeTexCoordSystemSnapshot() const {
-            return m_texCoordSystem->takeSnapshot();
+            return texCoordSystem().takeSnapshot();
         }
 
         void BrushFace::restoreTexCoordSystemSnapshot(const TexCoordSystemSnapshot& coordSystemSnapshot) {
-            coordSystemSnapshot.restore(*m_texCoordSystem);
+            coordSystemSnapshot.restore(mutableTexCoordSystem());
         }
 
         void BrushFace::copyTexCoordSystemFromFace(const TexCoordSystemSnapshot& coordSystemSnapshot, const BrushFaceAttributes& attributes, const vm::plane3& sourceFacePlane, const WrapStyle wrapStyle) {
@@ -227,16 +216,16 @@ namespace TrenchBroom {
             const auto seam = vm::intersect_plane_plane(sourceFacePlane, m_boundary);
             const auto refPoint = vm::project_point(seam, center());
 
-            coordSystemSnapshot.restore(*m_texCoordSystem);
+            coordSystemSnapshot.restore(mutableTexCoordSystem());
 
             // Get the texcoords at the refPoint using the source face's attributes and tex coord system
-            const auto desriedCoords = m_texCoordSystem->getTexCoords(refPoint, attributes, vm::vec2f::one());
+            const auto desriedCoords = texCoordSystem().getTexCoords(refPoint, attributes, vm::vec2f::one());
 
-            m_texCoordSystem->updateNormal(sourceFacePlane.normal, m_boundary.normal, m_attributes, wrapStyle);
+            mutableTexCoordSystem().updateNormal(sourceFacePlane.normal, m_boundary.normal, m_attributes, wrapStyle);
 
             // Adjust the offset on this face so that the texture coordinates at the refPoint stay the same
             if (!vm::is_zero(seam.direction, vm::C::almost_zero())) {
-                const auto currentCoords = m_texCoordSystem->getTexCoords(refPoint, m_attributes, vm::vec2f::one());
+                const auto currentCoords = texCoordSystem().getTexCoords(refPoint, m_attributes, vm::vec2f::one());
                 const auto offsetChange = desriedCoords - currentCoords;
                 m_attributes.setOffset(correct(modOffset(m_attributes.offset() + offsetChange), 4));
             }
@@ -314,7 +303,7 @@ namespace TrenchBroom {
         void BrushFace::setAttributes(const BrushFaceAttributes& attributes) {
             const float oldRotation = m_attributes.rotation();
             m_attributes = attributes;
-            m_texCoordSystem->setRotation(m_boundary.normal, oldRotation, m_attributes.rotation());
+            mutableTexCoordSystem().setRotation(m_boundary.normal, oldRotation, m_attributes.rotation());
         }
 
         bool BrushFace::setAttributes(const BrushFace& other) {
@@ -332,13 +321,11 @@ namespace TrenchBroom {
         }
 
         void BrushFace::resetTexCoordSystemCache() {
-            if (m_texCoordSystem != nullptr) {
-                m_texCoordSystem->resetCache(m_points[0], m_points[1], m_points[2], m_attributes);
-            }
+            mutableTexCoordSystem().resetCache(m_points[0], m_points[1], m_points[2], m_attributes);
         }
 
         const TexCoordSystem& BrushFace::texCoordSystem() const {
-            return *m_texCoordSystem;
+            return std::visit([](const auto& texCoordSystem) -> const TexCoordSystem& { return texCoordSystem; }, m_texCoordSystem);
         }
 
         const Assets::Texture* BrushFace::texture() const {
@@ -368,30 +355,30 @@ namespace TrenchBroom {
         }
 
         vm::vec3 BrushFace::textureXAxis() const {
-            return m_texCoordSystem->xAxis();
+            return texCoordSystem().xAxis();
         }
 
         vm::vec3 BrushFace::textureYAxis() const {
-            return m_texCoordSystem->yAxis();
+            return texCoordSystem().yAxis();
         }
 
         void BrushFace::resetTextureAxes() {
-            m_texCoordSystem->resetTextureAxes(m_boundary.normal);
+            mutableTexCoordSystem().resetTextureAxes(m_boundary.normal);
         }
 
         void BrushFace::resetTextureAxesToParaxial() {
-            m_texCoordSystem->resetTextureAxesToParaxial(m_boundary.normal, 0.0f);
+            mutableTexCoordSystem().resetTextureAxesToParaxial(m_boundary.normal, 0.0f);
         }
 
         void BrushFace::convertToParaxial() {
-            auto [newTexCoordSystem, newAttributes] = m_texCoordSystem->toParaxial(m_points[0], m_points[1], m_points[2], m_attributes);
+            auto [newTexCoordSystem, newAttributes] = texCoordSystem().toParaxial(m_points[0], m_points[1], m_points[2], m_attributes);
 
             m_attributes = newAttributes;
             m_texCoordSystem = std::move(newTexCoordSystem);
         }
 
         void BrushFace::convertToParallel() {
-            auto [newTexCoordSystem, newAttributes] = m_texCoordSystem->toParallel(m_points[0], m_points[1], m_points[2], m_attributes);
+            auto [newTexCoordSystem, newAttributes] = texCoordSystem().toParallel(m_points[0], m_points[1], m_points[2], m_attributes);
 
             m_attributes = newAttributes;
             m_texCoordSystem = std::move(newTexCoordSystem);
@@ -399,21 +386,21 @@ namespace TrenchBroom {
 
 
         void BrushFace::moveTexture(const vm::vec3& up, const vm::vec3& right, const vm::vec2f& offset) {
-            m_texCoordSystem->moveTexture(m_boundary.normal, up, right, offset, m_attributes);
+            texCoordSystem().moveTexture(m_boundary.normal, up, right, offset, m_attributes);
         }
 
         void BrushFace::rotateTexture(const float angle) {
             const float oldRotation = m_attributes.rotation();
-            m_texCoordSystem->rotateTexture(m_boundary.normal, angle, m_attributes);
-            m_texCoordSystem->setRotation(m_boundary.normal, oldRotation, m_attributes.rotation());
+            texCoordSystem().rotateTexture(m_boundary.normal, angle, m_attributes);
+            mutableTexCoordSystem().setRotation(m_boundary.normal, oldRotation, m_attributes.rotation());
         }
 
         void BrushFace::shearTexture(const vm::vec2f& factors) {
-            m_texCoordSystem->shearTexture(m_boundary.normal, factors);
+            mutableTexCoordSystem().shearTexture(m_boundary.normal, factors);
         }
 
         void BrushFace::flipTexture(const vm::vec3& /* cameraUp */, const vm::vec3& cameraRight, const vm::direction cameraRelativeFlipDirection) {
-            const vm::mat4x4 texToWorld = m_texCoordSystem->fromMatrix(vm::vec2f::zero(), vm::vec2f::one());
+            const vm::mat4x4 texToWorld = texCoordSystem().fromMatrix(vm::vec2f::zero(), vm::vec2f::one());
 
             const vm::vec3 texUAxisInWorld = vm::normalize((texToWorld * vm::vec4d(1, 0, 0, 0)).xyz());
             const vm::vec3 texVAxisInWorld = vm::normalize((texToWorld * vm::vec4d(0, 1, 0, 0)).xyz());
@@ -462,7 +449,7 @@ namespace TrenchBroom {
 
             return setPoints(m_points[0], m_points[1], m_points[2])
                 .and_then([&]() {
-                    m_texCoordSystem->transform(oldBoundary, m_boundary, transform, m_attributes, textureSize(), lockTexture, invariant);
+                    mutableTexCoordSystem().transform(oldBoundary, m_boundary, transform, m_attributes, textureSize(), lockTexture, invariant);
                 });
         }
 
@@ -490,12 +477,12 @@ namespace TrenchBroom {
                     const auto refPoint = project_point(seam, center());
 
                     // Get the texcoords at the refPoint using the old face's attribs and tex coord system
-                    const auto desriedCoords = m_texCoordSystem->getTexCoords(refPoint, m_attributes, vm::vec2f::one());
+                    const auto desriedCoords = texCoordSystem().getTexCoords(refPoint, m_attributes, vm::vec2f::one());
 
-                    m_texCoordSystem->updateNormal(oldPlane.normal, m_boundary.normal, m_attributes, WrapStyle::Projection);
+                    mutableTexCoordSystem().updateNormal(oldPlane.normal, m_boundary.normal, m_attributes, WrapStyle::Projection);
 
                     // Adjust the offset on this face so that the texture coordinates at the refPoint stay the same
-                    const auto currentCoords = m_texCoordSystem->getTexCoords(refPoint, m_attributes, vm::vec2f::one());
+                    const auto currentCoords = texCoordSystem().getTexCoords(refPoint, m_attributes, vm::vec2f::one());
                     const auto offsetChange = desriedCoords - currentCoords;
                     m_attributes.setOffset(correct(modOffset(m_attributes.offset() + offsetChange), 4));
                 }
@@ -503,7 +490,7 @@ namespace TrenchBroom {
         }
 
         vm::mat4x4 BrushFace::projectToBoundaryMatrix() const {
-            const auto texZAxis = m_texCoordSystem->fromMatrix(vm::vec2f::zero(), vm::vec2f::one()) * vm::vec3::pos_z();
+            const auto texZAxis = texCoordSystem().fromMatrix(vm::vec2f::zero(), vm::vec2f::one()) * vm::vec3::pos_z();
             const auto worldToPlaneMatrix = vm::plane_projection_matrix(m_boundary.distance, m_boundary.normal, texZAxis);
             const auto [invertible, planeToWorldMatrix] = vm::invert(worldToPlaneMatrix); assert(invertible); unused(invertible);
             return planeToWorldMatrix * vm::mat4x4::zero_out<2>() * worldToPlaneMatrix;
@@ -511,22 +498,22 @@ namespace TrenchBroom {
 
         vm::mat4x4 BrushFace::toTexCoordSystemMatrix(const vm::vec2f& offset, const vm::vec2f& scale, const bool project) const {
             if (project) {
-                return vm::mat4x4::zero_out<2>() * m_texCoordSystem->toMatrix(offset, scale);
+                return vm::mat4x4::zero_out<2>() * texCoordSystem().toMatrix(offset, scale);
             } else {
-                return m_texCoordSystem->toMatrix(offset, scale);
+                return texCoordSystem().toMatrix(offset, scale);
             }
         }
 
         vm::mat4x4 BrushFace::fromTexCoordSystemMatrix(const vm::vec2f& offset, const vm::vec2f& scale, const bool project) const {
             if (project) {
-                return projectToBoundaryMatrix() * m_texCoordSystem->fromMatrix(offset, scale);
+                return projectToBoundaryMatrix() * texCoordSystem().fromMatrix(offset, scale);
             } else {
-                return m_texCoordSystem->fromMatrix(offset, scale);
+                return texCoordSystem().fromMatrix(offset, scale);
             }
         }
 
         float BrushFace::measureTextureAngle(const vm::vec2f& center, const vm::vec2f& point) const {
-            return m_texCoordSystem->measureAngle(m_attributes.rotation(), center, point);
+            return texCoordSystem().measureAngle(m_attributes.rotation(), center, point);
         }
 
         size_t BrushFace::vertexCount() const {
@@ -559,11 +546,11 @@ namespace TrenchBroom {
             return vm::polygon3(vertexPositions());
         }
 
-        BrushFaceGeometry* BrushFace::geometry() const {
+        const BrushFaceGeometry* BrushFace::geometry() const {
             return m_geometry;
         }
 
-        void BrushFace::setGeometry(BrushFaceGeometry* geometry) {
+        void BrushFace::setGeometry(const BrushFaceGeometry* geometry) {
             m_geometry = geometry;
         }
 
@@ -591,7 +578,11 @@ namespace TrenchBroom {
         }
 
         vm::vec2f BrushFace::textureCoords(const vm::vec3& point) const {
-            return m_texCoordSystem->getTexCoords(point, m_attributes, textureSize());
+            return texCoordSystem().getTexCoords(point, m_attributes, textureSize());
+        }
+
+        TexCoordProjection BrushFace::textureProjection() const {
+            return texCoordSystem().projection(m_attributes, textureSize());
         }
 
         FloatType BrushFace::intersectWithRay(const vm::ray3& ray) const {
@@ -626,6 +617,10 @@ namespace TrenchBroom {
             }
         }
 
+        TexCoordSystem& BrushFace::mutableTexCoordSystem() {
+            return std::visit([](auto& texCoordSystem) -> TexCoordSystem& { return texCoordSystem; }, m_texCoordSystem);
+        }
+
         void BrushFace::setMarked(const bool marked) const {
             m_markedToRenderFace = marked;
         }
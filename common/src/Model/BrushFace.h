@@ -24,6 +24,8 @@
 #include "Assets/AssetReference.h"
 #include "Model/BrushFaceAttributes.h"
 #include "Model/BrushGeometry.h"
+#include "Model/ParallelTexCoordSystem.h"
+#include "Model/ParaxialTexCoordSystem.h"
 #include "Model/Tag.h" // BrushFace inherits from Taggable
 
 #include <kdl/result_forward.h>
@@ -37,6 +39,7 @@
 #include <iosfwd>
 #include <memory>
 #include <string>
+#include <variant>
 #include <vector>
 
 namespace TrenchBroom {
@@ -45,9 +48,6 @@ namespace TrenchBroom {
     }
 
     namespace Model {
-        class TexCoordSystem;
-        class TexCoordSystemSnapshot;
-        enum class WrapStyle;
         enum class BrushError;
         enum class MapFormat;
 
@@ -64,6 +64,11 @@ namespace TrenchBroom {
              * 0-----------2
              */
             using Points = std::array<vm::vec3, 3u>;
+
+            /**
+             * The texture coordinate system is stored inline so that copying a face does not allocate.
+             */
+            using TexCoordSystemVariant = std::variant<ParaxialTexCoordSystem, ParallelTexCoordSystem>;
         private:
             /**
              * For use in VertexList transformation below.
@@ -87,8 +92,8 @@ namespace TrenchBroom {
             BrushFaceAttributes m_attributes;
 
             Assets::AssetReference<Assets::Texture> m_textureReference;
-            std::unique_ptr<TexCoordSystem> m_texCoordSystem;
-            BrushFaceGeometry* m_geometry;
+            TexCoordSystemVariant m_texCoordSystem;
+            const BrushFaceGeometry* m_geometry;
 
             mutable size_t m_lineNumber;
             mutable size_t m_lineCount;
@@ -134,9 +139,9 @@ namespace TrenchBroom {
              */
             static kdl::result<BrushFace, BrushError> createFromValve(const vm::vec3& point1, const vm::vec3& point2, const vm::vec3& point3, const BrushFaceAttributes& attributes, const vm::vec3& texAxisX, const vm::vec3& texAxisY, MapFormat mapFormat);
 
-            static kdl::result<BrushFace, BrushError> create(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attributes, std::unique_ptr<TexCoordSystem> texCoordSystem);
+            static kdl::result<BrushFace, BrushError> create(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attributes, TexCoordSystemVariant texCoordSystem);
 
-            BrushFace(const BrushFace::Points& points, const vm::plane3& boundary, const BrushFaceAttributes& attributes, std::unique_ptr<TexCoordSystem> texCoordSystem);
+            BrushFace(const BrushFace::Points& points, const vm::plane3& boundary, const BrushFaceAttributes& attributes, TexCoordSystemVariant texCoordSystem);
 
             friend bool operator==(const BrushFace& lhs, const BrushFace& rhs);
             friend bool operator!=(const BrushFace& lhs, const BrushFace& rhs);
@@ -199,8 +204,12 @@ namespace TrenchBroom {
             bool hasVertices(const vm::polygon3& vertices, FloatType epsilon = static_cast<FloatType>(0.0)) const;
             vm::polygon3 polygon() const;
         public:
-            BrushFaceGeometry* geometry() const;
-            void setGeometry(BrushFaceGeometry* geometry);
+            /**
+             * Returns the geometry of this face. The geometry is shared between copies of its brush, so it must not be
+             * modified.
+             */
+            const BrushFaceGeometry* geometry() const;
+            void setGeometry(const BrushFaceGeometry* geometry);
 
             size_t lineNumber() const;
             void setFilePosition(size_t lineNumber, size_t lineCount) const;
@@ -211,10 +220,18 @@ namespace TrenchBroom {
 
             vm::vec2f textureCoords(const vm::vec3& point) const;
 
+            /**
+             * Returns a projection that computes the same texture coordinates as textureCoords, but which can be
+             * applied to all vertices of this face without any virtual calls.
+             */
+            TexCoordProjection textureProjection() const;
+
             FloatType intersectWithRay(const vm::ray3& ray) const;
         private:
             kdl::result<void, BrushError> setPoints(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2);
             void correctPoints();
+
+            TexCoordSystem& mutableTexCoordSystem();
         public: // brush renderer
             /**
              * This is used to cache results of evaluating the BrushRenderer Filter.
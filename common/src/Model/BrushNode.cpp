@@ -21,6 +21,7 @@
 
 #include "Exceptions.h"
 #include "FloatType.h"
+#include "ObjectPool.h"
 #include "Polyhedron.h"
 #include "Polyhedron_Matcher.h"
 #include "Model/Brush.h"
@@ -63,14 +64,35 @@ namespace TrenchBroom {
     namespace Model {
         const HitType::Type BrushNode::BrushHitType = HitType::freeType();
 
+        static ObjectPool<BrushNode>& brushNodePool() {
+            // the pool is never destroyed because brush nodes may still be deleted during static destruction
+            static auto* pool = new ObjectPool<BrushNode>();
+            return *pool;
+        }
+
         BrushNode::BrushNode(Brush brush) :
-        m_brushRendererBrushCache(std::make_unique<Renderer::BrushRendererBrushCache>()),
         m_brush(std::move(brush)) {
             updateSelectedFaceCount();
         }
 
         BrushNode::~BrushNode() = default;
 
+        void* BrushNode::operator new(const size_t size) {
+            // subclasses cannot be allocated from the pool
+            if (size != sizeof(BrushNode)) {
+                return ::operator new(size);
+            }
+            return brushNodePool().allocate();
+        }
+
+        void BrushNode::operator delete(void* ptr, const size_t size) {
+            if (size != sizeof(BrushNode)) {
+                ::operator delete(ptr);
+            } else {
+                brushNodePool().deallocate(ptr);
+            }
+        }
+
         BrushNode* BrushNode::clone(const vm::bbox3& worldBounds) const {
             return static_cast<BrushNode*>(Node::clone(worldBounds));
         }
@@ -123,6 +145,7 @@ namespace TrenchBroom {
 
         void BrushNode::updateFaceTags(const size_t faceIndex, TagManager& tagManager) {
             m_brush.face(faceIndex).updateTags(tagManager);
+            invalidateCachedVisibility();
         }
 
         void BrushNode::setFaceTexture(const size_t faceIndex, Assets::Texture* texture) {
@@ -253,10 +276,16 @@ namespace TrenchBroom {
         }
 
         void BrushNode::invalidateVertexCache() {
-            m_brushRendererBrushCache->invalidateVertexCache();
+            if (m_brushRendererBrushCache != nullptr) {
+                m_brushRendererBrushCache->invalidateVertexCache();
+            }
         }
 
         Renderer::BrushRendererBrushCache& BrushNode::brushRendererBrushCache() const {
+            // brushes that are never rendered, e.g. the brushes held by undo commands, don't need a cache
+            if (m_brushRendererBrushCache == nullptr) {
+                m_brushRendererBrushCache = std::make_unique<Renderer::BrushRendererBrushCache>();
+            }
             return *m_brushRendererBrushCache;
         }
 
@@ -265,6 +294,7 @@ namespace TrenchBroom {
             for (auto& face : m_brush.faces()) {
                 face.initializeTags(tagManager);
             }
+            invalidateCachedVisibility();
         }
 
         void BrushNode::clearTags() {
@@ -272,6 +302,7 @@ namespace TrenchBroom {
                 face.clearTags();
             }
             Taggable::clearTags();
+            invalidateCachedVisibility();
         }
 
         void BrushNode::updateTags(TagManager& tagManager) {
@@ -279,6 +310,7 @@ namespace TrenchBroom {
                 face.updateTags(tagManager);
             }
             Taggable::updateTags(tagManager);
+            invalidateCachedVisibility();
         }
 
         bool BrushNode::allFacesHaveAnyTagInMask(TagType::Type tagMask) const {
@@ -60,12 +60,21 @@ namespace TrenchBroom {
             using VertexList = BrushVertexList;
             using EdgeList = BrushEdgeList;
         private:
-            mutable std::unique_ptr<Renderer::BrushRendererBrushCache> m_brushRendererBrushCache; // unique_ptr for breaking header dependencies
+            mutable std::unique_ptr<Renderer::BrushRendererBrushCache> m_brushRendererBrushCache; // unique_ptr for breaking header dependencies, created on demand
             Brush m_brush; // must be destroyed before the brush renderer cache
             size_t m_selectedFaceCount = 0u;
         public:
             explicit BrushNode(Brush brush);
             ~BrushNode() override;
+
+            /**
+             * Brush nodes are allocated from a pool to reduce the overhead of allocating many small objects.
+             *
+             * The pool is never destroyed and never returns its blocks to the heap. After a large map has been closed,
+             * the memory of its brush nodes stays reserved for the brush nodes created later.
+             */
+            static void* operator new(size_t size);
+            static void operator delete(void* ptr, size_t size);
         public:
             BrushNode* clone(const vm::bbox3& worldBounds) const;
 
@@ -23,6 +23,7 @@
 #include "PreferenceManager.h"
 #include "Preferences.h"
 #include "Assets/EntityDefinition.h"
+#include "IO/Path.h"
 #include "Model/Brush.h"
 #include "Model/BrushNode.h"
 #include "Model/BrushFace.h"
@@ -35,8 +36,22 @@
 
 namespace TrenchBroom {
     namespace Model {
+        /**
+         * Generations are never reused, so a node cannot mistake a visibility cached by one editor context for
+         * that of another.
+         */
+        static size_t nextGeneration() {
+            static size_t generation = 0u;
+            return ++generation;
+        }
+
         EditorContext::EditorContext() {
             reset();
+            PreferenceManager::instance().preferenceDidChangeNotifier.addObserver(this, &EditorContext::preferenceDidChange);
+        }
+
+        EditorContext::~EditorContext() {
+            PreferenceManager::instance().preferenceDidChangeNotifier.removeObserver(this, &EditorContext::preferenceDidChange);
         }
 
         void EditorContext::reset() {
@@ -44,6 +59,7 @@ namespace TrenchBroom {
             m_hiddenEntityDefinitions.reset();
             m_blockSelection = false;
             m_currentGroup = nullptr;
+            invalidateCachedVisibility();
         }
 
         TagType::Type EditorContext::hiddenTags() const {
@@ -53,6 +69,7 @@ namespace TrenchBroom {
         void EditorContext::setHiddenTags(const TagType::Type hiddenTags) {
             if (hiddenTags != m_hiddenTags) {
                 m_hiddenTags = hiddenTags;
+                invalidateCachedVisibility();
                 editorContextDidChangeNotifier();
             }
         }
@@ -68,6 +85,7 @@ namespace TrenchBroom {
         void EditorContext::setEntityDefinitionHidden(const Assets::EntityDefinition* definition, const bool hidden) {
             if (definition != nullptr && entityDefinitionHidden(definition) != hidden) {
                 m_hiddenEntityDefinitions[definition->index()] = hidden;
+                invalidateCachedVisibility();
                 editorContextDidChangeNotifier();
             }
         }
@@ -107,6 +125,17 @@ namespace TrenchBroom {
             }
         }
 
+        template <typename F>
+        bool EditorContext::cachedVisible(const Model::Node* node, const F& computeVisible) const {
+            if (const auto cachedVisibility = node->cachedVisibility(m_generation)) {
+                return *cachedVisibility;
+            }
+
+            const auto visibility = computeVisible();
+            node->setCachedVisibility(m_generation, visibility);
+            return visibility;
+        }
+
         bool EditorContext::visible(const Model::Node* node) const {
             return node->accept(kdl::overload(
                 [&](const WorldNode* world)   { return visible(world); },
@@ -126,64 +155,70 @@ namespace TrenchBroom {
         }
 
         bool EditorContext::visible(const Model::GroupNode* groupNode) const {
-            if (groupNode->selected()) {
-                return true;
-            }
-            if (!anyChildVisible(groupNode)) {
-                return false;
-            }
-            return groupNode->visible();
+            return cachedVisible(groupNode, [&]() {
+                if (groupNode->selected()) {
+                    return true;
+                }
+                if (!anyChildVisible(groupNode)) {
+                    return false;
+                }
+                return groupNode->visible();
+            });
         }
 
         bool EditorContext::visible(const Model::EntityNode* entityNode) const {
-            if (entityNode->selected()) {
-                return true;
-            }
+            return cachedVisible(entityNode, [&]() {
+                if (entityNode->selected()) {
+                    return true;
+                }
 
-            if (!entityNode->entity().pointEntity()) {
-                if (!anyChildVisible(entityNode)) {
-                    return false;
+                if (!entityNode->entity().pointEntity()) {
+                    if (!anyChildVisible(entityNode)) {
+                        return false;
+                    }
+                    return true;
                 }
-                return true;
-            }
 
-            if (!entityNode->visible()) {
-                return false;
-            }
+                if (!entityNode->visible()) {
+                    return false;
+                }
 
-            if (entityNode->entity().pointEntity() && !pref(Preferences::ShowPointEntities)) {
-                return false;
-            }
+                if (entityNode->entity().pointEntity() && !pref(Preferences::ShowPointEntities)) {
+                    return false;
+                }
 
-            if (entityDefinitionHidden(entityNode)) {
-                return false;
-            }
+                if (entityDefinitionHidden(entityNode)) {
+                    return false;
+                }
 
-            return true;
+                return true;
+            });
         }
 
         bool EditorContext::visible(const Model::BrushNode* brushNode) const {
-            if (brushNode->selected()) {
-                return true;
-            }
+            return cachedVisible(brushNode, [&]() {
+                if (brushNode->selected()) {
+                    return true;
+                }
 
-            if (!pref(Preferences::ShowBrushes)) {
-                return false;
-            }
+                if (!pref(Preferences::ShowBrushes)) {
+                    return false;
+                }
 
-            if (brushNode->hasTag(m_hiddenTags)) {
-                return false;
-            }
+                if (brushNode->hasTag(m_hiddenTags)) {
+                    return false;
+                }
 
-            if (brushNode->allFacesHaveAnyTagInMask(m_hiddenTags)) {
-                return false;
-            }
+                if (brushNode->allFacesHaveAnyTagInMask(m_hiddenTags)) {
+                    return false;
+                }
 
-            if (entityDefinitionHidden(brushNode->entity())) {
-                return false;
-            }
+                if (entityDefinitionHidden(brushNode->entity())) {
+                    return false;
+                }
 
-            return brushNode->visible();
+                return brushNode->visible();
+            });
         }
 
         bool EditorContext::visible(const Model::BrushNode* brushNode, const Model::BrushFace& face) const {
@@ -195,6 +230,16 @@ namespace TrenchBroom {
             return std::any_of(std::begin(children), std::end(children), [this](const Node* child) { return visible(child); });
         }
 
+        void EditorContext::invalidateCachedVisibility() {
+            m_generation = nextGeneration();
+        }
+
+        void EditorContext::preferenceDidChange(const IO::Path& path) {
+            if (path == Preferences::ShowBrushes.path() || path == Preferences::ShowPointEntities.path()) {
+                invalidateCachedVisibility();
+            }
+        }
+
         bool EditorContext::editable(const Model::Node* node) const {
             return node->editable();
         }
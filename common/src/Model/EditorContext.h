@@ -29,6 +29,10 @@ namespace TrenchBroom {
         class EntityDefinition;
     }
 
+    namespace IO {
+        class Path;
+    }
+
     namespace Model {
         class EntityNodeBase;
         class BrushNode;
@@ -40,6 +44,14 @@ namespace TrenchBroom {
         class Object;
         class WorldNode;
 
+        /**
+         * Decides which nodes are visible, editable, pickable and selectable in the editor.
+         *
+         * The visibility of a node is cached in the node. The cached visibility is only valid for the current
+         * generation of this editor context, which changes whenever the hidden tags, the hidden entity definitions or
+         * the preferences change. In addition, the nodes invalidate their cached visibility when their selection or
+         * visibility state, their tags, their contents or their children change.
+         */
         class EditorContext {
         private:
             TagType::Type m_hiddenTags;
@@ -48,10 +60,13 @@ namespace TrenchBroom {
             bool m_blockSelection;
 
             Model::GroupNode* m_currentGroup;
+
+            size_t m_generation;
         public:
             Notifier<> editorContextDidChangeNotifier;
         public:
             EditorContext();
+            ~EditorContext();
 
             void reset();
 
@@ -77,7 +92,11 @@ namespace TrenchBroom {
             bool visible(const Model::BrushNode* brushNode) const;
             bool visible(const Model::BrushNode* brushNode, const Model::BrushFace& face) const;
         private:
+            template <typename F>
+            bool cachedVisible(const Model::Node* node, const F& computeVisible) const;
             bool anyChildVisible(const Model::Node* node) const;
+            void invalidateCachedVisibility();
+            void preferenceDidChange(const IO::Path& path);
 
         public:
             bool editable(const Model::Node* node) const;
@@ -36,11 +36,37 @@
 #include <vecmath/vec_io.h>
 
 #include <algorithm>
+#include <array>
+#include <iterator>
+#include <optional>
+#include <tuple>
 
 namespace TrenchBroom {
     namespace Model {
         const vm::bbox3 Entity::DefaultBounds = vm::bbox3(8.0);
 
+        /**
+         * The keys whose property positions are indexed by Entity. These are the keys that are looked up most
+         * frequently, i.e. when resolving entity definitions, models and links.
+         */
+        static const std::array<const std::string*, 6u> WellKnownPropertyKeys = {
+            &PropertyKeys::Classname,
+            &PropertyKeys::Origin,
+            &PropertyKeys::Spawnflags,
+            &PropertyKeys::Target,
+            &PropertyKeys::Targetname,
+            &PropertyKeys::Killtarget,
+        };
+
+        static std::optional<size_t> wellKnownPropertyKeySlot(const std::string& key) {
+            for (size_t i = 0u; i < WellKnownPropertyKeys.size(); ++i) {
+                if (&key == WellKnownPropertyKeys[i]) {
+                    return i;
+                }
+            }
+            return std::nullopt;
+        }
+
         Entity::Entity() :
         m_pointEntity(true),
         m_model(nullptr) {}
@@ -70,6 +96,7 @@ namespace TrenchBroom {
         void Entity::setProperties(std::vector<EntityProperty> properties) {
             m_properties = std::move(properties);
             invalidateCachedProperties();
+            invalidateWellKnownPropertyIndices();
         }
 
         bool Entity::pointEntity() const {
@@ -140,6 +167,7 @@ namespace TrenchBroom {
                 it->setValue(value);
             } else {
                 m_properties.emplace_back(key, value);
+                invalidateWellKnownPropertyIndices();
             }
             invalidateCachedProperties();
         }
@@ -158,6 +186,7 @@ namespace TrenchBroom {
 
                 oldIt->setKey(std::move(newKey));
                 invalidateCachedProperties();
+                invalidateWellKnownPropertyIndices();
             }
         }
 
@@ -166,6 +195,7 @@ namespace TrenchBroom {
             if (it != std::end(m_properties)) {
                 m_properties.erase(it);
                 invalidateCachedProperties();
+                invalidateWellKnownPropertyIndices();
             }
         }
 
@@ -179,6 +209,7 @@ namespace TrenchBroom {
                 }
             }
             invalidateCachedProperties();
+            invalidateWellKnownPropertyIndices();
         }
 
         bool Entity::hasProperty(const std::string& key) const {
@@ -291,12 +322,52 @@ namespace TrenchBroom {
             }
         }
 
+        void Entity::invalidateWellKnownPropertyIndices() {
+            m_wellKnownPropertyIndices = std::nullopt;
+        }
+
+        const Entity::WellKnownPropertyIndices& Entity::validateWellKnownPropertyIndices() const {
+            static_assert(std::tuple_size_v<decltype(WellKnownPropertyKeys)> == WellKnownPropertyKeyCount);
+
+            if (!m_wellKnownPropertyIndices.has_value()) {
+                auto indices = WellKnownPropertyIndices{};
+                indices.fill(m_properties.size());
+
+                for (size_t i = 0u; i < m_properties.size(); ++i) {
+                    const auto& key = m_properties[i].key();
+                    for (size_t j = 0u; j < WellKnownPropertyKeys.size(); ++j) {
+                        // if a key is duplicated, its first occurrence is found, like the linear search does
+                        if (indices[j] == m_properties.size() && key == *WellKnownPropertyKeys[j]) {
+                            indices[j] = i;
+                            break;
+                        }
+                    }
+                }
+
+                m_wellKnownPropertyIndices = indices;
+            }
+            return *m_wellKnownPropertyIndices;
+        }
+
+        size_t Entity::findPropertyIndex(const std::string& key) const {
+            if (const auto slot = wellKnownPropertyKeySlot(key)) {
+                return validateWellKnownPropertyIndices()[*slot];
+            }
+
+            for (size_t i = 0u; i < m_properties.size(); ++i) {
+                if (m_properties[i].hasKey(key)) {
+                    return i;
+                }
+            }
+            return m_properties.size();
+        }
+
         std::vector<EntityProperty>::const_iterator Entity::findProperty(const std::string& key) const {
-            return std::find_if(std::begin(m_properties), std::end(m_properties), [&](const auto& property) { return property.hasKey(key); });
+            return std::next(std::begin(m_properties), static_cast<std::ptrdiff_t>(findPropertyIndex(key)));
         }
 
         std::vector<EntityProperty>::iterator Entity::findProperty(const std::string& key) {
-            return std::find_if(std::begin(m_properties), std::end(m_properties), [&](const auto& property) { return property.hasKey(key); });
+            return std::next(std::begin(m_properties), static_cast<std::ptrdiff_t>(findPropertyIndex(key)));
         }
 
         bool operator==(const Entity& lhs, const Entity& rhs) {
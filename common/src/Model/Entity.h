@@ -27,6 +27,7 @@
 #include <vecmath/mat.h>
 #include <vecmath/vec.h>
 
+#include <array>
 #include <optional>
 
 namespace TrenchBroom {
@@ -79,6 +80,23 @@ namespace TrenchBroom {
             };
 
             mutable std::optional<CachedProperties> m_cachedProperties;
+
+            /**
+             * The number of well known property keys for which the positions in m_properties are indexed, see
+             * WellKnownPropertyKeys in Entity.cpp.
+             */
+            static constexpr size_t WellKnownPropertyKeyCount = 6u;
+
+            /**
+             * Maps the well known property keys to the indices of the corresponding properties in m_properties, or
+             * to m_properties.size() if the entity doesn't have such a property. The index is built lazily when a
+             * well known property is looked up and it is invalidated whenever the properties are changed.
+             *
+             * Well known keys are only recognized by identity, i.e., only lookups which pass one of the constants in
+             * PropertyKeys use the index. All other lookups fall back to a linear search.
+             */
+            using WellKnownPropertyIndices = std::array<size_t, WellKnownPropertyKeyCount>;
+            mutable std::optional<WellKnownPropertyIndices> m_wellKnownPropertyIndices;
         public:
             Entity();
             explicit Entity(std::vector<EntityProperty> properties);
@@ -142,6 +160,10 @@ namespace TrenchBroom {
             void invalidateCachedProperties();
             void validateCachedProperties() const;
 
+            void invalidateWellKnownPropertyIndices();
+            const WellKnownPropertyIndices& validateWellKnownPropertyIndices() const;
+
+            size_t findPropertyIndex(const std::string& key) const;
             std::vector<EntityProperty>::const_iterator findProperty(const std::string& property) const;
             std::vector<EntityProperty>::iterator findProperty(const std::string& property);
         };
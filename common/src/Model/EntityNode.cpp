@@ -19,6 +19,7 @@
 
 #include "EntityNode.h"
 
+#include "ObjectPool.h"
 #include "Assets/EntityDefinition.h"
 #include "Assets/EntityModel.h"
 #include "Model/BrushNode.h"
@@ -49,6 +50,12 @@ namespace TrenchBroom {
         const HitType::Type EntityNode::EntityHitType = HitType::freeType();
         const vm::bbox3 EntityNode::DefaultBounds(8.0);
 
+        static ObjectPool<EntityNode>& entityNodePool() {
+            // the pool is never destroyed because entity nodes may still be deleted during static destruction
+            static auto* pool = new ObjectPool<EntityNode>();
+            return *pool;
+        }
+
         EntityNode::EntityNode() :
             EntityNodeBase(),
             Object() {}
@@ -60,6 +67,22 @@ namespace TrenchBroom {
         EntityNode::EntityNode(std::initializer_list<EntityProperty> properties) :
         EntityNode(Entity(std::move(properties))) {}
 
+        void* EntityNode::operator new(const size_t size) {
+            // subclasses cannot be allocated from the pool
+            if (size != sizeof(EntityNode)) {
+                return ::operator new(size);
+            }
+            return entityNodePool().allocate();
+        }
+
+        void EntityNode::operator delete(void* ptr, const size_t size) {
+            if (size != sizeof(EntityNode)) {
+                ::operator delete(ptr);
+            } else {
+                entityNodePool().deallocate(ptr);
+            }
+        }
+
         FloatType EntityNode::area(vm::axis::type axis) const {
             const vm::vec3 size = physicalBounds().size();
             switch (axis) {
@@ -136,11 +159,6 @@ namespace TrenchBroom {
             invalidateBounds();
         }
 
-        void EntityNode::doChildPhysicalBoundsDidChange() {
-            invalidateBounds();
-            nodePhysicalBoundsDidChange();
-        }
-
         bool EntityNode::doSelectable() const {
             return !hasChildren();
         }
@@ -59,6 +59,13 @@ namespace TrenchBroom {
             explicit EntityNode(Entity entity);
             explicit EntityNode(std::initializer_list<EntityProperty> properties);
 
+            /**
+             * Entity nodes are allocated from a pool, like brush nodes. Like that pool, it never returns its blocks to
+             * the heap.
+             */
+            static void* operator new(size_t size);
+            static void operator delete(void* ptr, size_t size);
+
             FloatType area(vm::axis::type axis) const;
         public: // entity model
             const vm::bbox3& modelBounds() const;
@@ -79,7 +86,6 @@ namespace TrenchBroom {
             void doChildWasRemoved(Node* node) override;
 
             void doNodePhysicalBoundsDidChange() override;
-            void doChildPhysicalBoundsDidChange() override;
 
             bool doSelectable() const override;
 
@@ -27,6 +27,9 @@
 #include <kdl/compact_trie.h>
 #include <kdl/vector_utils.h>
 
+#include <algorithm>
+#include <cassert>
+#include <functional>
 #include <iterator>
 #include <list>
 #include <string>
@@ -104,7 +107,8 @@ namespace TrenchBroom {
 
         EntityNodeIndex::EntityNodeIndex() :
             m_keyIndex(std::make_unique<EntityNodeStringIndex>()),
-            m_valueIndex(std::make_unique<EntityNodeStringIndex>()) {}
+            m_valueIndex(std::make_unique<EntityNodeStringIndex>()),
+            m_batchDepth(0u) {}
 
         EntityNodeIndex::~EntityNodeIndex() = default;
 
@@ -119,16 +123,99 @@ namespace TrenchBroom {
         }
 
         void EntityNodeIndex::addProperty(EntityNodeBase* node, const std::string& key, const std::string& value) {
-            m_keyIndex->insert(key, node);
-            m_valueIndex->insert(value, node);
+            if (m_batchDepth > 0u) {
+                m_pendingKeyUpdates[key].emplace_back(node, 1);
+                m_pendingValueUpdates[value].emplace_back(node, 1);
+            } else {
+                m_keyIndex->insert(key, node);
+                m_valueIndex->insert(value, node);
+            }
         }
 
         void EntityNodeIndex::removeProperty(EntityNodeBase* node, const std::string& key, const std::string& value) {
-            m_keyIndex->remove(key, node);
-            m_valueIndex->remove(value, node);
+            if (m_batchDepth > 0u) {
+                m_pendingKeyUpdates[key].emplace_back(node, -1);
+                m_pendingValueUpdates[value].emplace_back(node, -1);
+            } else {
+                m_keyIndex->remove(key, node);
+                m_valueIndex->remove(value, node);
+            }
+        }
+
+        void EntityNodeIndex::beginBatch() {
+            ++m_batchDepth;
+        }
+
+        void EntityNodeIndex::endBatch() {
+            assert(m_batchDepth > 0u);
+            if (--m_batchDepth == 0u) {
+                applyPendingKeyUpdates();
+                applyPendingValueUpdates();
+            }
+        }
+
+        /**
+         * Applies the given pending changes of the nodes indexed under the given string. The changes are summed up for
+         * each node first so that additions and removals which cancel each other out don't touch the index at all.
+         */
+        static void applyPendingUpdates(EntityNodeStringIndex& index, const std::string& str, std::vector<std::pair<EntityNodeBase*, int>>& updates) {
+            std::sort(std::begin(updates), std::end(updates), [](const auto& lhs, const auto& rhs) { return std::less<EntityNodeBase*>()(lhs.first, rhs.first); });
+
+            std::vector<EntityNodeBase*> nodesToRemove;
+            std::vector<EntityNodeBase*> nodesToAdd;
+
+            auto it = std::begin(updates);
+            while (it != std::end(updates)) {
+                auto* node = it->first;
+                int delta = 0;
+                while (it != std::end(updates) && it->first == node) {
+                    delta += it->second;
+                    ++it;
+                }
+
+                for (; delta < 0; ++delta) {
+                    nodesToRemove.push_back(node);
+                }
+                for (; delta > 0; --delta) {
+                    nodesToAdd.push_back(node);
+                }
+            }
+
+            index.remove(str, std::begin(nodesToRemove), std::end(nodesToRemove));
+            index.insert(str, std::begin(nodesToAdd), std::end(nodesToAdd));
+        }
+
+        void EntityNodeIndex::applyPendingKeyUpdates() const {
+            for (auto& [key, updates] : m_pendingKeyUpdates) {
+                applyPendingUpdates(*m_keyIndex, key, updates);
+            }
+            m_pendingKeyUpdates.clear();
+        }
+
+        void EntityNodeIndex::applyPendingValueUpdates() const {
+            for (auto& [value, updates] : m_pendingValueUpdates) {
+                applyPendingUpdates(*m_valueIndex, value, updates);
+            }
+            m_pendingValueUpdates.clear();
+        }
+
+        void EntityNodeIndex::applyPendingValueUpdates(const std::string& value) const {
+            const auto it = m_pendingValueUpdates.find(value);
+            if (it != std::end(m_pendingValueUpdates)) {
+                applyPendingUpdates(*m_valueIndex, it->first, it->second);
+                m_pendingValueUpdates.erase(it);
+            }
         }
 
         std::vector<EntityNodeBase*> EntityNodeIndex::findEntityNodes(const EntityNodeIndexQuery& keyQuery, const std::string& value) const {
+            // `value` is a pattern for the value index, so if it contains wildcards or escaped characters, it can
+            // match pending changes for other values, otherwise only the pending changes for `value` are relevant
+            if (value.find_first_of("*?%\\") != std::string::npos) {
+                applyPendingValueUpdates();
+            } else {
+                applyPendingValueUpdates(value);
+            }
+
             // first, find Nodes which have `value` as the value for any key
             std::vector<EntityNodeBase*> result;
             m_valueIndex->find_matches(value, std::back_inserter(result));
@@ -152,12 +239,16 @@ namespace TrenchBroom {
         }
 
         std::vector<std::string> EntityNodeIndex::allKeys() const {
+            applyPendingKeyUpdates();
+
             std::vector<std::string> result;
             m_keyIndex->get_keys(std::back_inserter(result));
             return result;
         }
 
         std::vector<std::string> EntityNodeIndex::allValuesForKeys(const EntityNodeIndexQuery& keyQuery) const {
+            applyPendingKeyUpdates();
+
             std::vector<std::string> result;
 
             const std::set<EntityNodeBase*> nameResult = keyQuery.execute(*m_keyIndex);
@@ -170,5 +261,14 @@ namespace TrenchBroom {
 
             return result;
         }
+
+        EntityNodeIndexBatch::EntityNodeIndexBatch(EntityNodeIndex& index) :
+        m_index(index) {
+            m_index.beginBatch();
+        }
+
+        EntityNodeIndexBatch::~EntityNodeIndexBatch() {
+            m_index.endBatch();
+        }
     }
 }
@@ -19,11 +19,15 @@
 
 #pragma once
 
+#include "Macros.h"
+
 #include <kdl/compact_trie_forward.h>
 
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom {
@@ -57,10 +61,33 @@ namespace TrenchBroom {
             explicit EntityNodeIndexQuery(Type type, const std::string& pattern = "");
         };
 
+        /**
+         * Indexes entity nodes by the keys and values of their properties.
+         *
+         * Updates can be batched by calling beginBatch and endBatch. While a batch is open, added and removed
+         * properties are not inserted into the underlying tries immediately. Instead, the changes are recorded per key
+         * and per value, changes that cancel each other out (e.g., when a property is removed and added again) are
+         * dropped, and the remaining changes for each key and value are applied at once. This avoids looking up the
+         * same trie nodes over and over again when many entities are added or changed at once, e.g. when a map is
+         * loaded or when a property is changed for many entities.
+         *
+         * Queries are always answered with the current state of the index: a query applies the pending changes it
+         * depends on before it is executed.
+         */
         class EntityNodeIndex {
         private:
+            /**
+             * Maps a key or value to the pending changes of the nodes indexed under it. Each change is a pair of a
+             * node and +1 for an addition or -1 for a removal.
+             */
+            using PendingUpdates = std::unordered_map<std::string, std::vector<std::pair<EntityNodeBase*, int>>>;
+
             std::unique_ptr<EntityNodeStringIndex> m_keyIndex;
             std::unique_ptr<EntityNodeStringIndex> m_valueIndex;
+
+            size_t m_batchDepth;
+            mutable PendingUpdates m_pendingKeyUpdates;
+            mutable PendingUpdates m_pendingValueUpdates;
         public:
             EntityNodeIndex();
             ~EntityNodeIndex();
@@ -71,9 +98,37 @@ namespace TrenchBroom {
             void addProperty(EntityNodeBase* node, const std::string& key, const std::string& value);
             void removeProperty(EntityNodeBase* node, const std::string& key, const std::string& value);
 
+            /**
+             * Opens a batch. Batches can be nested, and the pending changes are applied when the outermost batch is
+             * closed.
+             */
+            void beginBatch();
+
+            /**
+             * Closes a batch. If this closes the outermost batch, all pending changes are applied.
+             */
+            void endBatch();
+
             std::vector<EntityNodeBase*> findEntityNodes(const EntityNodeIndexQuery& keyQuery, const std::string& value) const;
             std::vector<std::string> allKeys() const;
             std::vector<std::string> allValuesForKeys(const EntityNodeIndexQuery& keyQuery) const;
+        private:
+            void applyPendingKeyUpdates() const;
+            void applyPendingValueUpdates() const;
+            void applyPendingValueUpdates(const std::string& value) const;
+        };
+
+        /**
+         * Opens a batch on the given index for the lifetime of this object.
+         */
+        class EntityNodeIndexBatch {
+        private:
+            EntityNodeIndex& m_index;
+        public:
+            explicit EntityNodeIndexBatch(EntityNodeIndex& index);
+            ~EntityNodeIndexBatch();
+
+            deleteCopyAndMove(EntityNodeIndexBatch)
         };
     }
 }
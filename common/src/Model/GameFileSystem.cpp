@@ -31,10 +31,12 @@
 #include "IO/ZipFileSystem.h"
 #include "Model/GameConfig.h"
 
+#include <kdl/parallel.h>
 #include <kdl/string_compare.h>
 #include <kdl/vector_utils.h>
 
 #include <memory>
+#include <string>
 
 namespace TrenchBroom {
     namespace Model {
@@ -106,6 +108,22 @@ namespace TrenchBroom {
             }
         }
 
+        struct PackageFileSystem {
+            std::shared_ptr<IO::FileSystem> fileSystem;
+            std::string error;
+        };
+
+        static std::shared_ptr<IO::FileSystem> createPackageFileSystem(const std::string& packageFormat, const IO::Path& packagePath) {
+            if (kdl::ci::str_is_equal(packageFormat, "idpak")) {
+                return std::make_shared<IO::IdPakFileSystem>(packagePath);
+            } else if (kdl::ci::str_is_equal(packageFormat, "dkpak")) {
+                return std::make_shared<IO::DkPakFileSystem>(packagePath);
+            } else if (kdl::ci::str_is_equal(packageFormat, "zip")) {
+                return std::make_shared<IO::ZipFileSystem>(packagePath);
+            }
+            return nullptr;
+        }
+
         void GameFileSystem::addFileSystemPackages(const GameConfig& config, const IO::Path& searchPath, Logger& logger) {
             const auto& fileSystemConfig = config.fileSystemConfig();
             const auto& packageFormatConfig = fileSystemConfig.packageFormat;
@@ -118,20 +136,31 @@ namespace TrenchBroom {
                 auto packages = diskFS.findItems(IO::Path(""), IO::FileExtensionMatcher(packageExtensions));
                 packages = kdl::vec_sort(std::move(packages), IO::Path::Less<kdl::ci::string_less>());
 
-                for (const auto& packagePath : packages) {
+                // reading the package directories is the expensive part, so we do it concurrently
+                auto packageFileSystems = kdl::vec_parallel_transform(packages, [&](IO::Path&& packagePath) {
+                    PackageFileSystem result;
                     try {
-                        if (kdl::ci::str_is_equal(packageFormat, "idpak")) {
-                            logger.info() << "Adding file system package " << packagePath;
-                            m_next = std::make_shared<IO::IdPakFileSystem>(m_next, diskFS.makeAbsolute(packagePath));
-                        } else if (kdl::ci::str_is_equal(packageFormat, "dkpak")) {
-                            logger.info() << "Adding file system package " << packagePath;
-                            m_next = std::make_shared<IO::DkPakFileSystem>(m_next, diskFS.makeAbsolute(packagePath));
-                        } else if (kdl::ci::str_is_equal(packageFormat, "zip")) {
-                            logger.info() << "Adding file system package " << packagePath;
-                            m_next = std::make_shared<IO::ZipFileSystem>(m_next, diskFS.makeAbsolute(packagePath));
-                        }
+                        result.fileSystem = createPackageFileSystem(packageFormat, diskFS.makeAbsolute(packagePath));
                     } catch (const std::exception& e) {
-                        logger.error() << e.what();
+                        result.error = e.what();
+                    }
+                    return result;
+                });
+
+                // the packages are chained in order, so that later packages take precedence over earlier ones
+                for (size_t i = 0; i < packages.size(); ++i) {
+                    auto& [fileSystem, error] = packageFileSystems[i];
+                    if (fileSystem == nullptr && error.empty()) {
+                        // unknown package format
+                        continue;
+                    }
+
+                    logger.info() << "Adding file system package " << packages[i];
+                    if (fileSystem != nullptr) {
+                        fileSystem->setNext(std::move(m_next));
+                        m_next = std::move(fileSystem);
+                    } else {
+                        logger.error() << error;
                     }
                 }
             }
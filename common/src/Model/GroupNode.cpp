@@ -165,11 +165,6 @@ namespace TrenchBroom {
             invalidateBounds();
         }
 
-        void GroupNode::doChildPhysicalBoundsDidChange() {
-            invalidateBounds();
-            nodePhysicalBoundsDidChange();
-        }
-
         bool GroupNode::doSelectable() const {
             return true;
         }
@@ -92,7 +92,6 @@ namespace TrenchBroom {
             void doChildWasRemoved(Node* node) override;
 
             void doNodePhysicalBoundsDidChange() override;
-            void doChildPhysicalBoundsDidChange() override;
 
             bool doSelectable() const override;
 
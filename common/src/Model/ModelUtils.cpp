@@ -24,16 +24,21 @@
 #include "Model/Brush.h"
 #include "Model/BrushFace.h"
 #include "Model/BrushFaceHandle.h"
+#include "Model/BrushGeometry.h"
 #include "Model/BrushNode.h"
 #include "Model/EditorContext.h"
 #include "Model/EntityNode.h"
+#include "Model/EntityProperties.h"
 #include "Model/GroupNode.h"
 #include "Model/LayerNode.h"
+#include "Model/NodeContents.h"
 #include "Model/WorldNode.h"
 
 #include <kdl/overload.h>
 #include <kdl/vector_utils.h>
 
+#include <algorithm>
+#include <variant>
 #include <vector>
 
 namespace TrenchBroom {
@@ -368,5 +373,63 @@ namespace TrenchBroom {
                  }
             ));
         }
+
+        size_t estimateMemorySize(const Entity& entity) {
+            size_t result = sizeof(Entity);
+            for (const auto& property : entity.properties()) {
+                result += sizeof(EntityProperty) + property.key().capacity() + property.value().capacity();
+            }
+            return result;
+        }
+
+        size_t estimateMemorySize(const Brush& brush) {
+            size_t result = sizeof(Brush);
+            for (const auto& face : brush.faces()) {
+                result += sizeof(BrushFace) + face.attributes().textureName().capacity();
+            }
+
+            // every edge consists of two half edges, and every face of the geometry belongs to a brush face
+            auto geometrySize = brush.vertexCount() * sizeof(BrushVertex);
+            geometrySize += brush.edgeCount() * (sizeof(BrushEdge) + 2u * sizeof(BrushHalfEdge));
+            geometrySize += brush.faceCount() * sizeof(BrushFaceGeometry);
+
+            // the geometry is shared by copies of a brush, so each of them only accounts for its share
+            return result + geometrySize / std::max(brush.geometryShareCount(), size_t(1u));
+        }
+
+        size_t estimateMemorySize(const NodeContents& contents) {
+            return std::visit(kdl::overload(
+                [](const Layer& layer) { return sizeof(Layer) + layer.name().capacity(); },
+                [](const Group& group) { return sizeof(Group) + group.name().capacity(); },
+                [](const Entity& entity) { return estimateMemorySize(entity); },
+                [](const Brush& brush) { return estimateMemorySize(brush); }
+            ), contents.get());
+        }
+
+        size_t estimateMemorySize(const Node* node) {
+            size_t result = 0u;
+            node->accept(kdl::overload(
+                [&](auto&& thisLambda, const WorldNode* world) {
+                    result += sizeof(WorldNode) + estimateMemorySize(world->entity());
+                    world->visitChildren(thisLambda);
+                },
+                [&](auto&& thisLambda, const LayerNode* layer) {
+                    result += sizeof(LayerNode) + layer->layer().name().capacity();
+                    layer->visitChildren(thisLambda);
+                },
+                [&](auto&& thisLambda, const GroupNode* group) {
+                    result += sizeof(GroupNode) + group->group().name().capacity();
+                    group->visitChildren(thisLambda);
+                },
+                [&](auto&& thisLambda, const EntityNode* entity) {
+                    result += sizeof(EntityNode) + estimateMemorySize(entity->entity());
+                    entity->visitChildren(thisLambda);
+                },
+                [&](const BrushNode* brush) {
+                    result += sizeof(BrushNode) + estimateMemorySize(brush->brush());
+                }
+            ));
+            return result;
+        }
     }
 }
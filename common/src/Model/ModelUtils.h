@@ -29,10 +29,13 @@
 
 namespace TrenchBroom {
     namespace Model {
+        class Brush;
         class BrushFaceHandle;
         class EditorContext;
+        class Entity;
         class LayerNode;
         class Node;
+        class NodeContents;
 
         LayerNode* findContainingLayer(Node* node);
 
@@ -71,6 +74,18 @@ namespace TrenchBroom {
         bool boundsContainNode(const vm::bbox3& bounds, const Node* node);
         bool boundsIntersectNode(const vm::bbox3& bounds, const Node* node);
 
+        /**
+         * Returns an estimate of the number of bytes held by the given object. The estimates are used to limit the
+         * memory held by the undo stack and need not be exact.
+         */
+        size_t estimateMemorySize(const Entity& entity);
+        size_t estimateMemorySize(const Brush& brush);
+        size_t estimateMemorySize(const NodeContents& contents);
+
+        /**
+         * Returns an estimate of the number of bytes held by the given node and its descendants.
+         */
+        size_t estimateMemorySize(const Node* node);
     }
 }
 
@@ -32,6 +32,8 @@
 
 #include <cassert>
 #include <iterator>
+#include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -40,15 +42,17 @@ namespace TrenchBroom {
         Node::Node() :
         m_parent(nullptr),
         m_descendantCount(0),
-        m_selected(false),
         m_childSelectionCount(0),
         m_descendantSelectionCount(0),
         m_visibilityState(VisibilityState::Visibility_Inherited),
         m_lockState(LockState::Lock_Inherited),
         m_lineNumber(0),
         m_lineCount(0),
+        m_hiddenIssues(0),
+        m_cachedVisibilityGeneration(0u),
+        m_selected(false),
         m_issuesValid(false),
-        m_hiddenIssues(0) {}
+        m_cachedVisibility(false) {}
 
         Node::~Node() {
             clearChildren();
@@ -140,16 +144,19 @@ namespace TrenchBroom {
             return doRemoveIfEmpty();
         }
 
+        static const std::vector<Node*> EmptyChildren;
+        static const std::vector<Issue*> EmptyIssues;
+
         bool Node::hasChildren() const {
-            return !m_children.empty();
+            return m_children != nullptr && !m_children->empty();
         }
 
         size_t Node::childCount() const {
-            return m_children.size();
+            return m_children != nullptr ? m_children->size() : 0u;
         }
 
         const std::vector<Node*>& Node::children() const {
-            return m_children;
+            return m_children != nullptr ? *m_children : EmptyChildren;
         }
 
         size_t Node::descendantCount() const {
@@ -192,15 +199,23 @@ namespace TrenchBroom {
             return doCanRemoveChild(child);
         }
 
+        std::vector<Node*>& Node::mutableChildren() {
+            // the vector is kept once it was created to avoid reallocating it when children are moved around
+            if (m_children == nullptr) {
+                m_children = std::make_unique<std::vector<Node*>>();
+            }
+            return *m_children;
+        }
+
         void Node::doAddChild(Node* child) {
             ensure(child != nullptr, "child is null");
-            assert(!kdl::vec_contains(m_children, child));
+            assert(!kdl::vec_contains(children(), child));
             assert(child->parent() == nullptr);
             assert(canAddChild(child));
 
             childWillBeAdded(child);
             // nodeWillChange();
-            m_children.push_back(child);
+            mutableChildren().push_back(child);
             child->setParent(this);
             childWasAdded(child);
             // nodeDidChange();
@@ -214,13 +229,15 @@ namespace TrenchBroom {
             childWillBeRemoved(child);
             // nodeWillChange();
             child->setParent(nullptr);
-            m_children = kdl::vec_erase(std::move(m_children), child);
+            *m_children = kdl::vec_erase(std::move(*m_children), child);
             childWasRemoved(child);
             // nodeDidChange();
         }
 
         void Node::clearChildren() {
-            kdl::vec_clear_and_delete(m_children);
+            if (m_children != nullptr) {
+                kdl::vec_clear_and_delete(*m_children);
+            }
         }
 
         void Node::childWillBeAdded(Node* node) {
@@ -231,6 +248,7 @@ namespace TrenchBroom {
         void Node::childWasAdded(Node* node) {
             doChildWasAdded(node);
             descendantWasAdded(node, 1);
+            invalidateCachedVisibility();
         }
 
         void Node::childWillBeRemoved(Node* node) {
@@ -241,6 +259,7 @@ namespace TrenchBroom {
         void Node::childWasRemoved(Node* node) {
             doChildWasRemoved(node);
             descendantWasRemoved(this, node, 1);
+            invalidateCachedVisibility();
         }
 
         void Node::descendantWillBeAdded(Node* newParent, Node* node, const size_t depth) {
@@ -309,7 +328,7 @@ namespace TrenchBroom {
 
         void Node::ancestorWillChange() {
             doAncestorWillChange();
-            for (auto* child : m_children) {
+            for (auto* child : children()) {
                 child->ancestorWillChange();
             }
             invalidateIssues();
@@ -317,10 +336,11 @@ namespace TrenchBroom {
 
         void Node::ancestorDidChange() {
             doAncestorDidChange();
-            for (auto* child : m_children) {
+            for (auto* child : children()) {
                 child->ancestorDidChange();
             }
             invalidateIssues();
+            m_cachedVisibilityGeneration = 0u;
         }
 
         void Node::nodeWillChange() {
@@ -333,6 +353,8 @@ namespace TrenchBroom {
             if (m_parent != nullptr)
                 m_parent->childDidChange(this);
             invalidateIssues();
+            // the visibility of the children of an entity depends on its definition
+            invalidateCachedVisibility(true);
         }
 
         Node::NotifyNodeChange::NotifyNodeChange(Node* node) :
@@ -387,6 +409,7 @@ namespace TrenchBroom {
         }
 
         void Node::childPhysicalBoundsDidChange(Node* node) {
+            // this notifies our ancestors, so overrides of doChildPhysicalBoundsDidChange must not do it again
             nodePhysicalBoundsDidChange();
             doChildPhysicalBoundsDidChange();
             descendantPhysicalBoundsDidChange(node, 1);
@@ -410,6 +433,7 @@ namespace TrenchBroom {
             m_selected = true;
             if (m_parent != nullptr)
                 m_parent->childWasSelected();
+            invalidateCachedVisibility();
         }
 
         void Node::deselect() {
@@ -419,6 +443,7 @@ namespace TrenchBroom {
             m_selected = false;
             if (m_parent != nullptr)
                 m_parent->childWasDeselected();
+            invalidateCachedVisibility();
         }
 
         bool Node::transitivelySelected() const {
@@ -525,6 +550,7 @@ namespace TrenchBroom {
         bool Node::setVisibilityState(const VisibilityState visibility) {
             if (visibility != m_visibilityState) {
                 m_visibilityState = visibility;
+                invalidateCachedVisibility(true);
                 return true;
             }
             return false;
@@ -565,6 +591,36 @@ namespace TrenchBroom {
 
         }
 
+        std::optional<bool> Node::cachedVisibility(const size_t generation) const {
+            assert(generation > 0u);
+            if (m_cachedVisibilityGeneration == generation) {
+                return m_cachedVisibility;
+            }
+            return std::nullopt;
+        }
+
+        void Node::setCachedVisibility(const size_t generation, const bool visible) const {
+            assert(generation > 0u);
+            m_cachedVisibilityGeneration = generation;
+            m_cachedVisibility = visible;
+        }
+
+        void Node::invalidateCachedVisibility(const bool includeDescendants) {
+            for (auto* node = this; node != nullptr; node = node->m_parent) {
+                node->m_cachedVisibilityGeneration = 0u;
+            }
+            if (includeDescendants) {
+                invalidateCachedDescendantVisibility();
+            }
+        }
+
+        void Node::invalidateCachedDescendantVisibility() {
+            for (auto* child : children()) {
+                child->m_cachedVisibilityGeneration = 0u;
+                child->invalidateCachedDescendantVisibility();
+            }
+        }
+
         void Node::pick(const vm::ray3& ray, PickResult& pickResult) {
             doPick(ray, pickResult);
         }
@@ -588,7 +644,7 @@ namespace TrenchBroom {
 
         const std::vector<Issue*>& Node::issues(const std::vector<IssueGenerator*>& issueGenerators) {
             validateIssues(issueGenerators);
-            return m_issues;
+            return m_issues != nullptr ? *m_issues : EmptyIssues;
         }
 
         bool Node::issueHidden(const IssueType type) const {
@@ -605,8 +661,12 @@ namespace TrenchBroom {
 
         void Node::validateIssues(const std::vector<IssueGenerator*>& issueGenerators) {
             if (!m_issuesValid) {
+                std::vector<Issue*> issues;
                 for (const auto* generator : issueGenerators) {
-                    doGenerateIssues(generator, m_issues);
+                    doGenerateIssues(generator, issues);
+                }
+                if (!issues.empty()) {
+                    m_issues = std::make_unique<std::vector<Issue*>>(std::move(issues));
                 }
                 m_issuesValid = true;
             }
@@ -618,7 +678,10 @@ namespace TrenchBroom {
         }
 
         void Node::clearIssues() const {
-            kdl::vec_clear_and_delete(m_issues);
+            if (m_issues != nullptr) {
+                kdl::vec_clear_and_delete(*m_issues);
+                m_issues.reset();
+            }
         }
 
         void Node::findEntityNodesWithProperty(const std::string& key, const std::string& value, std::vector<EntityNodeBase*>& result) const {
@@ -27,6 +27,8 @@
 #include <vecmath/forward.h>
 #include <vecmath/bbox.h>
 
+#include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -44,9 +46,12 @@ namespace TrenchBroom {
         class Node : public Taggable {
         private:
             Node* m_parent;
-            std::vector<Node*> m_children;
+            /**
+             * Leaf nodes make up most of a map, so the child and issue vectors are only allocated when they are
+             * first needed.
+             */
+            std::unique_ptr<std::vector<Node*>> m_children;
             size_t m_descendantCount;
-            bool m_selected;
 
             size_t m_childSelectionCount;
             size_t m_descendantSelectionCount;
@@ -57,9 +62,19 @@ namespace TrenchBroom {
             mutable size_t m_lineNumber;
             mutable size_t m_lineCount;
 
-            mutable std::vector<Issue*> m_issues;
-            mutable bool m_issuesValid;
+            mutable std::unique_ptr<std::vector<Issue*>> m_issues;
             IssueType m_hiddenIssues;
+
+            /**
+             * The generation of the editor context that cached its visibility of this node, or 0 if the cached
+             * visibility is invalid.
+             */
+            mutable size_t m_cachedVisibilityGeneration;
+
+            // the flags are grouped to avoid padding
+            bool m_selected;
+            mutable bool m_issuesValid;
+            mutable bool m_cachedVisibility;
         protected:
             Node();
         private:
@@ -132,7 +147,10 @@ namespace TrenchBroom {
 
             template <typename I>
             void addChildren(I cur, I end, size_t count = 0) {
-                m_children.reserve(m_children.size() + count);
+                if (count > 0u) {
+                    auto& children = mutableChildren();
+                    children.reserve(children.size() + count);
+                }
                 size_t descendantCountDelta = 0;
                 while (cur != end) {
                     Node* child = *cur;
@@ -180,6 +198,8 @@ namespace TrenchBroom {
                 return true;
             }
         private:
+            std::vector<Node*>& mutableChildren();
+
             void doAddChild(Node* child);
             void doRemoveChild(Node* child);
             void clearChildren();
@@ -283,6 +303,22 @@ namespace TrenchBroom {
             bool locked() const;
             LockState lockState() const;
             bool setLockState(LockState lockState);
+        public: // visibility cache, see EditorContext
+            /**
+             * Returns the visibility of this node that was cached by the editor context with the given
+             * generation, or nothing if no visibility was cached for that generation or if it was invalidated.
+             */
+            std::optional<bool> cachedVisibility(size_t generation) const;
+            void setCachedVisibility(size_t generation, bool visible) const;
+        protected:
+            /**
+             * Invalidates the cached visibility of this node and its ancestors, since the visibility of groups and
+             * brush entities depends on that of their children. The cached visibility of the descendants is
+             * invalidated too if requested, e.g. if they inherit a changed visibility state.
+             */
+            void invalidateCachedVisibility(bool includeDescendants = false);
+        private:
+            void invalidateCachedDescendantVisibility();
         public: // picking
             void pick(const vm::ray3& ray, PickResult& result);
             void findNodesContaining(const vm::vec3& point, std::vector<Node*>& result);
@@ -393,7 +429,7 @@ namespace TrenchBroom {
              */
             template <typename L>
             void visitChildren(const L& lambda) {
-                visitAll(m_children, lambda);
+                visitAll(children(), lambda);
             }
 
             /**
@@ -401,7 +437,7 @@ namespace TrenchBroom {
              */
             template <typename L>
             void visitChildren(const L& lambda) const {
-                visitAll(m_children, lambda);
+                visitAll(children(), lambda);
             }
         protected: // index management
             void findEntityNodesWithProperty(const std::string& key, const std::string& value, std::vector<EntityNodeBase*>& result) const;
@@ -73,13 +73,9 @@ namespace TrenchBroom {
         m_xAxis(xAxis),
         m_yAxis(yAxis) {}
 
-        std::tuple<std::unique_ptr<TexCoordSystem>, BrushFaceAttributes> ParallelTexCoordSystem::fromParaxial(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs) {
+        std::tuple<ParallelTexCoordSystem, BrushFaceAttributes> ParallelTexCoordSystem::fromParaxial(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs) {
             const auto tempParaxial = ParaxialTexCoordSystem(point0, point1, point2, attribs);
-            return { ParallelTexCoordSystem(tempParaxial.xAxis(), tempParaxial.yAxis()).clone(), attribs };
-        }
-
-        std::unique_ptr<TexCoordSystem> ParallelTexCoordSystem::doClone() const {
-            return std::make_unique<ParallelTexCoordSystem>(m_xAxis, m_yAxis);
+            return { ParallelTexCoordSystem(tempParaxial.xAxis(), tempParaxial.yAxis()), attribs };
         }
 
         std::unique_ptr<TexCoordSystemSnapshot> ParallelTexCoordSystem::doTakeSnapshot() const {
@@ -125,10 +121,6 @@ namespace TrenchBroom {
             return false;
         }
 
-        vm::vec2f ParallelTexCoordSystem::doGetTexCoords(const vm::vec3& point, const BrushFaceAttributes& attribs, const vm::vec2f& textureSize) const {
-            return (computeTexCoords(point, attribs.scale()) + attribs.offset()) / textureSize;
-        }
-
         /**
          * Rotates from `oldAngle` to `newAngle`. Both of these are in CCW degrees about
          * the texture normal (`getZAxis()`). The provided `normal` is ignored.
@@ -338,11 +330,11 @@ namespace TrenchBroom {
             yAxis = vm::normalize(vm::cross(m_xAxis, normal));
         }
 
-        std::tuple<std::unique_ptr<TexCoordSystem>, BrushFaceAttributes> ParallelTexCoordSystem::doToParallel(const vm::vec3&, const vm::vec3&, const vm::vec3&, const BrushFaceAttributes& attribs) const {
-            return { clone(), attribs };
+        std::tuple<ParallelTexCoordSystem, BrushFaceAttributes> ParallelTexCoordSystem::doToParallel(const vm::vec3&, const vm::vec3&, const vm::vec3&, const BrushFaceAttributes& attribs) const {
+            return { *this, attribs };
         }
 
-        std::tuple<std::unique_ptr<TexCoordSystem>, BrushFaceAttributes> ParallelTexCoordSystem::doToParaxial(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs) const {
+        std::tuple<ParaxialTexCoordSystem, BrushFaceAttributes> ParallelTexCoordSystem::doToParaxial(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs) const {
             return ParaxialTexCoordSystem::fromParallel(point0, point1, point2, attribs, m_xAxis, m_yAxis);
         }
     }
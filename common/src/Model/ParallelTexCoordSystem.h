@@ -54,9 +54,8 @@ namespace TrenchBroom {
             ParallelTexCoordSystem(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs);
             ParallelTexCoordSystem(const vm::vec3& xAxis, const vm::vec3& yAxis);
 
-            static std::tuple<std::unique_ptr<TexCoordSystem>, BrushFaceAttributes> fromParaxial(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs);
+            static std::tuple<ParallelTexCoordSystem, BrushFaceAttributes> fromParaxial(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs);
         private:
-            std::unique_ptr<TexCoordSystem> doClone() const override;
             std::unique_ptr<TexCoordSystemSnapshot> doTakeSnapshot() const override;
             void doRestoreSnapshot(const TexCoordSystemSnapshot& snapshot) override;
 
@@ -70,7 +69,6 @@ namespace TrenchBroom {
             void doResetTextureAxesToParallel(const vm::vec3& normal, float angle) override;
 
             bool isRotationInverted(const vm::vec3& normal) const override;
-            vm::vec2f doGetTexCoords(const vm::vec3& point, const BrushFaceAttributes& attribs, const vm::vec2f& textureSize) const override;
 
             void doSetRotation(const vm::vec3& normal, float oldAngle, float newAngle) override;
             void applyRotation(const vm::vec3& normal, FloatType angle);
@@ -86,10 +84,8 @@ namespace TrenchBroom {
             float doMeasureAngle(float currentAngle, const vm::vec2f& center, const vm::vec2f& point) const override;
             void computeInitialAxes(const vm::vec3& normal, vm::vec3& xAxis, vm::vec3& yAxis) const;
 
-            std::tuple<std::unique_ptr<TexCoordSystem>, BrushFaceAttributes> doToParallel(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs) const override;
-            std::tuple<std::unique_ptr<TexCoordSystem>, BrushFaceAttributes> doToParaxial(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs) const override;
-
-            deleteCopyAndMove(ParallelTexCoordSystem)
+            std::tuple<ParallelTexCoordSystem, BrushFaceAttributes> doToParallel(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs) const override;
+            std::tuple<ParaxialTexCoordSystem, BrushFaceAttributes> doToParaxial(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs) const override;
         };
     }
 }
@@ -90,10 +90,6 @@ namespace TrenchBroom {
             return vm::plane3(point0, normal);
         }
 
-        std::unique_ptr<TexCoordSystem> ParaxialTexCoordSystem::doClone() const {
-            return std::make_unique<ParaxialTexCoordSystem>(m_index, m_xAxis, m_yAxis);
-        }
-
         std::unique_ptr<TexCoordSystemSnapshot> ParaxialTexCoordSystem::doTakeSnapshot() const {
             return std::unique_ptr<TexCoordSystemSnapshot>();
         }
@@ -128,10 +124,6 @@ namespace TrenchBroom {
             return index % 2 == 0;
         }
 
-        vm::vec2f ParaxialTexCoordSystem::doGetTexCoords(const vm::vec3& point, const BrushFaceAttributes& attribs, const vm::vec2f& textureSize) const {
-            return (computeTexCoords(point, attribs.scale()) + attribs.offset()) / textureSize;
-        }
-
         void ParaxialTexCoordSystem::doSetRotation(const vm::vec3& normal, const float /* oldAngle */, const float newAngle) {
             m_index = planeNormalIndex(normal);
             axes(m_index, m_xAxis, m_yAxis);
@@ -263,13 +255,13 @@ namespace TrenchBroom {
             return vm::to_degrees(angleInRadians);
         }
 
-        std::tuple<std::unique_ptr<TexCoordSystem>, BrushFaceAttributes> ParaxialTexCoordSystem::doToParallel(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs) const {
+        std::tuple<ParallelTexCoordSystem, BrushFaceAttributes> ParaxialTexCoordSystem::doToParallel(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs) const {
             return ParallelTexCoordSystem::fromParaxial(point0, point1, point2, attribs);
         }
 
-        std::tuple<std::unique_ptr<TexCoordSystem>, BrushFaceAttributes> ParaxialTexCoordSystem::doToParaxial(const vm::vec3&, const vm::vec3&, const vm::vec3&, const BrushFaceAttributes& attribs) const {
+        std::tuple<ParaxialTexCoordSystem, BrushFaceAttributes> ParaxialTexCoordSystem::doToParaxial(const vm::vec3&, const vm::vec3&, const vm::vec3&, const BrushFaceAttributes& attribs) const {
             // Already in the requested format
-            return { clone(), attribs };
+            return { *this, attribs };
         }
 
         void ParaxialTexCoordSystem::rotateAxes(vm::vec3& xAxis, vm::vec3& yAxis, const FloatType angleInRadians, const size_t planeNormIndex) const {
@@ -610,7 +602,7 @@ namespace TrenchBroom {
             }
         }
 
-        std::tuple<std::unique_ptr<TexCoordSystem>, BrushFaceAttributes> ParaxialTexCoordSystem::fromParallel(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs, const vm::vec3& xAxis, const vm::vec3& yAxis) {
+        std::tuple<ParaxialTexCoordSystem, BrushFaceAttributes> ParaxialTexCoordSystem::fromParallel(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs, const vm::vec3& xAxis, const vm::vec3& yAxis) {
             const vm::plane3 facePlane = planeFromPoints(point0, point1, point2);
             const vm::mat4x4f worldToTexSpace = FromParallel::valveTo4x4Matrix(facePlane, attribs, xAxis, yAxis);
             const auto facePoints = std::array<vm::vec3f, 3>{vm::vec3f(point0), vm::vec3f(point1), vm::vec3f(point2)};
@@ -628,8 +620,7 @@ namespace TrenchBroom {
                 newAttribs.setRotation(0.0f);
             }
 
-            return { std::make_unique<ParaxialTexCoordSystem>(point0, point1, point2, newAttribs),
-                     newAttribs };
+            return { ParaxialTexCoordSystem(point0, point1, point2, newAttribs), newAttribs };
         }
     }
 }
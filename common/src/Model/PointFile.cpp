@@ -25,6 +25,7 @@
 #include <vecmath/vec.h>
 #include <vecmath/vec_io.h>
 
+#include <algorithm>
 #include <cassert>
 #include <fstream>
 #include <string>
@@ -36,7 +37,14 @@ namespace TrenchBroom {
 
         PointFile::PointFile(const IO::Path& path) :
         m_current(0) {
-            load(path);
+            std::atomic<float> progress(0.0f);
+            const std::atomic<bool> cancelled(false);
+            load(path, progress, cancelled);
+        }
+
+        PointFile::PointFile(const IO::Path& path, std::atomic<float>& progress, const std::atomic<bool>& cancelled) :
+        m_current(0) {
+            load(path, progress, cancelled);
         }
 
         bool PointFile::canLoad(const IO::Path& path) {
@@ -84,12 +92,16 @@ namespace TrenchBroom {
             --m_current;
         }
 
-        void PointFile::load(const IO::Path& path) {
+        void PointFile::load(const IO::Path& path, std::atomic<float>& progress, const std::atomic<bool>& cancelled) {
             static const float Threshold = vm::to_radians(15.0f);
 
             std::ifstream stream = openPathAsInputStream(path);
             assert(stream.is_open());
 
+            stream.seekg(0, std::ios::end);
+            const auto size = static_cast<float>(std::max(static_cast<std::streamoff>(stream.tellg()), std::streamoff(1)));
+            stream.seekg(0, std::ios::beg);
+
             std::vector<vm::vec3f> points;
 
             if (!stream.eof()) {
@@ -103,7 +115,12 @@ namespace TrenchBroom {
                     vm::vec3f curPoint = vm::parse<float, 3>(line).value_or(vm::vec3f::zero());
                     vm::vec3f refDir = normalize(curPoint - lastPoint);
 
-                    while (!stream.eof()) {
+                    size_t lineCount = 0u;
+                    while (!stream.eof() && !cancelled) {
+                        if (++lineCount % 4096u == 0u) {
+                            progress = static_cast<float>(static_cast<std::streamoff>(stream.tellg())) / size;
+                        }
+
                         lastPoint = curPoint;
                         std::getline(stream, line);
                         curPoint = vm::parse<float, 3>(line).value_or(vm::vec3f::zero());
@@ -119,6 +136,10 @@ namespace TrenchBroom {
                 }
             }
 
+            if (cancelled) {
+                return;
+            }
+
             if (points.size() > 1) {
                 for (size_t i = 0; i < points.size() - 1; ++i) {
                     const vm::vec3f& curPoint = points[i];
@@ -133,6 +154,8 @@ namespace TrenchBroom {
                 }
                 m_points.push_back(points.back());
             }
+
+            progress = 1.0f;
         }
     }
 }
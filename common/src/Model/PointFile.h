@@ -22,6 +22,7 @@
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
 
+#include <atomic>
 #include <cstddef>
 #include <vector>
 
@@ -39,6 +40,13 @@ namespace TrenchBroom {
             PointFile();
             PointFile(const IO::Path& path);
 
+            /**
+             * Loads the given file, storing the fraction of the file that has been read so far in the given progress
+             * value. If the given cancelled flag is set while the file is loading, loading stops and the point file
+             * remains empty.
+             */
+            PointFile(const IO::Path& path, std::atomic<float>& progress, const std::atomic<bool>& cancelled);
+
             static bool canLoad(const IO::Path& path);
 
             bool empty() const;
@@ -51,7 +59,7 @@ namespace TrenchBroom {
             void advance();
             void retreat();
         private:
-            void load(const IO::Path& path);
+            void load(const IO::Path& path, std::atomic<float>& progress, const std::atomic<bool>& cancelled);
         };
     }
 }
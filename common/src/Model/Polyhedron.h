@@ -1397,7 +1397,7 @@ namespace TrenchBroom {
              * @param maxDistance the maximum distance at which a face is considered
              * @return a face or null if no face satisfies the criteria listed above
              */
-            Face* findClosestFace(const std::vector<vm::vec<T,3>>& positions, T maxDistance = std::numeric_limits<T>::max());
+            Face* findClosestFace(const std::vector<vm::vec<T,3>>& positions, T maxDistance = std::numeric_limits<T>::max()) const;
         private:
             /**
              * Updates the bounds to the smallest bounding box that contains the positions of all vertices of this
@@ -1405,6 +1405,17 @@ namespace TrenchBroom {
              * vectors.
              */
             void updateBounds();
+        public: // Transformation
+            /**
+             * Applies the given transformation to the vertex positions and to the face planes of this polyhedron
+             * without changing its topology. The given transformation must be affine and invertible, and it must
+             * preserve orientation, otherwise the face boundaries would not be counter clockwise anymore.
+             *
+             * Updates the bounds of this polyhedron afterwards.
+             *
+             * @param transformation the transformation to apply
+             */
+            void transform(const vm::mat<T,4,4>& transformation);
         public: // Vertex correction and edge healing
             /**
              * Rounds each component of position of every vertex to the nearest integer if the distance of the
@@ -179,7 +179,7 @@ namespace TrenchBroom {
              * @param lambda visitor to run on each pair of vertices
              */
             template <typename L>
-            void visitMatchingVertexPairs(Face* leftFace, Face* rightFace, L&& lambda) const {
+            void visitMatchingVertexPairs(const Face* leftFace, const Face* rightFace, L&& lambda) const {
                 auto* firstLeftEdge = leftFace->boundary().front();
                 auto* firstRightEdge = rightFace->boundary().front();
 
@@ -25,6 +25,8 @@
 
 #include <vecmath/vec.h>
 #include <vecmath/vec_io.h>
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
 #include <vecmath/ray.h>
 #include <vecmath/plane.h>
 #include <vecmath/bbox.h>
@@ -644,7 +646,7 @@ namespace TrenchBroom {
         }
 
         template <typename T, typename FP, typename VP>
-        typename Polyhedron<T,FP,VP>::Face* Polyhedron<T,FP,VP>::findClosestFace(const std::vector<vm::vec<T,3>>& positions, const T maxDistance) {
+        typename Polyhedron<T,FP,VP>::Face* Polyhedron<T,FP,VP>::findClosestFace(const std::vector<vm::vec<T,3>>& positions, const T maxDistance) const {
             auto closestDistance = maxDistance;
             Face* closestFace = nullptr;
 
@@ -673,6 +675,17 @@ namespace TrenchBroom {
             }
         }
 
+        template <typename T, typename FP, typename VP>
+        void Polyhedron<T,FP,VP>::transform(const vm::mat<T,4,4>& transformation) {
+            for (auto* vertex : m_vertices) {
+                vertex->setPosition(transformation * vertex->position());
+            }
+            for (auto* face : m_faces) {
+                face->setPlane(face->plane().transform(transformation));
+            }
+            updateBounds();
+        }
+
         template <typename T, typename FP, typename VP>
         void Polyhedron<T,FP,VP>::correctVertexPositions(const size_t decimals, const T epsilon) {
             for (auto* vertex : m_vertices) {
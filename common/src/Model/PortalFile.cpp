@@ -23,15 +23,22 @@
 #include "IO/IOUtils.h"
 #include "IO/Path.h"
 
+#include <kdl/parallel.h>
 #include <kdl/string_format.h>
-#include <kdl/string_utils.h>
 
+#include <vecmath/bbox.h>
 #include <vecmath/forward.h>
 #include <vecmath/polygon.h>
 #include <vecmath/vec.h>
 
+#include <algorithm>
+#include <cstdlib>
 #include <fstream>
+#include <iterator>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Model {
@@ -39,7 +46,13 @@ namespace TrenchBroom {
         PortalFile::~PortalFile() = default;
 
         PortalFile::PortalFile(const IO::Path& path) {
-            load(path);
+            std::atomic<float> progress(0.0f);
+            const std::atomic<bool> cancelled(false);
+            load(path, progress, cancelled);
+        }
+
+        PortalFile::PortalFile(const IO::Path& path, std::atomic<float>& progress, const std::atomic<bool>& cancelled) {
+            load(path, progress, cancelled);
         }
 
         bool PortalFile::canLoad(const IO::Path& path) {
@@ -51,66 +64,185 @@ namespace TrenchBroom {
             return m_portals;
         }
 
-        void PortalFile::load(const IO::Path& path) {
-            std::ifstream stream = openPathAsInputStream(path);
+        std::vector<size_t> PortalFile::findPortals(const vm::bbox3f& bounds) const {
+            return m_portalTree.findIntersectors(bounds);
+        }
+
+        static std::string readFile(const IO::Path& path) {
+            std::ifstream stream = openPathAsInputStream(path, std::ios::in | std::ios::binary);
             if (!stream.good()) {
                 throw FileFormatException("Couldn't open file");
             }
 
-            std::string line;
+            stream.seekg(0, std::ios::end);
+            const auto end = stream.tellg();
+            if (end < 0) {
+                throw FileFormatException("Couldn't determine file size");
+            }
+            const auto size = static_cast<size_t>(end);
+            stream.seekg(0, std::ios::beg);
+
+            std::string buffer(size, '\0');
+            stream.read(buffer.data(), static_cast<std::streamsize>(size));
+            if (!stream.good()) {
+                throw FileFormatException("Couldn't read file");
+            }
+
+            return buffer;
+        }
+
+        static std::string_view nextLine(std::string_view& str) {
+            const auto end = str.find('\n');
+            const auto line = str.substr(0, end);
+            str.remove_prefix(end == std::string_view::npos ? str.size() : end + 1u);
+            return line;
+        }
+
+        static std::string_view nextToken(std::string_view& str) {
+            static const auto Delimiters = std::string_view("() \t\r");
+
+            const auto first = str.find_first_not_of(Delimiters);
+            if (first == std::string_view::npos) {
+                str = std::string_view();
+                return str;
+            }
+
+            const auto last = str.find_first_of(Delimiters, first);
+            const auto token = str.substr(first, last - first);
+            str.remove_prefix(last == std::string_view::npos ? str.size() : last);
+            return token;
+        }
+
+        /**
+         * The given token must be followed by a delimiter or the end of a null terminated buffer so that it can be
+         * converted without copying it.
+         */
+        static std::optional<long> parseInteger(const std::string_view token) {
+            if (token.empty()) {
+                return std::nullopt;
+            }
+
+            char* end = nullptr;
+            const auto value = std::strtol(token.data(), &end, 10);
+            if (end != token.data() + token.size()) {
+                return std::nullopt;
+            }
+            return value;
+        }
+
+        static std::optional<float> parseFloat(const std::string_view token) {
+            if (token.empty()) {
+                return std::nullopt;
+            }
+
+            char* end = nullptr;
+            const auto value = std::strtof(token.data(), &end);
+            if (end != token.data() + token.size()) {
+                return std::nullopt;
+            }
+            return value;
+        }
+
+        static std::optional<vm::polygon3f> parsePortal(std::string_view line) {
+            const auto numPoints = parseInteger(nextToken(line));
+            if (!numPoints || *numPoints < 0) {
+                return std::nullopt;
+            }
+
+            // the two leafs or clusters which the portal connects
+            nextToken(line);
+            nextToken(line);
+
+            std::vector<vm::vec3f> verts;
+            verts.reserve(static_cast<size_t>(*numPoints));
+            for (long i = 0; i < *numPoints; ++i) {
+                const auto x = parseFloat(nextToken(line));
+                const auto y = parseFloat(nextToken(line));
+                const auto z = parseFloat(nextToken(line));
+                if (!x || !y || !z) {
+                    return std::nullopt;
+                }
+                verts.emplace_back(*x, *y, *z);
+            }
+
+            return vm::polygon3f(std::move(verts));
+        }
+
+        void PortalFile::load(const IO::Path& path, std::atomic<float>& progress, const std::atomic<bool>& cancelled) {
+            const auto buffer = readFile(path);
+            auto remainder = std::string_view(buffer);
+
             int numPortals;
 
             // read header
-            std::getline(stream, line);
-            const std::string formatCode = kdl::str_trim(line); // trim off any trailing \r
+            const std::string formatCode = kdl::str_trim(std::string(nextLine(remainder))); // trim off any trailing \r
 
             if (formatCode == "PRT1") {
-                std::getline(stream, line); // number of leafs (ignored)
-                std::getline(stream, line); // number of portals
-                numPortals = std::stoi(line);
+                nextLine(remainder); // number of leafs (ignored)
+                numPortals = std::stoi(std::string(nextLine(remainder))); // number of portals
             } else if (formatCode == "PRT2") {
-                std::getline(stream, line); // number of leafs (ignored)
-                std::getline(stream, line); // number of clusters (ignored)
-                std::getline(stream, line); // number of portals
-                numPortals = std::stoi(line);
+                nextLine(remainder); // number of leafs (ignored)
+                nextLine(remainder); // number of clusters (ignored)
+                numPortals = std::stoi(std::string(nextLine(remainder))); // number of portals
             } else if (formatCode == "PRT1-AM") {
-                std::getline(stream, line); // number of clusters (ignored)
-                std::getline(stream, line); // number of portals
-                numPortals = std::stoi(line);
-                std::getline(stream, line); // number of leafs (ignored)
+                nextLine(remainder); // number of clusters (ignored)
+                numPortals = std::stoi(std::string(nextLine(remainder))); // number of portals
+                nextLine(remainder); // number of leafs (ignored)
             } else {
                 throw FileFormatException("Unknown portal format: " + formatCode);
             }
 
-            if (!stream.good()) {
+            if (numPortals < 0) {
                 throw FileFormatException("Error reading header");
             }
 
-            // read portals
+            // split the portals into lines first so that they can be parsed in parallel
+            std::vector<std::string_view> lines;
+            lines.reserve(static_cast<size_t>(numPortals));
             for (int i = 0; i < numPortals; ++i) {
-                std::getline(stream, line);
-                const auto components = kdl::str_split(line, "() \n\t\r");
-
-                if (!stream.good() || components.size() < 3) {
+                if (remainder.empty()) {
                     throw FileFormatException("Error reading portal");
                 }
+                lines.push_back(nextLine(remainder));
+            }
 
-                std::vector<vm::vec3f> verts;
-                size_t ptr = 3;
-                const int numPoints = std::stoi(components.at(0));
-                for (int j = 0; j < numPoints; ++j) {
-                    if (ptr + 2 >= components.size()) {
+            // parse and index the portals in chunks so that progress can be reported and loading can be cancelled
+            static const size_t ChunkSize = 16384u;
+            const auto totalWork = static_cast<float>(2u * lines.size());
+
+            m_portals.reserve(lines.size());
+            for (size_t first = 0u; first < lines.size() && !cancelled; first += ChunkSize) {
+                const auto last = std::min(first + ChunkSize, lines.size());
+                auto chunk = std::vector<std::string_view>(std::next(std::begin(lines), static_cast<std::ptrdiff_t>(first)),
+                                                           std::next(std::begin(lines), static_cast<std::ptrdiff_t>(last)));
+                auto portals = kdl::vec_parallel_transform(std::move(chunk), [](std::string_view&& line) {
+                    return parsePortal(line);
+                });
+
+                for (auto& portal : portals) {
+                    if (!portal) {
                         throw FileFormatException("Error reading portal");
                     }
+                    m_portals.push_back(std::move(*portal));
+                }
+                progress = static_cast<float>(last) / totalWork;
+            }
 
-                    const vm::vec3f vert(std::stof(components.at(ptr)),
-                                     std::stof(components.at(ptr+1)),
-                                     std::stof(components.at(ptr+2)));
-                    verts.push_back(vert);
-                    ptr += 3;
+            for (size_t i = 0u; i < m_portals.size() && !cancelled; ++i) {
+                const auto& vertices = m_portals[i].vertices();
+                if (!vertices.empty()) {
+                    m_portalTree.insert(vm::bbox3f::merge_all(std::begin(vertices), std::end(vertices)), i);
+                }
+                if ((i + 1u) % ChunkSize == 0u) {
+                    progress = static_cast<float>(m_portals.size() + i + 1u) / totalWork;
                 }
+            }
 
-                m_portals.push_back(vm::polygon3f(verts));
+            if (cancelled) {
+                m_portals.clear();
+                m_portalTree.clear();
+            } else {
+                progress = 1.0f;
             }
         }
     }
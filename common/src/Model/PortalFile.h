@@ -19,8 +19,12 @@
 
 #pragma once
 
+#include "AABBTree.h"
+
 #include <vecmath/forward.h>
 
+#include <atomic>
+#include <cstddef>
 #include <vector>
 
 namespace TrenchBroom {
@@ -30,7 +34,10 @@ namespace TrenchBroom {
     namespace Model {
         class PortalFile {
         private:
+            using PortalTree = AABBTree<float, 3, size_t>;
+
             std::vector<vm::polygon3f> m_portals;
+            PortalTree m_portalTree;
         public:
             PortalFile();
             ~PortalFile();
@@ -40,11 +47,25 @@ namespace TrenchBroom {
              */
             explicit PortalFile(const IO::Path& path);
 
+            /**
+             * Loads the given file, storing the fraction of the portals that have been processed so far in the given
+             * progress value. If the given cancelled flag is set while the file is loading, loading stops and the portal
+             * file remains empty.
+             *
+             * Throws an exception if portalFilePath couldn't be read.
+             */
+            PortalFile(const IO::Path& path, std::atomic<float>& progress, const std::atomic<bool>& cancelled);
+
             static bool canLoad(const IO::Path& path);
 
             const std::vector<vm::polygon3f>& portals() const;
+
+            /**
+             * Returns the indices of the portals whose bounds intersect with the given bounds.
+             */
+            std::vector<size_t> findPortals(const vm::bbox3f& bounds) const;
         private:
-            void load(const IO::Path& path);
+            void load(const IO::Path& path, std::atomic<float>& progress, const std::atomic<bool>& cancelled);
         };
     }
 }
@@ -42,6 +42,11 @@ namespace TrenchBroom {
 
         TexCoordSystem::~TexCoordSystem() = default;
 
+        TexCoordSystem::TexCoordSystem(const TexCoordSystem& other) = default;
+        TexCoordSystem::TexCoordSystem(TexCoordSystem&& other) noexcept = default;
+        TexCoordSystem& TexCoordSystem::operator=(const TexCoordSystem& other) = default;
+        TexCoordSystem& TexCoordSystem::operator=(TexCoordSystem&& other) noexcept = default;
+
         bool operator==(const TexCoordSystem& lhs, const TexCoordSystem& rhs) {
             return lhs.xAxis() == rhs.xAxis() && lhs.yAxis() == rhs.yAxis();
         }
@@ -50,10 +55,6 @@ namespace TrenchBroom {
             return !(lhs == rhs);
         }
 
-        std::unique_ptr<TexCoordSystem> TexCoordSystem::clone() const {
-            return doClone();
-        }
-
         std::unique_ptr<TexCoordSystemSnapshot> TexCoordSystem::takeSnapshot() const {
             return doTakeSnapshot();
         }
@@ -83,7 +84,17 @@ namespace TrenchBroom {
         }
 
         vm::vec2f TexCoordSystem::getTexCoords(const vm::vec3& point, const BrushFaceAttributes& attribs, const vm::vec2f& textureSize) const {
-            return doGetTexCoords(point, attribs, textureSize);
+            return projection(attribs, textureSize)(point);
+        }
+
+        TexCoordProjection TexCoordSystem::projection(const BrushFaceAttributes& attribs, const vm::vec2f& textureSize) const {
+            const auto& scale = attribs.scale();
+            return TexCoordProjection{
+                safeScaleAxis(getXAxis(), scale.x()),
+                safeScaleAxis(getYAxis(), scale.y()),
+                attribs.offset(),
+                textureSize
+            };
         }
 
         void TexCoordSystem::setRotation(const vm::vec3& normal, const float oldAngle, const float newAngle) {
@@ -226,11 +237,11 @@ namespace TrenchBroom {
                          dot(point, safeScaleAxis(getYAxis(), scale.y())));
         }
 
-        std::tuple<std::unique_ptr<TexCoordSystem>, BrushFaceAttributes> TexCoordSystem::toParallel(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs) const {
+        std::tuple<ParallelTexCoordSystem, BrushFaceAttributes> TexCoordSystem::toParallel(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs) const {
             return doToParallel(point0, point1, point2, attribs);
         }
 
-        std::tuple<std::unique_ptr<TexCoordSystem>, BrushFaceAttributes> TexCoordSystem::toParaxial(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs) const {
+        std::tuple<ParaxialTexCoordSystem, BrushFaceAttributes> TexCoordSystem::toParaxial(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs) const {
             return doToParaxial(point0, point1, point2, attribs);
         }
     }
@@ -49,6 +49,23 @@ namespace TrenchBroom {
             friend class ParaxialTexCoordSystem;
         };
 
+        /**
+         * Projects points onto the texture plane of a face. The texture axes are scaled once when the projection is
+         * created, so that the texture coordinates of all vertices of a face can be computed in a tight loop without
+         * any virtual calls.
+         */
+        struct TexCoordProjection {
+            vm::vec3 xAxis;
+            vm::vec3 yAxis;
+            vm::vec2f offset;
+            vm::vec2f textureSize;
+
+            vm::vec2f operator()(const vm::vec3& point) const {
+                const auto texCoords = vm::vec2f(vm::dot(point, xAxis), vm::dot(point, yAxis));
+                return (texCoords + offset) / textureSize;
+            }
+        };
+
         enum class WrapStyle {
             Projection,
             Rotation
@@ -62,7 +79,6 @@ namespace TrenchBroom {
             friend bool operator==(const TexCoordSystem& lhs, const TexCoordSystem& rhs);
             friend bool operator!=(const TexCoordSystem& lhs, const TexCoordSystem& rhs);
 
-            std::unique_ptr<TexCoordSystem> clone() const;
             std::unique_ptr<TexCoordSystemSnapshot> takeSnapshot() const;
 
             vm::vec3 xAxis() const;
@@ -74,6 +90,7 @@ namespace TrenchBroom {
             void resetTextureAxesToParallel(const vm::vec3& normal, float angle);
 
             vm::vec2f getTexCoords(const vm::vec3& point, const BrushFaceAttributes& attribs, const vm::vec2f& textureSize) const;
+            TexCoordProjection projection(const BrushFaceAttributes& attribs, const vm::vec2f& textureSize) const;
 
             void setRotation(const vm::vec3& normal, float oldAngle, float newAngle);
             void transform(const vm::plane3& oldBoundary, const vm::plane3& newBoundary, const vm::mat4x4& transformation, BrushFaceAttributes& attribs, const vm::vec2f& textureSize, bool lockTexture, const vm::vec3& invariant);
@@ -87,10 +104,9 @@ namespace TrenchBroom {
             vm::mat4x4 fromMatrix(const vm::vec2f& offset, const vm::vec2f& scale) const;
             float measureAngle(float currentAngle, const vm::vec2f& center, const vm::vec2f& point) const;
 
-            std::tuple<std::unique_ptr<TexCoordSystem>, BrushFaceAttributes> toParallel(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs) const;
-            std::tuple<std::unique_ptr<TexCoordSystem>, BrushFaceAttributes> toParaxial(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs) const;
+            std::tuple<ParallelTexCoordSystem, BrushFaceAttributes> toParallel(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs) const;
+            std::tuple<ParaxialTexCoordSystem, BrushFaceAttributes> toParaxial(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs) const;
         private:
-            virtual std::unique_ptr<TexCoordSystem> doClone() const = 0;
             virtual std::unique_ptr<TexCoordSystemSnapshot> doTakeSnapshot() const = 0;
             virtual void doRestoreSnapshot(const TexCoordSystemSnapshot& snapshot) = 0;
             friend class TexCoordSystemSnapshot;
@@ -105,7 +121,6 @@ namespace TrenchBroom {
             virtual void doResetTextureAxesToParallel(const vm::vec3& normal, float angle) = 0;
 
             virtual bool isRotationInverted(const vm::vec3& normal) const = 0;
-            virtual vm::vec2f doGetTexCoords(const vm::vec3& point, const BrushFaceAttributes& attribs, const vm::vec2f& textureSize) const = 0;
 
             virtual void doSetRotation(const vm::vec3& normal, float oldAngle, float newAngle) = 0;
             virtual void doTransform(const vm::plane3& oldBoundary, const vm::plane3& newBoundary, const vm::mat4x4& transformation, BrushFaceAttributes& attribs, const vm::vec2f& textureSize, bool lockTexture, const vm::vec3& invariant) = 0;
@@ -116,9 +131,14 @@ namespace TrenchBroom {
 
             virtual float doMeasureAngle(float currentAngle, const vm::vec2f& center, const vm::vec2f& point) const = 0;
 
-            virtual std::tuple<std::unique_ptr<TexCoordSystem>, BrushFaceAttributes> doToParallel(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs) const = 0;
-            virtual std::tuple<std::unique_ptr<TexCoordSystem>, BrushFaceAttributes> doToParaxial(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs) const = 0;
+            virtual std::tuple<ParallelTexCoordSystem, BrushFaceAttributes> doToParallel(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs) const = 0;
+            virtual std::tuple<ParaxialTexCoordSystem, BrushFaceAttributes> doToParaxial(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs) const = 0;
         protected:
+            TexCoordSystem(const TexCoordSystem& other);
+            TexCoordSystem(TexCoordSystem&& other) noexcept;
+            TexCoordSystem& operator=(const TexCoordSystem& other);
+            TexCoordSystem& operator=(TexCoordSystem&& other) noexcept;
+
             vm::vec2f computeTexCoords(const vm::vec3& point, const vm::vec2f& scale) const;
 
             template <typename T>
@@ -130,8 +150,6 @@ namespace TrenchBroom {
             vm::vec<T1,3> safeScaleAxis(const vm::vec<T1,3>& axis, const T2 factor) const {
                 return axis / safeScale(T1(factor));
             }
-
-            deleteCopyAndMove(TexCoordSystem)
         };
     }
 }
@@ -37,6 +37,7 @@
 
 #include <vecmath/bbox_io.h>
 
+#include <cassert>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -49,7 +50,8 @@ namespace TrenchBroom {
         m_entityNodeIndex(std::make_unique<EntityNodeIndex>()),
         m_issueGeneratorRegistry(std::make_unique<IssueGeneratorRegistry>()),
         m_nodeTree(std::make_unique<NodeTree>()),
-        m_updateNodeTree(true) {
+        m_updateNodeTree(true),
+        m_nodeTreeBatchDepth(0u) {
             entity.addOrUpdateProperty(PropertyKeys::Classname, PropertyValues::WorldspawnClassname);
             entity.setPointEntity(false);
             setEntity(std::move(entity));
@@ -139,6 +141,10 @@ namespace TrenchBroom {
             return *m_entityNodeIndex;
         }
 
+        EntityNodeIndex& WorldNode::entityNodeIndex() {
+            return *m_entityNodeIndex;
+        }
+
         const std::vector<IssueGenerator*>& WorldNode::registeredIssueGenerators() const {
             return m_issueGeneratorRegistry->registeredGenerators();
         }
@@ -184,6 +190,28 @@ namespace TrenchBroom {
             m_nodeTree->clearAndBuild(nodes, [](const auto* node){ return node->physicalBounds(); });
         }
 
+        void WorldNode::beginNodeTreeBatch() {
+            ++m_nodeTreeBatchDepth;
+        }
+
+        void WorldNode::endNodeTreeBatch() {
+            assert(m_nodeTreeBatchDepth > 0u);
+            if (--m_nodeTreeBatchDepth == 0u) {
+                applyPendingNodeTreeUpdates();
+            }
+        }
+
+        void WorldNode::applyPendingNodeTreeUpdates() {
+            auto nodes = std::vector<Node*>{};
+            nodes.swap(m_pendingNodeTreeUpdates);
+
+            if (!m_updateNodeTree) {
+                return;
+            }
+
+            m_nodeTree->updateAll(nodes, [](const auto* node){ return node->physicalBounds(); });
+        }
+
         void WorldNode::invalidateAllIssues() {
             accept([](auto&& thisLambda, Node* node) {
                 node->invalidateIssues();
@@ -285,6 +313,9 @@ namespace TrenchBroom {
         }
 
         void WorldNode::doDescendantWillBeRemoved(Node* node, const size_t /* depth */) {
+            // pending updates might refer to the removed nodes
+            applyPendingNodeTreeUpdates();
+
             if (m_updateNodeTree) {
                 const auto doRemove = [&](auto* nodeToRemove) {
                 if (!m_nodeTree->remove(nodeToRemove)) {
@@ -306,12 +337,20 @@ namespace TrenchBroom {
 
         void WorldNode::doDescendantPhysicalBoundsDidChange(Node* node) {
             if (m_updateNodeTree) {
+                const auto updateNode = [&](Node* nodeToUpdate) {
+                    if (m_nodeTreeBatchDepth > 0u) {
+                        m_pendingNodeTreeUpdates.push_back(nodeToUpdate);
+                    } else {
+                        m_nodeTree->update(nodeToUpdate->physicalBounds(), nodeToUpdate);
+                    }
+                };
+
                 node->accept(kdl::overload(
                     [] (WorldNode*) {},
                     [] (LayerNode*) {},
                     [] (GroupNode*) {},
-                    [&](EntityNode* entity) { m_nodeTree->update(entity->physicalBounds(), entity); },
-                    [&](BrushNode* brush)   { m_nodeTree->update(brush->physicalBounds(), brush); }
+                    [&](EntityNode* entity) { updateNode(entity); },
+                    [&](BrushNode* brush)   { updateNode(brush); }
                 ));
             }
         }
@@ -379,5 +418,19 @@ namespace TrenchBroom {
         void WorldNode::doAcceptTagVisitor(ConstTagVisitor& visitor) const {
             visitor.visit(*this);
         }
+
+        NodeTreeBatch::NodeTreeBatch(WorldNode& world) :
+        m_world(world) {
+            m_world.beginNodeTreeBatch();
+        }
+
+        NodeTreeBatch::~NodeTreeBatch() {
+            try {
+                m_world.endNodeTreeBatch();
+            } catch (const NodeTreeException&) {
+                // the destructor must not throw, and the node tree may have been left partially updated
+                m_world.rebuildNodeTree();
+            }
+        }
     }
 }
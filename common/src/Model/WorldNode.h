@@ -55,6 +55,9 @@ namespace TrenchBroom {
             std::unique_ptr<NodeTree> m_nodeTree;
             bool m_updateNodeTree;
 
+            size_t m_nodeTreeBatchDepth;
+            std::vector<Node*> m_pendingNodeTreeUpdates;
+
             IdType m_nextPersistentId = 1;
         public:
             WorldNode(Entity entity, MapFormat mapFormat);
@@ -109,6 +112,7 @@ namespace TrenchBroom {
             void createDefaultLayer();
         public: // index
             const EntityNodeIndex& entityNodeIndex() const;
+            EntityNodeIndex& entityNodeIndex();
         public: // selection
             // issue generator registration
             const std::vector<IssueGenerator*>& registeredIssueGenerators() const;
@@ -119,7 +123,21 @@ namespace TrenchBroom {
             void disableNodeTreeUpdates();
             void enableNodeTreeUpdates();
             void rebuildNodeTree();
+
+            /**
+             * Opens a batch. While a batch is open, the node tree is not updated when the bounds of a node change.
+             * Batches can be nested, and the changed nodes are updated together when the outermost batch is closed.
+             */
+            void beginNodeTreeBatch();
+
+            /**
+             * Closes a batch. If this closes the outermost batch, the node tree is updated.
+             *
+             * @throws NodeTreeException if the node tree cannot be updated
+             */
+            void endNodeTreeBatch();
         private:
+            void applyPendingNodeTreeUpdates();
             void invalidateAllIssues();
         private: // implement Node interface
             const vm::bbox3& doGetLogicalBounds() const override;
@@ -155,6 +173,20 @@ namespace TrenchBroom {
         private:
             deleteCopyAndMove(WorldNode)
         };
+
+        /**
+         * Opens a node tree batch on the given world for the lifetime of this object. If the node tree cannot be
+         * updated when the batch is closed, it is rebuilt instead.
+         */
+        class NodeTreeBatch {
+        private:
+            WorldNode& m_world;
+        public:
+            explicit NodeTreeBatch(WorldNode& world);
+            ~NodeTreeBatch();
+
+            deleteCopyAndMove(NodeTreeBatch)
+        };
     }
 }
 
@@ -0,0 +1,120 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Macros.h"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace TrenchBroom {
+    /**
+     * Allocates memory for objects of type T from large blocks, which reduces the per object overhead of the heap
+     * and keeps objects that are allocated together close to each other in memory.
+     *
+     * Freed slots are kept in a free list and reused by subsequent allocations. The blocks are only released when
+     * the pool is destroyed, so a pool must outlive every object allocated from it.
+     *
+     * A pool only provides memory; constructing and destroying the objects is up to the caller, usually in a class
+     * specific operator new and operator delete. Allocating and freeing is thread safe.
+     *
+     * @tparam T the type of the objects allocated from this pool
+     * @tparam BlockSize the number of objects per block
+     */
+    template <typename T, size_t BlockSize = 1024u>
+    class ObjectPool {
+    private:
+        union Slot {
+            Slot* next;
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+
+        mutable std::mutex m_mutex;
+        std::vector<std::unique_ptr<Slot[]>> m_blocks;
+        size_t m_nextUnusedSlot;
+        Slot* m_freeList;
+        size_t m_allocatedCount;
+    public:
+        ObjectPool() :
+        m_nextUnusedSlot(BlockSize),
+        m_freeList(nullptr),
+        m_allocatedCount(0u) {}
+
+        deleteCopyAndMove(ObjectPool)
+
+        /**
+         * Returns uninitialized memory for one object of type T.
+         *
+         * @throws std::bad_alloc if a new block cannot be allocated
+         */
+        void* allocate() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            Slot* slot;
+            if (m_freeList != nullptr) {
+                slot = m_freeList;
+                m_freeList = slot->next;
+            } else {
+                if (m_nextUnusedSlot == BlockSize) {
+                    m_blocks.push_back(std::make_unique<Slot[]>(BlockSize));
+                    m_nextUnusedSlot = 0u;
+                }
+                slot = &m_blocks.back()[m_nextUnusedSlot++];
+            }
+
+            ++m_allocatedCount;
+            return slot->storage;
+        }
+
+        /**
+         * Returns the given memory, which must have been returned by allocate, to this pool.
+         */
+        void deallocate(void* ptr) {
+            if (ptr == nullptr) {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            auto* slot = reinterpret_cast<Slot*>(ptr);
+            slot->next = m_freeList;
+            m_freeList = slot;
+            --m_allocatedCount;
+        }
+
+        /**
+         * Returns the number of objects that are currently allocated from this pool.
+         */
+        size_t allocatedCount() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_allocatedCount;
+        }
+
+        /**
+         * Returns the number of bytes held by this pool, including free slots.
+         */
+        size_t reservedBytes() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_blocks.size() * BlockSize * sizeof(Slot);
+        }
+    };
+}
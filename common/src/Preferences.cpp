@@ -47,6 +47,7 @@ namespace TrenchBroom {
         Preference<Color> PointFileColor(IO::Path("Renderer/Colors/Point file"), Color(0.0f, 1.0f, 0.0f, 1.0f));
         Preference<Color> PortalFileBorderColor(IO::Path("Renderer/Colors/Portal file border"), Color(1.0f, 1.0f, 1.0f, 0.5f));
         Preference<Color> PortalFileFillColor(IO::Path("Renderer/Colors/Portal file fill"), Color(1.0f, 0.4f, 0.4f, 0.2f));
+        Preference<float> PortalFileRenderDistance(IO::Path("Renderer/Portal file render distance"), 0.0f);
         Preference<bool>  ShowFPS(IO::Path("Renderer/Show FPS"), false);
 
         Preference<Color>& axisColor(vm::axis::type axis) {
@@ -134,6 +135,8 @@ namespace TrenchBroom {
 
         Preference<bool> TextureLock(IO::Path("Editor/Texture lock"), true);
         Preference<bool> UVLock(IO::Path("Editor/UV lock"), false);
+        // in megabytes
+        Preference<int> UndoMemoryLimit(IO::Path("Editor/Undo memory limit"), 1024);
 
         Preference<IO::Path>& RendererFontPath() {
             static Preference<IO::Path> fontPath(IO::Path("Renderer/Font name"), IO::Path("fonts/SourceSansPro-Regular.otf"));
@@ -241,6 +244,7 @@ namespace TrenchBroom {
                 &PointFileColor,
                 &PortalFileBorderColor,
                 &PortalFileFillColor,
+                &PortalFileRenderDistance,
                 &ShowFPS,
                 &CompassBackgroundColor,
                 &CompassBackgroundOutlineColor,
@@ -297,6 +301,7 @@ namespace TrenchBroom {
                 &TextureMagFilter,
                 &TextureLock,
                 &UVLock,
+                &UndoMemoryLimit,
                 &RendererFontPath(),
                 &RendererFontSize,
                 &BrowserFontSize,
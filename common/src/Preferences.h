@@ -50,6 +50,7 @@ namespace TrenchBroom {
         extern Preference<Color> PointFileColor;
         extern Preference<Color> PortalFileBorderColor;
         extern Preference<Color> PortalFileFillColor;
+        extern Preference<float> PortalFileRenderDistance;
         extern Preference<bool>  ShowFPS;
 
         Preference<Color>& axisColor(vm::axis::type axis);
@@ -127,6 +128,7 @@ namespace TrenchBroom {
 
         extern Preference<bool> TextureLock;
         extern Preference<bool> UVLock;
+        extern Preference<int> UndoMemoryLimit;
 
         Preference<IO::Path>& RendererFontPath();
         extern Preference<int> RendererFontSize;
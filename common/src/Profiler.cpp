@@ -0,0 +1,196 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Profiler.h"
+
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace TrenchBroom {
+    struct ProfilerEvent {
+        enum class Type {
+            Scope,
+            Counter
+        };
+
+        Type type;
+        size_t threadId;
+        const char* name;
+        Profiler::Clock::time_point start;
+        Profiler::Clock::duration duration;
+        int64_t value;
+    };
+
+    struct ProfilerThreadBuffer;
+
+    /**
+     * Holds the buffers of all running threads that recorded an event, and the events of the threads that have
+     * finished.
+     */
+    struct ProfilerRegistry {
+        std::mutex mutex;
+        size_t nextThreadId = 1u;
+        std::vector<ProfilerThreadBuffer*> threadBuffers;
+        std::vector<ProfilerEvent> finishedThreadEvents;
+    };
+
+    static ProfilerRegistry& registry() {
+        static ProfilerRegistry instance;
+        return instance;
+    }
+
+    /**
+     * The events recorded by one thread. The mutex is only contended while a trace is written or cleared.
+     *
+     * The buffer registers itself with the registry when it is created. When its thread exits, it moves its events
+     * into the registry and unregisters itself, so that threads which only run for a short time, like the threads
+     * spawned by kdl::parallel_for, do not leave their buffers behind.
+     */
+    struct ProfilerThreadBuffer {
+        size_t threadId;
+        std::mutex mutex;
+        std::vector<ProfilerEvent> events;
+
+        ProfilerThreadBuffer() {
+            auto& reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+
+            threadId = reg.nextThreadId++;
+            reg.threadBuffers.push_back(this);
+        }
+
+        ~ProfilerThreadBuffer() {
+            auto& reg = registry();
+            std::lock_guard<std::mutex> registryLock(reg.mutex);
+            std::lock_guard<std::mutex> bufferLock(mutex);
+
+            reg.finishedThreadEvents.insert(std::end(reg.finishedThreadEvents), std::begin(events), std::end(events));
+            reg.threadBuffers.erase(std::remove(std::begin(reg.threadBuffers), std::end(reg.threadBuffers), this), std::end(reg.threadBuffers));
+        }
+
+        deleteCopyAndMove(ProfilerThreadBuffer)
+    };
+
+    /**
+     * The time stamps of the events are relative to this time point.
+     */
+    static const Profiler::Clock::time_point StartTime = Profiler::Clock::now();
+
+    static ProfilerThreadBuffer& threadBuffer() {
+        thread_local ProfilerThreadBuffer buffer;
+        return buffer;
+    }
+
+    static void recordEvent(ProfilerEvent event) {
+        auto& buffer = threadBuffer();
+        event.threadId = buffer.threadId;
+
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        buffer.events.push_back(event);
+    }
+
+    static int64_t toMicroseconds(const Profiler::Clock::duration duration) {
+        return static_cast<int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+    }
+
+    static void writeName(std::ostream& stream, const char* name) {
+        stream << "\"";
+        for (const char* c = name; *c != '\0'; ++c) {
+            if (*c == '"' || *c == '\\') {
+                stream << '\\';
+            }
+            stream << *c;
+        }
+        stream << "\"";
+    }
+
+    void Profiler::recordScope(const char* name, const Clock::time_point start, const Clock::time_point end) {
+        recordEvent(ProfilerEvent{ProfilerEvent::Type::Scope, 0u, name, start, end - start, 0});
+    }
+
+    void Profiler::recordCounter(const char* name, const int64_t value) {
+        recordEvent(ProfilerEvent{ProfilerEvent::Type::Counter, 0u, name, Clock::now(), Clock::duration::zero(), value});
+    }
+
+    static void writeEvent(std::ostream& stream, const ProfilerEvent& event, bool& first) {
+        if (!first) {
+            stream << ",";
+        }
+        first = false;
+
+        stream << "\n{\"name\":";
+        writeName(stream, event.name);
+        stream << ",\"pid\":1,\"tid\":" << event.threadId;
+        stream << ",\"ts\":" << toMicroseconds(event.start - StartTime);
+
+        switch (event.type) {
+            case ProfilerEvent::Type::Scope:
+                stream << ",\"ph\":\"X\",\"dur\":" << toMicroseconds(event.duration);
+                break;
+            case ProfilerEvent::Type::Counter:
+                stream << ",\"ph\":\"C\",\"args\":{\"value\":" << event.value << "}";
+                break;
+        }
+
+        stream << "}";
+    }
+
+    void Profiler::writeTrace(std::ostream& stream) {
+        auto& reg = registry();
+        std::lock_guard<std::mutex> registryLock(reg.mutex);
+
+        stream << "{\"traceEvents\":[";
+
+        bool first = true;
+        for (const auto& event : reg.finishedThreadEvents) {
+            writeEvent(stream, event, first);
+        }
+
+        for (auto* buffer : reg.threadBuffers) {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            for (const auto& event : buffer->events) {
+                writeEvent(stream, event, first);
+            }
+        }
+
+        stream << "\n]}\n";
+    }
+
+    void Profiler::clear() {
+        auto& reg = registry();
+        std::lock_guard<std::mutex> registryLock(reg.mutex);
+
+        reg.finishedThreadEvents.clear();
+        for (auto* buffer : reg.threadBuffers) {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            buffer->events.clear();
+        }
+    }
+
+    ProfileScope::ProfileScope(const char* name) :
+    m_name(name),
+    m_start(Profiler::Clock::now()) {}
+
+    ProfileScope::~ProfileScope() {
+        Profiler::recordScope(m_name, m_start, Profiler::Clock::now());
+    }
+}
@@ -0,0 +1,87 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Macros.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+
+namespace TrenchBroom {
+    /**
+     * Records timed scopes and counter values and writes them in the Chrome trace event format, which can be
+     * inspected with chrome://tracing or similar trace viewers.
+     *
+     * Every thread records into its own buffer, so recording from the worker threads of parallel loaders does not
+     * contend with other threads. The names of scopes and counters are not copied, they must be string literals.
+     *
+     * The profiler is only used if TrenchBroom is built with TB_ENABLE_PROFILING defined, otherwise the
+     * TB_PROFILE_SCOPE and TB_PROFILE_COUNTER macros expand to nothing.
+     */
+    class Profiler {
+    public:
+        using Clock = std::chrono::steady_clock;
+    public:
+        /**
+         * Records a scope with the given name that started and ended at the given times.
+         */
+        static void recordScope(const char* name, Clock::time_point start, Clock::time_point end);
+
+        /**
+         * Records the given value of the counter with the given name at the current time.
+         */
+        static void recordCounter(const char* name, int64_t value);
+
+        /**
+         * Writes all events recorded so far to the given stream as a JSON trace.
+         */
+        static void writeTrace(std::ostream& stream);
+
+        /**
+         * Discards all events recorded so far.
+         */
+        static void clear();
+    };
+
+    /**
+     * Records the time between its construction and its destruction as a scope with the given name.
+     */
+    class ProfileScope {
+    private:
+        const char* m_name;
+        Profiler::Clock::time_point m_start;
+    public:
+        explicit ProfileScope(const char* name);
+        ~ProfileScope();
+
+        deleteCopyAndMove(ProfileScope)
+    };
+}
+
+#ifdef TB_ENABLE_PROFILING
+#define TB_PROFILE_CONCAT_IMPL(a, b) a##b
+#define TB_PROFILE_CONCAT(a, b) TB_PROFILE_CONCAT_IMPL(a, b)
+#define TB_PROFILE_SCOPE(name) const TrenchBroom::ProfileScope TB_PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define TB_PROFILE_COUNTER(name, value) TrenchBroom::Profiler::recordCounter(name, static_cast<int64_t>(value))
+#else
+#define TB_PROFILE_SCOPE(name)
+#define TB_PROFILE_COUNTER(name, value)
+#endif
@@ -21,6 +21,7 @@
 
 #include "Preferences.h"
 #include "PreferenceManager.h"
+#include "Profiler.h"
 #include "Model/Brush.h"
 #include "Model/BrushNode.h"
 #include "Model/BrushFace.h"
@@ -339,6 +340,8 @@ namespace TrenchBroom {
         };
 
         void BrushRenderer::validate() {
+            TB_PROFILE_SCOPE("BrushRenderer::validate");
+            TB_PROFILE_COUNTER("Invalid brushes", m_invalidBrushes.size());
             assert(!valid());
 
             for (auto brush : m_invalidBrushes) {
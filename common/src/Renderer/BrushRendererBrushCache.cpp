@@ -19,12 +19,16 @@
 
 #include "BrushRendererBrushCache.h"
 
+#include "Macros.h"
+#include "ObjectPool.h"
 #include "Model/BrushNode.h"
 #include "Model/BrushFace.h"
 #include "Model/BrushGeometry.h"
 #include "Model/Polyhedron.h"
 
 #include <algorithm>
+#include <cassert>
+#include <unordered_map>
 
 namespace TrenchBroom {
     namespace Renderer {
@@ -44,9 +48,24 @@ namespace TrenchBroom {
                   vertexIndex1RelativeToBrush(i_vertexIndex1RelativeToBrush),
                   vertexIndex2RelativeToBrush(i_vertexIndex2RelativeToBrush) {}
 
+        static ObjectPool<BrushRendererBrushCache>& brushCachePool() {
+            // the pool is never destroyed because caches may still be deleted during static destruction
+            static auto* pool = new ObjectPool<BrushRendererBrushCache>();
+            return *pool;
+        }
+
         BrushRendererBrushCache::BrushRendererBrushCache()
                 : m_rendererCacheValid(false) {}
 
+        void* BrushRendererBrushCache::operator new(const size_t size) {
+            assert(size == sizeof(BrushRendererBrushCache)); unused(size);
+            return brushCachePool().allocate();
+        }
+
+        void BrushRendererBrushCache::operator delete(void* ptr, const size_t /* size */) {
+            brushCachePool().deallocate(ptr);
+        }
+
         void BrushRendererBrushCache::invalidateVertexCache() {
             m_rendererCacheValid = false;
             m_cachedVertices.clear();
@@ -68,26 +87,32 @@ namespace TrenchBroom {
             m_cachedFacesSortedByTexture.clear();
             m_cachedFacesSortedByTexture.reserve(brush.faceCount());
 
+            // Maps each vertex to its index, relative to the brush's first vertex being 0. This is used below when
+            // building the edge cache. The brush geometry may be shared with other brushes, so the vertex payloads
+            // must not be used for this.
+            std::unordered_map<const Model::BrushVertex*, GLuint> vertexIndices;
+            vertexIndices.reserve(brush.vertexCount());
+
             for (const Model::BrushFace& face : brush.faces()) {
                 const auto indexOfFirstVertexRelativeToBrush = m_cachedVertices.size();
 
+                // compute the texture projection and the normal once for all vertices of the face
+                const auto textureProjection = face.textureProjection();
+                const auto normal = vm::vec3f(face.boundary().normal);
+
                 // The boundary is in CCW order, but the renderer expects CW order:
                 auto& boundary = face.geometry()->boundary();
                 for (auto it = std::rbegin(boundary), end = std::rend(boundary); it != end; ++it) {
-                    Model::BrushHalfEdge* current = *it;
-                    Model::BrushVertex* vertex = current->origin();
+                    const Model::BrushHalfEdge* current = *it;
+                    const Model::BrushVertex* vertex = current->origin();
 
-                    // Set the vertex payload to the index, relative to the brush's first vertex being 0.
-                    // This is used below when building the edge cache.
-                    // NOTE: we'll overwrite the payload as we visit the same vertex several times while visiting
+                    // NOTE: we'll overwrite the index as we visit the same vertex several times while visiting
                     // different faces, this is fine.
                     const auto currentIndex = m_cachedVertices.size();
-                    vertex->setPayload(static_cast<GLuint>(currentIndex));
+                    vertexIndices[vertex] = static_cast<GLuint>(currentIndex);
 
                     const auto& position = vertex->position();
-                    m_cachedVertices.emplace_back(vm::vec3f(position), vm::vec3f(face.boundary().normal), face.textureCoords(position));
-
-                    current = current->previous();
+                    m_cachedVertices.emplace_back(vm::vec3f(position), normal, textureProjection(position));
                 }
 
                 // face cache
@@ -114,8 +139,8 @@ namespace TrenchBroom {
                 const auto& face1 = brush.face(*faceIndex1);
                 const auto& face2 = brush.face(*faceIndex2);
                 
-                const auto vertexIndex1RelativeToBrush = currentEdge->firstVertex()->payload();
-                const auto vertexIndex2RelativeToBrush = currentEdge->secondVertex()->payload();
+                const auto vertexIndex1RelativeToBrush = vertexIndices.at(currentEdge->firstVertex());
+                const auto vertexIndex2RelativeToBrush = vertexIndices.at(currentEdge->secondVertex());
 
                 m_cachedEdges.emplace_back(&face1, &face2, vertexIndex1RelativeToBrush, vertexIndex2RelativeToBrush);
             }
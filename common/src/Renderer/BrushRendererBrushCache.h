@@ -21,6 +21,7 @@
 
 #include "Renderer/GLVertexType.h"
 
+#include <cstddef>
 #include <vector>
 
 namespace TrenchBroom {
@@ -70,6 +71,16 @@ namespace TrenchBroom {
         public:
             BrushRendererBrushCache();
 
+            /**
+             * The caches are allocated from a pool because every rendered brush has one.
+             *
+             * The pool is never destroyed and never returns its blocks to the heap, so the memory of the caches of the
+             * largest number of brushes rendered at once stays reserved until the application exits. Freed caches are
+             * reused for the brushes rendered later.
+             */
+            static void* operator new(size_t size);
+            static void operator delete(void* ptr, size_t size);
+
             /**
              * Only exposed to be called by BrushFace
              */
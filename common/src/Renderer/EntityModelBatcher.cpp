@@ -0,0 +1,82 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EntityModelBatcher.h"
+
+namespace TrenchBroom {
+    namespace Renderer {
+        EntityModelBatcher::EntityModelBatcher() :
+        m_valid(true) {}
+
+        void EntityModelBatcher::setInstance(Model::EntityNode* entityNode, TexturedRenderer* renderer, const vm::mat4x4f& transformation) {
+            if (renderer == nullptr) {
+                removeInstance(entityNode);
+            } else {
+                const auto [it, inserted] = m_instances.try_emplace(entityNode, Instance{renderer, transformation});
+                if (inserted) {
+                    m_valid = false;
+                } else if (it->second.renderer != renderer || it->second.transformation != transformation) {
+                    it->second = Instance{renderer, transformation};
+                    m_valid = false;
+                }
+            }
+        }
+
+        void EntityModelBatcher::removeInstance(Model::EntityNode* entityNode) {
+            if (m_instances.erase(entityNode) > 0u) {
+                m_valid = false;
+            }
+        }
+
+        void EntityModelBatcher::clear() {
+            m_instances.clear();
+            m_batches.clear();
+            m_valid = true;
+        }
+
+        size_t EntityModelBatcher::instanceCount() const {
+            return m_instances.size();
+        }
+
+        const std::vector<EntityModelBatch>& EntityModelBatcher::batches() {
+            if (!m_valid) {
+                validate();
+            }
+            return m_batches;
+        }
+
+        void EntityModelBatcher::validate() {
+            m_batches.clear();
+
+            std::unordered_map<TexturedRenderer*, size_t> batchIndices;
+            for (const auto& [entityNode, instance] : m_instances) {
+                const auto [it, inserted] = batchIndices.try_emplace(instance.renderer, m_batches.size());
+                if (inserted) {
+                    m_batches.push_back(EntityModelBatch{instance.renderer, {}, {}});
+                }
+
+                auto& batch = m_batches[it->second];
+                batch.entityNodes.push_back(entityNode);
+                batch.transformations.push_back(instance.transformation);
+            }
+
+            m_valid = true;
+        }
+    }
+}
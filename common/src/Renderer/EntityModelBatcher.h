@@ -0,0 +1,84 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Macros.h"
+
+#include <vecmath/mat.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        class EntityNode;
+    }
+
+    namespace Renderer {
+        class TexturedRenderer;
+
+        /**
+         * The instances of one model. The entity nodes and their model transformations are stored in parallel
+         * arrays.
+         */
+        struct EntityModelBatch {
+            TexturedRenderer* renderer;
+            std::vector<Model::EntityNode*> entityNodes;
+            std::vector<vm::mat4x4f> transformations;
+        };
+
+        /**
+         * Groups entities by the renderer of their model. Since the entity model manager creates one renderer per
+         * model specification (path, skin and frame), all entities in a batch show the same model and can be
+         * rendered with a single setup of its vertex array and textures.
+         *
+         * The batches are rebuilt lazily when they are requested after an entity was added, updated or removed.
+         */
+        class EntityModelBatcher {
+        private:
+            struct Instance {
+                TexturedRenderer* renderer;
+                vm::mat4x4f transformation;
+            };
+
+            std::unordered_map<Model::EntityNode*, Instance> m_instances;
+            std::vector<EntityModelBatch> m_batches;
+            bool m_valid;
+        public:
+            EntityModelBatcher();
+
+            /**
+             * Adds the given entity node or updates its renderer and transformation if it was added before. If the
+             * given renderer is null, the entity node is removed.
+             */
+            void setInstance(Model::EntityNode* entityNode, TexturedRenderer* renderer, const vm::mat4x4f& transformation);
+            void removeInstance(Model::EntityNode* entityNode);
+            void clear();
+
+            size_t instanceCount() const;
+
+            const std::vector<EntityModelBatch>& batches();
+        private:
+            void validate();
+
+            deleteCopyAndMove(EntityModelBatcher)
+        };
+    }
+}
@@ -40,6 +40,8 @@
 
 #include <vecmath/mat.h>
 
+#include <vector>
+
 namespace TrenchBroom {
     namespace Renderer {
         EntityModelRenderer::EntityModelRenderer(Logger& logger, Assets::EntityModelManager& entityModelManager, const Model::EditorContext& editorContext) :
@@ -60,7 +62,7 @@ namespace TrenchBroom {
 
             auto* renderer = m_entityModelManager.renderer(modelSpec);
             if (renderer != nullptr) {
-                m_entities.insert(std::make_pair(entityNode, renderer));
+                m_batcher.setInstance(entityNode, renderer, vm::mat4x4f(entityNode->entity().modelTransformation()));
             }
         }
 
@@ -70,25 +72,15 @@ namespace TrenchBroom {
             });
 
             auto* renderer = m_entityModelManager.renderer(modelSpec);
-            EntityMap::iterator it = m_entities.find(entityNode);
-
-            if (renderer == nullptr && it == std::end(m_entities)) {
-                return;
-            }
-
-            if (it == std::end(m_entities)) {
-                m_entities.insert(std::make_pair(entityNode, renderer));
+            if (renderer == nullptr) {
+                m_batcher.removeInstance(entityNode);
             } else {
-                if (renderer == nullptr) {
-                    m_entities.erase(it);
-                } else if (it->second != renderer) {
-                    it->second = renderer;
-                }
+                m_batcher.setInstance(entityNode, renderer, vm::mat4x4f(entityNode->entity().modelTransformation()));
             }
         }
 
         void EntityModelRenderer::clear() {
-            m_entities.clear();
+            m_batcher.clear();
         }
 
         bool EntityModelRenderer::applyTinting() const {
@@ -143,20 +135,30 @@ namespace TrenchBroom {
             glAssert(glEnable(GL_TEXTURE_2D));
             glAssert(glActiveTexture(GL_TEXTURE0));
 
-            for (const auto& entry : m_entities) {
-                auto* entityNode = entry.first;
-                if (!m_showHiddenEntities && !m_editorContext.visible(entityNode)) {
-                    continue;
-                }
-
-                auto* renderer = entry.second;
+            auto& transformation = renderContext.transformation();
+            auto visibleInstances = std::vector<size_t>{};
 
-                const auto transformation = entityNode->entity().modelTransformation();
-                MultiplyModelMatrix multMatrix(renderContext.transformation(), vm::mat4x4f(transformation));
+            for (const auto& batch : m_batcher.batches()) {
+                visibleInstances.clear();
+                for (size_t i = 0; i < batch.entityNodes.size(); ++i) {
+                    if (m_showHiddenEntities || m_editorContext.visible(batch.entityNodes[i])) {
+                        visibleInstances.push_back(i);
+                    }
+                }
 
-                shader.set("ModelMatrix", vm::mat4x4f(transformation));
+                if (visibleInstances.empty()) {
+                    continue;
+                }
 
-                renderer->render();
+                // the model matrix pushed here is replaced by the model matrix of each instance
+                transformation.pushModelMatrix(vm::mat4x4f::identity());
+                batch.renderer->renderInstances(visibleInstances.size(), [&](const size_t i) {
+                    const auto& modelMatrix = batch.transformations[visibleInstances[i]];
+                    transformation.popModelMatrix();
+                    transformation.pushModelMatrix(modelMatrix);
+                    shader.set("ModelMatrix", modelMatrix);
+                });
+                transformation.popModelMatrix();
             }
         }
     }
@@ -20,10 +20,9 @@
 #pragma once
 
 #include "Color.h"
+#include "Renderer/EntityModelBatcher.h"
 #include "Renderer/Renderable.h"
 
-#include <map>
-
 namespace TrenchBroom {
     class Logger;
 
@@ -38,18 +37,15 @@ namespace TrenchBroom {
 
     namespace Renderer {
         class RenderBatch;
-        class TexturedRenderer;
 
         class EntityModelRenderer : public DirectRenderable {
         private:
-            using EntityMap = std::map<Model::EntityNode*, TexturedRenderer*>;
-
             Logger& m_logger;
 
             Assets::EntityModelManager& m_entityModelManager;
             const Model::EditorContext& m_editorContext;
 
-            EntityMap m_entities;
+            EntityModelBatcher m_batcher;
 
             bool m_applyTinting;
             Color m_tintColor;
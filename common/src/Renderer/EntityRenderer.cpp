@@ -34,6 +34,7 @@
 #include "Renderer/RenderContext.h"
 #include "Renderer/RenderService.h"
 #include "Renderer/TextAnchor.h"
+#include "Renderer/TextRenderer.h"
 #include "Renderer/GLVertexType.h"
 
 #include <vecmath/forward.h>
@@ -78,6 +79,8 @@ namespace TrenchBroom {
         m_showAngles(false),
         m_showHiddenEntities(false) {}
 
+        EntityRenderer::~EntityRenderer() = default;
+
         void EntityRenderer::setEntities(const std::vector<Model::EntityNode*>& entities) {
             m_entities = entities;
             m_modelRenderer.setEntities(std::begin(m_entities), std::end(m_entities));
@@ -209,21 +212,31 @@ namespace TrenchBroom {
 
         void EntityRenderer::renderClassnames(RenderContext& renderContext, RenderBatch& renderBatch) {
             if (m_showOverlays && renderContext.showEntityClassnames()) {
-                Renderer::RenderService renderService(renderContext, renderBatch);
-                renderService.setForegroundColor(m_overlayTextColor);
-                renderService.setBackgroundColor(m_overlayBackgroundColor);
+                const auto fontDescriptor = makeRenderServiceFont();
+                if (m_classnameRenderer == nullptr || m_classnameRenderer->fontDescriptor().compare(fontDescriptor) != 0) {
+                    m_classnameRenderer = std::make_unique<TextRenderer>(fontDescriptor);
+                }
 
+                // occluded labels are rendered on top, like RenderService does if occluded objects are shown
+                const bool onTop = m_showOccludedOverlays;
                 for (const Model::EntityNode* entity : m_entities) {
                     if (m_showHiddenEntities || m_editorContext.visible(entity)) {
                         if (entity->containingGroup() == nullptr || entity->containingGroup() == m_editorContext.currentGroup()) {
-                            if (m_showOccludedOverlays)
-                                renderService.setShowOccludedObjects();
-                            else
-                                renderService.setHideOccludedObjects();
-                            renderService.renderString(entityString(entity), EntityClassnameAnchor(entity));
+                            const EntityClassnameAnchor anchor(entity);
+                            if (!m_classnameRenderer->isInViewDistance(renderContext, anchor, onTop)) {
+                                continue;
+                            }
+
+                            if (onTop) {
+                                m_classnameRenderer->renderStringOnTop(renderContext, m_overlayTextColor, m_overlayBackgroundColor, entityString(entity), anchor);
+                            } else {
+                                m_classnameRenderer->renderString(renderContext, m_overlayTextColor, m_overlayBackgroundColor, entityString(entity), anchor);
+                            }
                         }
                     }
                 }
+
+                renderBatch.add(m_classnameRenderer.get());
             }
         }
 
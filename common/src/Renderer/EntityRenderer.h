@@ -27,6 +27,7 @@
 
 #include <vecmath/forward.h>
 
+#include <memory>
 #include <vector>
 
 namespace TrenchBroom {
@@ -43,6 +44,7 @@ namespace TrenchBroom {
 
     namespace Renderer {
         class AttrString;
+        class TextRenderer;
 
         class EntityRenderer {
         private:
@@ -59,6 +61,9 @@ namespace TrenchBroom {
             EntityModelRenderer m_modelRenderer;
             bool m_boundsValid;
 
+            // keeps the vertices of the classname labels between frames
+            std::unique_ptr<TextRenderer> m_classnameRenderer;
+
             bool m_showOverlays;
             Color m_overlayTextColor;
             Color m_overlayBackgroundColor;
@@ -74,6 +79,7 @@ namespace TrenchBroom {
             bool m_showHiddenEntities;
         public:
             EntityRenderer(Logger& logger, Assets::EntityModelManager& entityModelManager, const Model::EditorContext& editorContext);
+            ~EntityRenderer();
 
             void setEntities(const std::vector<Model::EntityNode*>& entities);
             void invalidate();
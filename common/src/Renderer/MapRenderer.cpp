@@ -21,6 +21,7 @@
 
 #include "PreferenceManager.h"
 #include "Preferences.h"
+#include "Profiler.h"
 #include "Assets/EntityDefinitionManager.h"
 #include "Model/Brush.h"
 #include "Model/BrushNode.h"
@@ -187,6 +188,7 @@ namespace TrenchBroom {
         }
 
         void MapRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch) {
+            TB_PROFILE_SCOPE("MapRenderer::render");
             commitPendingChanges();
             setupGL(renderBatch);
             renderDefaultOpaque(renderContext, renderBatch);
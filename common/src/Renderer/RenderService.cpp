@@ -42,7 +42,6 @@
 
 namespace TrenchBroom {
     namespace Renderer {
-        Renderer::FontDescriptor makeRenderServiceFont();
         Renderer::FontDescriptor makeRenderServiceFont() {
             return Renderer::FontDescriptor(pref(Preferences::RendererFontPath()), static_cast<size_t>(pref(Preferences::RendererFontSize)));
         }
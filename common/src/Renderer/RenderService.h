@@ -32,6 +32,7 @@
 namespace TrenchBroom {
     namespace Renderer {
         class AttrString;
+        class FontDescriptor;
         class PointHandleRenderer;
         class PrimitiveRenderer;
         enum class PrimitiveRendererCullingPolicy;
@@ -41,6 +42,11 @@ namespace TrenchBroom {
         class TextAnchor;
         class TextRenderer;
 
+        /**
+         * Returns the font used to render strings, as configured in the preferences.
+         */
+        FontDescriptor makeRenderServiceFont();
+
         class RenderService {
         private:
             using OcclusionPolicy = PrimitiveRendererOcclusionPolicy;
@@ -43,18 +43,30 @@ namespace TrenchBroom {
         const size_t TextRenderer::RectCornerSegments = 3;
         const float TextRenderer::RectCornerRadius = 3.0f;
 
-        TextRenderer::Entry::Entry(std::vector<vm::vec2f>& i_vertices, const vm::vec2f& i_size, const vm::vec3f& i_offset, const Color& i_textColor, const Color& i_backgroundColor) :
-        size(i_size),
+        TextRenderer::Entry::Entry(std::shared_ptr<const TextureFont::Layout> i_layout, const vm::vec3f& i_offset, const Color& i_textColor, const Color& i_backgroundColor) :
+        layout(std::move(i_layout)),
         offset(i_offset),
         textColor(i_textColor),
-        backgroundColor(i_backgroundColor) {
-            using std::swap;
-            swap(vertices, i_vertices);
+        backgroundColor(i_backgroundColor) {}
+
+        size_t TextRenderer::Entry::textVertexCount() const {
+            // the layout contains a position and texture coordinates for each vertex
+            return layout->vertices.size() / 2u;
+        }
+
+        bool TextRenderer::Entry::operator==(const Entry& other) const {
+            return layout == other.layout
+                && offset == other.offset
+                && textColor == other.textColor
+                && backgroundColor == other.backgroundColor;
+        }
+
+        bool TextRenderer::Entry::operator!=(const Entry& other) const {
+            return !(*this == other);
         }
 
         TextRenderer::EntryCollection::EntryCollection() :
-        textVertexCount(0),
-        rectVertexCount(0) {}
+        textVertexCount(0) {}
 
         TextRenderer::TextRenderer(const FontDescriptor& fontDescriptor, const float maxViewDistance, const float minZoomFactor, const vm::vec2f& inset) :
         m_fontDescriptor(fontDescriptor),
@@ -62,6 +74,15 @@ namespace TrenchBroom {
         m_minZoomFactor(minZoomFactor),
         m_inset(inset) {}
 
+        const FontDescriptor& TextRenderer::fontDescriptor() const {
+            return m_fontDescriptor;
+        }
+
+        bool TextRenderer::isInViewDistance(RenderContext& renderContext, const TextAnchor& position, const bool onTop) const {
+            const Camera& camera = renderContext.camera();
+            return isInViewDistance(renderContext, camera.perpendicularDistanceTo(position.position(camera)), onTop);
+        }
+
         void TextRenderer::renderString(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const AttrString& string, const TextAnchor& position) {
             renderString(renderContext, textColor, backgroundColor, string, position, false);
         }
@@ -74,31 +95,28 @@ namespace TrenchBroom {
 
             const Camera& camera = renderContext.camera();
             const float distance = camera.perpendicularDistanceTo(position.position(camera));
-            if (distance <= 0.0f)
-                return;
-
-            if (!isVisible(renderContext, string, position, distance, onTop))
+            if (!isInViewDistance(renderContext, distance, onTop))
                 return;
 
             FontManager& fontManager = renderContext.fontManager();
             TextureFont& font = fontManager.font(m_fontDescriptor);
 
-            std::vector<vm::vec2f> vertices = font.quads(string, true);
+            auto layout = font.layout(string);
+            if (!isVisible(renderContext, round(layout->size), position))
+                return;
+
             const float alphaFactor = computeAlphaFactor(renderContext, distance, onTop);
-            const vm::vec2f size = font.measure(string);
-            const vm::vec3f offset = position.offset(camera, size);
+            const vm::vec3f offset = position.offset(camera, layout->size);
 
-            if (onTop)
-                addEntry(m_entriesOnTop, Entry(vertices, size, offset,
-                                               Color(textColor, alphaFactor * textColor.a()),
-                                               Color(backgroundColor, alphaFactor * backgroundColor.a())));
-            else
-                addEntry(m_entries, Entry(vertices, size, offset,
-                                          Color(textColor, alphaFactor * textColor.a()),
-                                          Color(backgroundColor, alphaFactor * backgroundColor.a())));
+            addEntry(onTop ? m_entriesOnTop : m_entries, Entry(std::move(layout), offset,
+                                                               Color(textColor, alphaFactor * textColor.a()),
+                                                               Color(backgroundColor, alphaFactor * backgroundColor.a())));
         }
 
-        bool TextRenderer::isVisible(RenderContext& renderContext, const AttrString& string, const TextAnchor& position, const float distance, const bool onTop) const {
+        bool TextRenderer::isInViewDistance(RenderContext& renderContext, const float distance, const bool onTop) const {
+            if (distance <= 0.0f)
+                return false;
+
             if (!onTop) {
                 if (renderContext.render3D() && distance > m_maxViewDistance)
                     return false;
@@ -106,12 +124,15 @@ namespace TrenchBroom {
                     return false;
             }
 
+            return true;
+        }
+
+        bool TextRenderer::isVisible(RenderContext& renderContext, const vm::vec2f& stringSize, const TextAnchor& position) const {
             const Camera& camera = renderContext.camera();
             const Camera::Viewport& viewport = camera.viewport();
 
-            const vm::vec2f size = stringSize(renderContext, string);
-            const vm::vec2f offset = vm::vec2f(position.offset(camera, size)) - m_inset;
-            const vm::vec2f actualSize = size + 2.0f * m_inset;
+            const vm::vec2f offset = vm::vec2f(position.offset(camera, stringSize)) - m_inset;
+            const vm::vec2f actualSize = stringSize + 2.0f * m_inset;
 
             return viewport.contains(offset.x(), offset.y(), actualSize.x(), actualSize.y());
         }
@@ -134,44 +155,83 @@ namespace TrenchBroom {
             }
         }
 
-        void TextRenderer::addEntry(EntryCollection& collection, const Entry& entry) {
-            collection.entries.push_back(entry);
-            collection.textVertexCount += entry.vertices.size();
-            collection.rectVertexCount += roundedRect2DVertexCount(RectCornerSegments);
+        void TextRenderer::addEntry(EntryCollection& collection, Entry entry) {
+            collection.textVertexCount += entry.textVertexCount();
+            collection.entries.push_back(std::move(entry));
         }
 
-        vm::vec2f TextRenderer::stringSize(RenderContext& renderContext, const AttrString& string) const {
-            FontManager& fontManager = renderContext.fontManager();
-            TextureFont& font = fontManager.font(m_fontDescriptor);
-            return round(font.measure(string));
+        void TextRenderer::doPrepareVertices(VboManager& vboManager) {
+            prepare(m_entries, vboManager);
+            prepare(m_entriesOnTop, vboManager);
         }
 
-        void TextRenderer::doPrepareVertices(VboManager& vboManager) {
-            prepare(m_entries, false, vboManager);
-            prepare(m_entriesOnTop, true, vboManager);
+        void TextRenderer::prepare(EntryCollection& collection, VboManager& vboManager) {
+            if (updateVertices(collection) || !collection.textArray.prepared()) {
+                collection.textArray = VertexArray::ref(collection.textVertices);
+                collection.rectArray = VertexArray::ref(collection.rectVertices);
+
+                collection.textArray.prepare(vboManager);
+                collection.rectArray.prepare(vboManager);
+            }
+
+            using std::swap;
+            swap(collection.entries, collection.preparedEntries);
+            collection.entries.clear();
+            collection.textVertexCount = 0;
         }
 
-        void TextRenderer::prepare(EntryCollection& collection, const bool onTop, VboManager& vboManager) {
-            std::vector<TextVertex> textVertices;
-            textVertices.reserve(collection.textVertexCount);
+        /**
+         * Rewrites the vertices of the entries that differ from the prepared entries at the same index. Returns
+         * true if any vertex was changed.
+         */
+        bool TextRenderer::updateVertices(EntryCollection& collection) const {
+            if (collection.entries.size() != collection.preparedEntries.size()
+                || collection.textVertexCount != collection.textVertices.size()) {
+                rebuildVertices(collection);
+                return true;
+            }
+
+            const auto rectVertexCount = roundedRect2DVertexCount(RectCornerSegments);
+
+            bool changed = false;
+            size_t textIndex = 0;
+            for (size_t i = 0; i < collection.entries.size(); ++i) {
+                const Entry& entry = collection.entries[i];
+                const Entry& preparedEntry = collection.preparedEntries[i];
+
+                if (entry != preparedEntry) {
+                    if (entry.textVertexCount() != preparedEntry.textVertexCount()) {
+                        rebuildVertices(collection);
+                        return true;
+                    }
 
-            std::vector<RectVertex> rectVertices;
-            rectVertices.reserve(collection.rectVertexCount);
+                    writeVertices(entry, collection.textVertices, textIndex, collection.rectVertices, i * rectVertexCount);
+                    changed = true;
+                }
 
-            for (const Entry& entry : collection.entries) {
-                addEntry(entry, onTop, textVertices, rectVertices);
+                textIndex += entry.textVertexCount();
             }
 
-            collection.textArray = VertexArray::move(std::move(textVertices));
-            collection.rectArray = VertexArray::move(std::move(rectVertices));
+            return changed;
+        }
+
+        void TextRenderer::rebuildVertices(EntryCollection& collection) const {
+            const auto rectVertexCount = roundedRect2DVertexCount(RectCornerSegments);
 
-            collection.textArray.prepare(vboManager);
-            collection.rectArray.prepare(vboManager);
+            collection.textVertices.resize(collection.textVertexCount);
+            collection.rectVertices.resize(collection.entries.size() * rectVertexCount);
+
+            size_t textIndex = 0;
+            for (size_t i = 0; i < collection.entries.size(); ++i) {
+                const Entry& entry = collection.entries[i];
+                writeVertices(entry, collection.textVertices, textIndex, collection.rectVertices, i * rectVertexCount);
+                textIndex += entry.textVertexCount();
+            }
         }
 
-        void TextRenderer::addEntry(const Entry& entry, const bool /* onTop */, std::vector<TextVertex>& textVertices, std::vector<RectVertex>& rectVertices) {
-            const std::vector<vm::vec2f>& stringVertices = entry.vertices;
-            const vm::vec2f& stringSize = entry.size;
+        void TextRenderer::writeVertices(const Entry& entry, std::vector<TextVertex>& textVertices, const size_t textIndex, std::vector<RectVertex>& rectVertices, const size_t rectIndex) const {
+            const std::vector<vm::vec2f>& stringVertices = entry.layout->vertices;
+            const vm::vec2f& stringSize = entry.layout->size;
 
             const vm::vec3f& offset = entry.offset;
 
@@ -181,13 +241,13 @@ namespace TrenchBroom {
             for (size_t i = 0; i < stringVertices.size() / 2; ++i) {
                 const vm::vec2f& position2 = stringVertices[2 * i];
                 const vm::vec2f& texCoords = stringVertices[2 * i + 1];
-                textVertices.emplace_back(vm::vec3f(position2 + offset.xy(), -offset.z()), texCoords, textColor);
+                textVertices[textIndex + i] = TextVertex(vm::vec3f(position2 + offset.xy(), -offset.z()), texCoords, textColor);
             }
 
             const std::vector<vm::vec2f> rect = roundedRect2D(stringSize + 2.0f * m_inset, RectCornerRadius, RectCornerSegments);
             for (size_t i = 0; i < rect.size(); ++i) {
                 const vm::vec2f& vertex = rect[i];
-                rectVertices.emplace_back(vm::vec3f(vertex + offset.xy() + stringSize / 2.0f, -offset.z()), rectColor);
+                rectVertices[rectIndex + i] = RectVertex(vm::vec3f(vertex + offset.xy() + stringSize / 2.0f, -offset.z()), rectColor);
             }
         }
 
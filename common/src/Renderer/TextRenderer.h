@@ -22,12 +22,14 @@
 #include "Color.h"
 #include "Renderer/FontDescriptor.h"
 #include "Renderer/Renderable.h"
+#include "Renderer/TextureFont.h"
 #include "Renderer/VertexArray.h"
 #include "Renderer/GLVertexType.h"
 
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
 
+#include <memory>
 #include <vector>
 
 namespace TrenchBroom {
@@ -45,21 +47,35 @@ namespace TrenchBroom {
             static const float RectCornerRadius;
 
             struct Entry {
-                std::vector<vm::vec2f> vertices;
-                vm::vec2f size;
+                std::shared_ptr<const TextureFont::Layout> layout;
                 vm::vec3f offset;
                 Color textColor;
                 Color backgroundColor;
 
-                Entry(std::vector<vm::vec2f>& i_vertices, const vm::vec2f& i_size, const vm::vec3f& i_offset, const Color& i_textColor, const Color& i_backgroundColor);
+                Entry(std::shared_ptr<const TextureFont::Layout> i_layout, const vm::vec3f& i_offset, const Color& i_textColor, const Color& i_backgroundColor);
+
+                size_t textVertexCount() const;
+
+                bool operator==(const Entry& other) const;
+                bool operator!=(const Entry& other) const;
             };
 
             using EntryList = std::vector<Entry>;
+            using TextVertex = GLVertexTypes::P3T2C4::Vertex;
+            using RectVertex = GLVertexTypes::P3C4::Vertex;
 
+            /**
+             * The entries added since the last frame and the entries whose vertices were uploaded last. The vertices
+             * are kept between frames so that if a text renderer is reused, only the vertices of the entries that
+             * changed are rewritten, and nothing is uploaded if no entry changed.
+             */
             struct EntryCollection {
                 EntryList entries;
+                EntryList preparedEntries;
                 size_t textVertexCount;
-                size_t rectVertexCount;
+
+                std::vector<TextVertex> textVertices;
+                std::vector<RectVertex> rectVertices;
 
                 VertexArray textArray;
                 VertexArray rectArray;
@@ -67,9 +83,6 @@ namespace TrenchBroom {
                 EntryCollection();
             };
 
-            using TextVertex = GLVertexTypes::P3T2C4::Vertex;
-            using RectVertex = GLVertexTypes::P3C4::Vertex;
-
             FontDescriptor m_fontDescriptor;
             float m_maxViewDistance;
             float m_minZoomFactor;
@@ -80,27 +93,35 @@ namespace TrenchBroom {
         public:
             explicit TextRenderer(const FontDescriptor& fontDescriptor, float maxViewDistance = DefaultMaxViewDistance, float minZoomFactor = DefaultMinZoomFactor, const vm::vec2f& inset = DefaultInset);
 
+            const FontDescriptor& fontDescriptor() const;
+
+            /**
+             * Indicates whether a string at the given position is close enough to the camera to be rendered. Callers
+             * can use this to skip building strings that would be culled anyway.
+             */
+            bool isInViewDistance(RenderContext& renderContext, const TextAnchor& position, bool onTop) const;
+
             void renderString(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const AttrString& string, const TextAnchor& position);
             void renderStringOnTop(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const AttrString& string, const TextAnchor& position);
+
+            deleteCopyAndMove(TextRenderer)
         private:
             void renderString(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const AttrString& string, const TextAnchor& position, bool onTop);
 
-            bool isVisible(RenderContext& renderContext, const AttrString& string, const TextAnchor& position, float distance, bool onTop) const;
+            bool isInViewDistance(RenderContext& renderContext, float distance, bool onTop) const;
+            bool isVisible(RenderContext& renderContext, const vm::vec2f& stringSize, const TextAnchor& position) const;
             float computeAlphaFactor(const RenderContext& renderContext, float distance, bool onTop) const;
-            void addEntry(EntryCollection& collection, const Entry& entry);
-
-            vm::vec2f stringSize(RenderContext& renderContext, const AttrString& string) const;
+            void addEntry(EntryCollection& collection, Entry entry);
         private:
             void doPrepareVertices(VboManager& vboManager) override;
-            void prepare(EntryCollection& collection, bool onTop, VboManager& vboManager);
+            void prepare(EntryCollection& collection, VboManager& vboManager);
 
-            void addEntry(const Entry& entry, bool onTop, std::vector<TextVertex>& textVertices, std::vector<RectVertex>& rectVertices);
+            bool updateVertices(EntryCollection& collection) const;
+            void rebuildVertices(EntryCollection& collection) const;
+            void writeVertices(const Entry& entry, std::vector<TextVertex>& textVertices, size_t textIndex, std::vector<RectVertex>& rectVertices, size_t rectIndex) const;
 
             void doRender(RenderContext& renderContext) override;
             void render(EntryCollection& collection, RenderContext& renderContext);
-
-            void clear();
         };
     }
 }
-
@@ -32,6 +32,8 @@
 
 namespace TrenchBroom {
     namespace Renderer {
+        const size_t TextureFont::MaxCachedLayouts = 4096;
+
         TextureFont::TextureFont(std::unique_ptr<FontTexture> texture, const std::vector<FontGlyph>& glyphs, const int lineHeight, const unsigned char firstChar, const unsigned char charCount) :
         m_texture(std::move(texture)),
         m_glyphs(glyphs),
@@ -227,6 +229,21 @@ namespace TrenchBroom {
             return result;
         }
 
+        std::shared_ptr<const TextureFont::Layout> TextureFont::layout(const AttrString& string) {
+            const auto it = m_layoutCache.find(string);
+            if (it != std::end(m_layoutCache)) {
+                return it->second;
+            }
+
+            if (m_layoutCache.size() >= MaxCachedLayouts) {
+                m_layoutCache.clear();
+            }
+
+            auto result = std::make_shared<const Layout>(Layout{quads(string, true), measure(string)});
+            m_layoutCache.emplace(string, result);
+            return result;
+        }
+
         void TextureFont::activate() {
             m_texture->activate();
         }
@@ -20,28 +20,41 @@
 #pragma once
 
 #include "Macros.h"
+#include "Renderer/AttrString.h"
 
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
 namespace TrenchBroom {
     namespace Renderer {
-        class AttrString;
         class FontGlyph;
         class FontTexture;
 
         class TextureFont {
+        public:
+            /**
+             * The clockwise glyph quads of a string and its size.
+             */
+            struct Layout {
+                std::vector<vm::vec2f> vertices;
+                vm::vec2f size;
+            };
         private:
+            static const size_t MaxCachedLayouts;
+
             std::unique_ptr<FontTexture> m_texture;
             std::vector<FontGlyph> m_glyphs;
             int m_lineHeight;
 
             unsigned char m_firstChar;
             unsigned char m_charCount;
+
+            std::map<AttrString, std::shared_ptr<const Layout>> m_layoutCache;
         public:
             TextureFont(std::unique_ptr<FontTexture> texture, const std::vector<FontGlyph>& glyphs, int lineHeight, unsigned char firstChar, unsigned char charCount);
             ~TextureFont();
@@ -54,6 +67,12 @@ namespace TrenchBroom {
             std::vector<vm::vec2f> quads(const std::string& string, bool clockwise, const vm::vec2f& offset = vm::vec2f::zero()) const;
             vm::vec2f measure(const std::string& string) const;
 
+            /**
+             * Returns the layout of the given string. Layouts are cached per string so that labels which are shown
+             * every frame are only laid out once. The cache is cleared when it grows too large.
+             */
+            std::shared_ptr<const Layout> layout(const AttrString& string);
+
             void activate();
             void deactivate();
         };
@@ -124,6 +124,21 @@ namespace TrenchBroom {
             }
         }
 
+        void TexturedIndexRangeMap::renderInstances(VertexArray& vertexArray, const size_t instanceCount, const std::function<void(size_t)>& setupInstance) {
+            DefaultTextureRenderFunc func;
+            for (const auto& entry : *m_data) {
+                const auto* texture = entry.first;
+                const auto& indexArray = entry.second;
+
+                func.before(texture);
+                for (size_t i = 0; i < instanceCount; ++i) {
+                    setupInstance(i);
+                    indexArray.render(vertexArray);
+                }
+                func.after(texture);
+            }
+        }
+
         void TexturedIndexRangeMap::forEachPrimitive(std::function<void(const Texture*, PrimType, size_t, size_t)> func) const {
             for (const auto& entry : *m_data) {
                 const auto* texture = entry.first;
@@ -21,6 +21,7 @@
 
 #include "Renderer/IndexRangeMap.h"
 
+#include <functional>
 #include <map>
 
 namespace TrenchBroom {
@@ -168,6 +169,18 @@ namespace TrenchBroom {
              */
             void render(VertexArray& vertexArray, TextureRenderFunc& func);
 
+            /**
+             * Renders the primitives stored in this index range map once for each of the given number of instances
+             * using the vertices in the given vertex array. Each texture is activated only once for all instances, and
+             * the given function is called with the index of an instance before the primitives of that instance are
+             * rendered.
+             *
+             * @param vertexArray the vertex array to render with
+             * @param instanceCount the number of instances to render
+             * @param setupInstance called with the index of each instance before it is rendered
+             */
+            void renderInstances(VertexArray& vertexArray, size_t instanceCount, const std::function<void(size_t)>& setupInstance);
+
             /**
              * Invokes the given function for each primitive stored in this map.
              *
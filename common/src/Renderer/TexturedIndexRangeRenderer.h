@@ -22,6 +22,7 @@
 #include "Renderer/TexturedIndexRangeMap.h"
 #include "Renderer/VertexArray.h"
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -43,6 +44,13 @@ namespace TrenchBroom {
             virtual void prepare(VboManager& vboManager) = 0;
             virtual void render() = 0;
             virtual void render(TextureRenderFunc& func) = 0;
+
+            /**
+             * Renders the given number of instances, setting up the vertex arrays and textures only once. The given
+             * function is called with the index of each instance before it is rendered and must set up the instance's
+             * transformation.
+             */
+            virtual void renderInstances(size_t instanceCount, const std::function<void(size_t)>& setupInstance) = 0;
         };
 
         class TexturedIndexRangeRenderer : public TexturedRenderer {
@@ -60,6 +68,7 @@ namespace TrenchBroom {
             void prepare(VboManager& vboManager) override;
             void render() override;
             void render(TextureRenderFunc& func) override;
+            void renderInstances(size_t instanceCount, const std::function<void(size_t)>& setupInstance) override;
         };
 
         class MultiTexturedIndexRangeRenderer : public TexturedRenderer {
@@ -74,6 +83,7 @@ namespace TrenchBroom {
             void prepare(VboManager& vboManager) override;
             void render() override;
             void render(TextureRenderFunc& func) override;
+            void renderInstances(size_t instanceCount, const std::function<void(size_t)>& setupInstance) override;
         };
     }
 }
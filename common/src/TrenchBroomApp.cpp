@@ -19,8 +19,10 @@
 
 #include "TrenchBroomApp.h"
 
+#include "FileLogger.h"
 #include "PreferenceManager.h"
 #include "Preferences.h"
+#include "Profiler.h"
 #include "RecoverableExceptions.h"
 #include "TrenchBroomStackWalker.h"
 #include "IO/IOUtils.h"
@@ -51,6 +53,7 @@
 #include <kdl/set_temp.h>
 #include <kdl/string_utils.h>
 
+#include <chrono>
 #include <clocale>
 #include <csignal>
 #include <cstdlib>
@@ -160,7 +163,13 @@ namespace TrenchBroom {
         }
 
         // must be implemented in cpp file in order to use std::unique_ptr with forward declared type as members
-        TrenchBroomApp::~TrenchBroomApp() = default;
+        TrenchBroomApp::~TrenchBroomApp() {
+#ifdef TB_ENABLE_PROFILING
+            const IO::Path tracePath(IO::SystemPaths::userDataDirectory() + IO::Path("trace.json"));
+            std::ofstream traceStream = openPathAsOutputStream(tracePath);
+            Profiler::writeTrace(traceStream);
+#endif
+        }
 
         void TrenchBroomApp::parseCommandLineAndShowFrame() {
             QCommandLineParser parser;
@@ -500,7 +509,10 @@ namespace TrenchBroom {
                 mapPath = IO::Path();
             }
 
-            // Copy the log file
+            // Copy the log file, possibly without the last buffered messages if the log file is locked by a thread that
+            // does not release it
+            using namespace std::chrono_literals;
+            FileLogger::instance().tryFlush(500ms);
             if (!QFile::copy(IO::pathAsQString(IO::SystemPaths::logFilePath()), QString::fromStdString(logPath.asString()))) {
                 logPath = IO::Path();
             }
@@ -21,6 +21,7 @@
 
 #include "Ensure.h"
 #include "Macros.h"
+#include "Model/ModelUtils.h"
 #include "Model/Node.h"
 #include "View/MapDocumentCommandFacade.h"
 
@@ -67,6 +68,21 @@ namespace TrenchBroom {
             }
         }
 
+        size_t AddRemoveNodesCommand::memorySize() const {
+            size_t result = DocumentCommand::memorySize();
+
+            // the nodes to add are owned by this command while they are not in the document
+            for (const auto& entry : m_nodesToAdd) {
+                for (const auto* child : entry.second) {
+                    result += sizeof(child) + Model::estimateMemorySize(child);
+                }
+            }
+            for (const auto& entry : m_nodesToRemove) {
+                result += entry.second.size() * sizeof(Model::Node*);
+            }
+            return result;
+        }
+
         std::string AddRemoveNodesCommand::makeName(const Action action) {
             switch (action) {
                 case Action::Add:
@@ -51,6 +51,8 @@ namespace TrenchBroom {
 
             AddRemoveNodesCommand(Action action, const std::map<Model::Node*, std::vector<Model::Node*>>& nodes);
             ~AddRemoveNodesCommand() override;
+
+            size_t memorySize() const override;
         private:
             static std::string makeName(Action action);
 
@@ -0,0 +1,264 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AutosaveJournal.h"
+
+#include "Exceptions.h"
+#include "Logger.h"
+#include "IO/DiskIO.h"
+#include "IO/File.h"
+#include "IO/NodeReader.h"
+#include "IO/NodeWriter.h"
+#include "IO/Path.h"
+#include "IO/Reader.h"
+#include "IO/SimpleParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/BrushNode.h"
+#include "Model/Entity.h"
+#include "Model/EntityNode.h"
+#include "Model/EntityProperties.h"
+#include "Model/Layer.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/WorldNode.h"
+
+#include <kdl/string_utils.h>
+#include <kdl/vector_utils.h>
+
+#include <cassert>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+
+namespace TrenchBroom {
+    namespace View {
+        static const std::string JournalHeader = "TrenchBroom autosave journal 1";
+        static const std::string DefaultLayerToken = "default";
+
+        std::vector<Model::Node*> collectJournalObjects(Model::WorldNode& world) {
+            std::vector<Model::Node*> result;
+            for (auto* layer : world.allLayers()) {
+                // the brushes of a layer are written before its other objects
+                for (auto* child : layer->children()) {
+                    if (dynamic_cast<Model::BrushNode*>(child) != nullptr) {
+                        result.push_back(child);
+                    }
+                }
+                for (auto* child : layer->children()) {
+                    if (dynamic_cast<Model::BrushNode*>(child) == nullptr) {
+                        result.push_back(child);
+                    }
+                }
+            }
+            return result;
+        }
+
+        std::optional<Model::IdType> journalLayerId(const Model::LayerNode& layer) {
+            if (layer.layer().defaultLayer()) {
+                return std::nullopt;
+            }
+            return layer.persistentId();
+        }
+
+        void writeAutosaveJournalHeader(std::ostream& stream, const std::string& backupFilename, const size_t objectCount) {
+            stream << JournalHeader << "\n";
+            stream << "base " << objectCount << " " << backupFilename << "\n";
+        }
+
+        void writeAutosaveJournalEntry(std::ostream& stream, const Model::WorldNode& updatedObjects, const std::vector<size_t>& removedObjectIds, const std::vector<AutosaveJournalUpdate>& updates) {
+            const auto& objects = updatedObjects.defaultLayer()->children();
+            assert(objects.size() == updates.size());
+
+            stream << "entry " << removedObjectIds.size() << " " << updates.size() << "\n";
+            for (const auto objectId : removedObjectIds) {
+                stream << "remove " << objectId << "\n";
+            }
+
+            for (size_t i = 0u; i < updates.size(); ++i) {
+                const auto& update = updates[i];
+
+                std::stringstream objectStream;
+                IO::NodeWriter writer(updatedObjects, objectStream);
+                writer.writeNodes({ objects[i] });
+
+                const auto contents = objectStream.str();
+                const auto layerToken = update.layerId ? kdl::str_to_string(*update.layerId) : DefaultLayerToken;
+                stream << "update " << update.objectId << " " << layerToken << " " << contents.size() << "\n";
+                stream << contents << "\n";
+            }
+
+            stream << "end\n";
+        }
+
+        struct AutosaveJournalEntry {
+            std::vector<size_t> removedObjectIds;
+            std::vector<std::pair<AutosaveJournalUpdate, std::string>> updates;
+        };
+
+        /**
+         * Returns nothing if the stream is exhausted or if the entry was not written completely.
+         */
+        static std::optional<AutosaveJournalEntry> readJournalEntry(std::istream& stream) {
+            std::string token;
+            size_t removedCount, updateCount;
+            if (!(stream >> token >> removedCount >> updateCount) || token != "entry") {
+                return std::nullopt;
+            }
+
+            AutosaveJournalEntry entry;
+            for (size_t i = 0u; i < removedCount; ++i) {
+                size_t objectId;
+                if (!(stream >> token >> objectId) || token != "remove") {
+                    return std::nullopt;
+                }
+                entry.removedObjectIds.push_back(objectId);
+            }
+
+            for (size_t i = 0u; i < updateCount; ++i) {
+                size_t objectId, size;
+                std::string layerToken;
+                if (!(stream >> token >> objectId >> layerToken >> size) || token != "update") {
+                    return std::nullopt;
+                }
+
+                // skip the line break after the size
+                stream.get();
+
+                std::string contents(size, '\0');
+                if (!stream.read(contents.data(), static_cast<std::streamsize>(size))) {
+                    return std::nullopt;
+                }
+
+                const auto layerId = layerToken == DefaultLayerToken ? std::nullopt : kdl::str_to_size(layerToken);
+                entry.updates.emplace_back(AutosaveJournalUpdate{objectId, layerId}, std::move(contents));
+            }
+
+            if (!(stream >> token) || token != "end") {
+                return std::nullopt;
+            }
+            return entry;
+        }
+
+        static void removeJournalObject(std::unordered_map<size_t, Model::Node*>& objectsById, const size_t objectId) {
+            if (auto it = objectsById.find(objectId); it != std::end(objectsById)) {
+                auto* node = it->second;
+                node->parent()->removeChild(node);
+                delete node;
+                objectsById.erase(it);
+            }
+        }
+
+        static Model::Node* readJournalObject(const std::string& contents, const Model::MapFormat mapFormat, const vm::bbox3& worldBounds) {
+            NullLogger logger;
+            IO::SimpleParserStatus status(logger);
+            auto nodes = IO::NodeReader::readAsFormat(mapFormat, mapFormat, contents, worldBounds, status);
+
+            // world brushes are read as the children of a worldspawn entity
+            if (nodes.size() == 1u) {
+                if (auto* entityNode = dynamic_cast<Model::EntityNode*>(nodes.front())) {
+                    const auto& entity = entityNode->entity();
+                    if (Model::isWorldspawn(entity.classname(), entity.properties())) {
+                        nodes = entityNode->children();
+                        for (auto* child : nodes) {
+                            entityNode->removeChild(child);
+                        }
+                        delete entityNode;
+                    }
+                }
+            }
+
+            if (nodes.size() != 1u) {
+                kdl::vec_clear_and_delete(nodes);
+                throw FileSystemException("Autosave journal contains an invalid object");
+            }
+            return nodes.front();
+        }
+
+        static std::unique_ptr<Model::WorldNode> readBackup(const IO::Path& path, const Model::MapFormat mapFormat, const vm::bbox3& worldBounds, Logger& logger) {
+            IO::SimpleParserStatus status(logger);
+            auto file = IO::Disk::openFile(IO::Disk::fixPath(path));
+            auto fileReader = file->reader().buffer();
+            IO::WorldReader worldReader(fileReader.stringView(), mapFormat);
+            return worldReader.read(worldBounds, status);
+        }
+
+        std::unique_ptr<Model::WorldNode> replayAutosaveJournal(std::istream& stream, const IO::Path& backupDirectory, const Model::MapFormat mapFormat, const vm::bbox3& worldBounds, Logger& logger) {
+            std::string header;
+            if (!std::getline(stream, header) || header != JournalHeader) {
+                throw FileSystemException("Autosave journal has an invalid header");
+            }
+
+            std::string token;
+            size_t objectCount;
+            std::string backupFilename;
+            if (!(stream >> token >> objectCount) || token != "base" || !std::getline(stream >> std::ws, backupFilename)) {
+                throw FileSystemException("Autosave journal does not refer to a backup");
+            }
+
+            auto world = readBackup(backupDirectory + IO::Path(backupFilename), mapFormat, worldBounds, logger);
+
+            const auto objects = collectJournalObjects(*world);
+            if (objects.size() != objectCount) {
+                throw FileSystemException("Autosave journal does not match backup " + backupFilename);
+            }
+
+            std::unordered_map<size_t, Model::Node*> objectsById;
+            for (size_t i = 0u; i < objects.size(); ++i) {
+                objectsById[i] = objects[i];
+            }
+
+            std::unordered_map<Model::IdType, Model::LayerNode*> layersById;
+            for (auto* layer : world->customLayers()) {
+                if (const auto& layerId = layer->persistentId()) {
+                    layersById[*layerId] = layer;
+                }
+            }
+
+            world->disableNodeTreeUpdates();
+            while (const auto entry = readJournalEntry(stream)) {
+                for (const auto objectId : entry->removedObjectIds) {
+                    removeJournalObject(objectsById, objectId);
+                }
+
+                for (const auto& [update, contents] : entry->updates) {
+                    auto* layer = world->defaultLayer();
+                    if (update.layerId) {
+                        const auto it = layersById.find(*update.layerId);
+                        if (it == std::end(layersById)) {
+                            throw FileSystemException("Autosave journal refers to an unknown layer");
+                        }
+                        layer = it->second;
+                    }
+
+                    removeJournalObject(objectsById, update.objectId);
+
+                    auto* node = readJournalObject(contents, mapFormat, worldBounds);
+                    layer->addChild(node);
+                    objectsById[update.objectId] = node;
+                }
+            }
+            world->enableNodeTreeUpdates();
+            world->rebuildNodeTree();
+
+            return world;
+        }
+    }
+}
@@ -0,0 +1,97 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "FloatType.h"
+#include "Model/IdType.h"
+
+#include <vecmath/forward.h>
+
+#include <iosfwd>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    class Logger;
+
+    namespace IO {
+        class Path;
+    }
+
+    namespace Model {
+        class LayerNode;
+        class Node;
+        class WorldNode;
+        enum class MapFormat;
+    }
+
+    namespace View {
+        /**
+         * An autosave journal records the changes made to a map since its last full backup, so that an autosave
+         * only needs to write the objects that have changed.
+         *
+         * The objects of a map are the children of its layers. The journal refers to them by IDs. When a full backup
+         * is written, its objects are numbered in the order in which they appear in the backup file, so that they
+         * can be identified again when the backup is read. Objects that are added later receive new IDs.
+         *
+         * Each journal entry lists the IDs of the removed objects and the IDs, layers and contents of the objects
+         * that were added or changed. Entries are terminated by a marker, so an entry that was only partially
+         * written because of a crash is ignored when the journal is replayed.
+         */
+
+        /**
+         * Returns the objects of the given world in the order in which they are written to a map file.
+         */
+        std::vector<Model::Node*> collectJournalObjects(Model::WorldNode& world);
+
+        /**
+         * Returns the ID by which the journal refers to the given layer, or nothing for the default layer.
+         */
+        std::optional<Model::IdType> journalLayerId(const Model::LayerNode& layer);
+
+        struct AutosaveJournalUpdate {
+            size_t objectId;
+            std::optional<Model::IdType> layerId;
+        };
+
+        /**
+         * Writes the header of a journal that refers to the backup with the given file name containing the given
+         * number of objects.
+         */
+        void writeAutosaveJournalHeader(std::ostream& stream, const std::string& backupFilename, size_t objectCount);
+
+        /**
+         * Writes a journal entry. The updated objects are the children of the default layer of the given world, in
+         * the same order as the given updates.
+         */
+        void writeAutosaveJournalEntry(std::ostream& stream, const Model::WorldNode& updatedObjects, const std::vector<size_t>& removedObjectIds, const std::vector<AutosaveJournalUpdate>& updates);
+
+        /**
+         * Reads the backup that the given journal refers to from the given directory and applies all complete
+         * entries of the journal to it.
+         *
+         * @throws FileSystemException if the journal is malformed or does not match its backup
+         * @throws ParserException if the backup cannot be parsed
+         */
+        std::unique_ptr<Model::WorldNode> replayAutosaveJournal(std::istream& stream, const IO::Path& backupDirectory, Model::MapFormat mapFormat, const vm::bbox3& worldBounds, Logger& logger);
+    }
+}
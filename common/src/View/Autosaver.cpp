@@ -20,19 +20,45 @@
 #include "Autosaver.h"
 
 #include "Exceptions.h"
+#include "Logger.h"
 #include "IO/DiskFileSystem.h"
 #include "IO/DiskIO.h"
+#include "IO/IOUtils.h"
+#include "IO/PathQt.h"
+#include "Model/Brush.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushNode.h"
+#include "Model/Entity.h"
+#include "Model/EntityNode.h"
+#include "Model/Game.h"
+#include "Model/GroupNode.h"
+#include "Model/Layer.h"
+#include "Model/LayerNode.h"
+#include "Model/LockState.h"
+#include "Model/MapFormat.h"
+#include "Model/VisibilityState.h"
+#include "Model/WorldNode.h"
+#include "View/AutosaveJournal.h"
 #include "View/MapDocument.h"
 
 #include <kdl/memory_utils.h>
+#include <kdl/overload.h>
 #include <kdl/string_compare.h>
 #include <kdl/string_format.h>
 #include <kdl/string_utils.h>
 
 #include <algorithm> // for std::sort
 #include <cassert>
+#include <fstream>
 #include <limits>
 #include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
 
 namespace TrenchBroom {
     namespace View {
@@ -62,14 +88,37 @@ namespace TrenchBroom {
             return backupNo > 0u;
         }
 
-        Autosaver::Autosaver(std::weak_ptr<MapDocument> document, const std::chrono::milliseconds saveInterval, const size_t maxBackups) :
+        Autosaver::Autosaver(std::weak_ptr<MapDocument> document, const std::chrono::milliseconds saveInterval, const size_t maxBackups, const size_t maxJournalEntries) :
         m_document(document),
         m_saveInterval(saveInterval),
         m_maxBackups(maxBackups),
         m_lastSaveTime(Clock::now()),
-        m_lastModificationCount(kdl::mem_lock(m_document)->modificationCount()) {}
+        m_lastModificationCount(kdl::mem_lock(m_document)->modificationCount()),
+        m_maxJournalEntries(maxJournalEntries),
+        m_journalRecoveryPending(maxJournalEntries > 0u),
+        m_journalValid(false),
+        m_journalEntryCount(0u),
+        m_backupSize(0u),
+        m_journalSize(0u),
+        m_nextJournalObjectId(0u) {
+            if (m_maxJournalEntries > 0u) {
+                bindObservers();
+            }
+        }
+
+        Autosaver::~Autosaver() {
+            if (m_maxJournalEntries > 0u) {
+                unbindObservers();
+            }
+            if (m_pendingSave.valid()) {
+                m_pendingSave.wait();
+            }
+            deleteRedundantJournal();
+        }
 
         void Autosaver::triggerAutosave(Logger& logger) {
+            logPendingSaveResult(logger);
+
             if (kdl::mem_expired(m_document)) {
                 return;
             }
@@ -77,6 +126,19 @@ namespace TrenchBroom {
             const auto currentTime = Clock::now();
 
             auto document = kdl::mem_lock(m_document);
+            const auto documentPath = document->path();
+            if (!documentPath.isAbsolute()) {
+                return;
+            }
+            if (!IO::Disk::fileExists(IO::Disk::fixPath(document->path()))) {
+                return;
+            }
+
+            if (m_journalRecoveryPending) {
+                m_journalRecoveryPending = false;
+                startJournalRecovery(document);
+            }
+
             if (!document->modified()) {
                 return;
             }
@@ -87,47 +149,509 @@ namespace TrenchBroom {
                 return;
             }
 
-            const auto documentPath = document->path();
-            if (!documentPath.isAbsolute()) {
+            autosave(logger, document);
+        }
+
+        void Autosaver::waitForPendingSave(Logger& logger) {
+            if (m_pendingSave.valid()) {
+                m_pendingSave.wait();
+                logPendingSaveResult(logger);
+            }
+        }
+
+        void Autosaver::bindObservers() {
+            auto document = kdl::mem_lock(m_document);
+            document->nodesWereAddedNotifier.addObserver(this, &Autosaver::nodesWereAdded);
+            document->nodesWillBeRemovedNotifier.addObserver(this, &Autosaver::nodesWillBeRemoved);
+            document->nodesDidChangeNotifier.addObserver(this, &Autosaver::nodesDidChange);
+            document->documentWasClearedNotifier.addObserver(this, &Autosaver::documentWasCleared);
+        }
+
+        void Autosaver::unbindObservers() {
+            if (!kdl::mem_expired(m_document)) {
+                auto document = kdl::mem_lock(m_document);
+                document->nodesWereAddedNotifier.removeObserver(this, &Autosaver::nodesWereAdded);
+                document->nodesWillBeRemovedNotifier.removeObserver(this, &Autosaver::nodesWillBeRemoved);
+                document->nodesDidChangeNotifier.removeObserver(this, &Autosaver::nodesDidChange);
+                document->documentWasClearedNotifier.removeObserver(this, &Autosaver::documentWasCleared);
+            }
+        }
+
+        /**
+         * Returns the object that contains the given node, that is, the node itself or its ancestor which is a child
+         * of a layer. Returns null for worlds and layers.
+         */
+        static Model::Node* findJournalObject(Model::Node* node) {
+            while (node->parent() != nullptr) {
+                if (dynamic_cast<Model::LayerNode*>(node->parent()) != nullptr) {
+                    return node;
+                }
+                node = node->parent();
+            }
+            return nullptr;
+        }
+
+        void Autosaver::nodesWereAdded(const std::vector<Model::Node*>& nodes) {
+            for (auto* node : nodes) {
+                if (auto* object = findJournalObject(node)) {
+                    m_changedJournalObjects.insert(object);
+                }
+            }
+        }
+
+        void Autosaver::nodesWillBeRemoved(const std::vector<Model::Node*>& nodes) {
+            // the objects of a removed layer cannot be tracked anymore
+            for (const auto* node : nodes) {
+                if (dynamic_cast<const Model::LayerNode*>(node) != nullptr) {
+                    invalidateJournal();
+                    return;
+                }
+            }
+
+            // the objects which contain removed nodes have changed, unless they are removed, too
+            for (auto* node : nodes) {
+                auto* object = findJournalObject(node);
+                if (object != nullptr && object != node) {
+                    m_changedJournalObjects.insert(object);
+                }
+            }
+
+            for (auto* node : nodes) {
+                if (findJournalObject(node) == node) {
+                    m_changedJournalObjects.erase(node);
+                    if (const auto it = m_journalObjectIds.find(node); it != std::end(m_journalObjectIds)) {
+                        m_removedJournalObjectIds.push_back(it->second);
+                        m_journalObjectIds.erase(it);
+                    }
+                }
+            }
+        }
+
+        void Autosaver::nodesDidChange(const std::vector<Model::Node*>& nodes) {
+            nodesWereAdded(nodes);
+        }
+
+        void Autosaver::documentWasCleared(MapDocument*) {
+            invalidateJournal();
+        }
+
+        void Autosaver::invalidateJournal() {
+            m_journalValid = false;
+            m_journalObjectIds.clear();
+            m_changedJournalObjects.clear();
+            m_removedJournalObjectIds.clear();
+        }
+
+        /**
+         * The snapshot functions copy the contents of the nodes without the assets they refer to. The usage counts
+         * of the assets are not thread safe, and the assets are not needed to write a map file.
+         */
+        static Model::Entity snapshotEntity(Model::Entity entity) {
+            entity.setDefinition(nullptr);
+            entity.setModel(nullptr);
+            return entity;
+        }
+
+        static Model::Brush snapshotBrush(Model::Brush brush) {
+            for (auto& face : brush.faces()) {
+                face.setTexture(nullptr);
+            }
+            return brush;
+        }
+
+        static Model::Node* snapshotNode(const Model::Node& node);
+
+        static void snapshotChildren(const Model::Node& source, Model::Node& target) {
+            for (const auto* child : source.children()) {
+                target.addChild(snapshotNode(*child));
+            }
+        }
+
+        static Model::Node* snapshotNode(const Model::Node& node) {
+            auto* result = node.accept(kdl::overload(
+                [](const Model::WorldNode*) -> Model::Node* { return nullptr; },
+                [](const Model::LayerNode* layerNode) -> Model::Node* {
+                    auto* layerSnapshot = new Model::LayerNode(layerNode->layer());
+                    if (const auto& persistentId = layerNode->persistentId()) {
+                        layerSnapshot->setPersistentId(*persistentId);
+                    }
+                    return layerSnapshot;
+                },
+                [](const Model::GroupNode* groupNode) -> Model::Node* {
+                    auto* groupSnapshot = new Model::GroupNode(groupNode->group());
+                    if (const auto& persistentId = groupNode->persistentId()) {
+                        groupSnapshot->setPersistentId(*persistentId);
+                    }
+                    return groupSnapshot;
+                },
+                [](const Model::EntityNode* entityNode) -> Model::Node* { return new Model::EntityNode(snapshotEntity(entityNode->entity())); },
+                [](const Model::BrushNode* brushNode)   -> Model::Node* { return new Model::BrushNode(snapshotBrush(brushNode->brush())); }
+            ));
+            assert(result != nullptr);
+
+            result->setLockState(node.lockState());
+            result->setVisibilityState(node.visibilityState());
+            snapshotChildren(node, *result);
+            return result;
+        }
+
+        /**
+         * Creates a copy of the given world that can be written on another thread while the original is being
+         * edited. Unlike cloning, the copy retains the persistent IDs of the layers and groups and the properties of
+         * the default layer.
+         */
+        static std::unique_ptr<Model::WorldNode> snapshotWorld(const Model::WorldNode& world) {
+            auto result = std::make_unique<Model::WorldNode>(snapshotEntity(world.entity()), world.mapFormat());
+            result->disableNodeTreeUpdates();
+
+            const auto* defaultLayer = world.defaultLayer();
+            auto* defaultLayerSnapshot = result->defaultLayer();
+            defaultLayerSnapshot->setLayer(defaultLayer->layer());
+            defaultLayerSnapshot->setLockState(defaultLayer->lockState());
+            defaultLayerSnapshot->setVisibilityState(defaultLayer->visibilityState());
+            snapshotChildren(*defaultLayer, *defaultLayerSnapshot);
+
+            for (const auto* customLayer : world.customLayers()) {
+                result->addChild(snapshotNode(*customLayer));
+            }
+
+            return result;
+        }
+
+        /**
+         * Describes the properties of the world and of its layers, which are not recorded in the journal.
+         */
+        static std::string journalLayout(const Model::WorldNode& world) {
+            std::stringstream str;
+            for (const auto& property : world.entity().properties()) {
+                str << property.key() << "\n" << property.value() << "\n";
+            }
+            for (const auto* layerNode : world.allLayers()) {
+                const auto& layer = layerNode->layer();
+                str << layerNode->persistentId().value_or(0u) << "\n"
+                    << layer.name() << "\n"
+                    << layer.sortIndex() << " "
+                    << layer.omitFromExport() << " "
+                    << static_cast<int>(layerNode->lockState()) << " "
+                    << static_cast<int>(layerNode->visibilityState()) << "\n";
+            }
+            return str.str();
+        }
+
+        static size_t fileSize(const IO::Path& path) {
+            auto stream = IO::openPathAsInputStream(path, std::ios::in | std::ios::binary | std::ios::ate);
+            return stream ? static_cast<size_t>(stream.tellg()) : 0u;
+        }
+
+        void Autosaver::autosave(Logger& /* logger */, std::shared_ptr<MapDocument> document) {
+            const auto mapPath = document->path();
+            assert(IO::Disk::fileExists(IO::Disk::fixPath(mapPath)));
+
+            m_lastSaveTime = Clock::now();
+            m_lastModificationCount = document->modificationCount();
+
+            if (m_maxJournalEntries == 0u) {
+                startFullBackup(document, mapPath, "");
                 return;
             }
-            if (!IO::Disk::fileExists(IO::Disk::fixPath(document->path()))) {
+
+            const auto layout = journalLayout(*document->world());
+            if (canAppendToJournal(layout)) {
+                startJournalEntry(document, mapPath);
+            } else {
+                startFullBackup(document, mapPath, layout);
+            }
+        }
+
+        bool Autosaver::canAppendToJournal(const std::string& layout) const {
+            if (!m_journalValid || m_journalEntryCount >= m_maxJournalEntries || layout != m_journalLayout) {
+                return false;
+            }
+
+            // compact the journal once it has grown larger than its backup
+            if (m_backupSize > 0u && m_journalSize >= m_backupSize) {
+                return false;
+            }
+
+            return std::all_of(std::begin(m_changedJournalObjects), std::end(m_changedJournalObjects), [](const auto* object) {
+                return dynamic_cast<const Model::LayerNode*>(object->parent()) != nullptr;
+            });
+        }
+
+        void Autosaver::startFullBackup(std::shared_ptr<MapDocument> document, const IO::Path& mapPath, const std::string& layout) {
+            auto& world = *document->world();
+            auto snapshot = snapshotWorld(world);
+
+            auto journalObjectCount = std::optional<size_t>();
+            if (m_maxJournalEntries > 0u) {
+                const auto objects = collectJournalObjects(world);
+
+                invalidateJournal();
+                for (size_t i = 0u; i < objects.size(); ++i) {
+                    m_journalObjectIds[objects[i]] = i;
+                }
+
+                m_nextJournalObjectId = objects.size();
+                m_journalLayout = layout;
+                m_journalEntryCount = 0u;
+                m_journalSize = 0u;
+                m_journalValid = true;
+                m_journalMapPath = mapPath;
+                journalObjectCount = objects.size();
+            }
+
+            // a newer snapshot supersedes the one that is still being written
+            if (m_pendingSaveCancelled) {
+                *m_pendingSaveCancelled = true;
+            }
+
+            auto cancelled = std::make_shared<std::atomic<bool>>(false);
+            auto game = document->game();
+            auto previousSave = m_pendingSave;
+
+            m_pendingSave = std::async(std::launch::async, [this, game, snapshot = std::move(snapshot), mapPath, previousSave, cancelled, journalObjectCount]() mutable {
+                // the snapshot must be destroyed on this thread, too
+                auto world = std::move(snapshot);
+                return writeBackup(*game, *world, mapPath, previousSave, *cancelled, journalObjectCount);
+            }).share();
+            m_pendingSaveCancelled = std::move(cancelled);
+        }
+
+        void Autosaver::startJournalEntry(std::shared_ptr<MapDocument> document, const IO::Path& mapPath) {
+            auto updatedObjects = std::make_unique<Model::WorldNode>(Model::Entity(), document->world()->mapFormat());
+            updatedObjects->disableNodeTreeUpdates();
+
+            auto updates = std::vector<AutosaveJournalUpdate>();
+            updates.reserve(m_changedJournalObjects.size());
+
+            for (auto* object : m_changedJournalObjects) {
+                const auto [it, inserted] = m_journalObjectIds.emplace(object, m_nextJournalObjectId);
+                if (inserted) {
+                    ++m_nextJournalObjectId;
+                }
+
+                const auto* layer = static_cast<const Model::LayerNode*>(object->parent());
+                updates.push_back(AutosaveJournalUpdate{it->second, journalLayerId(*layer)});
+                updatedObjects->defaultLayer()->addChild(snapshotNode(*object));
+            }
+
+            auto removedObjectIds = std::move(m_removedJournalObjectIds);
+            m_removedJournalObjectIds.clear();
+            m_changedJournalObjects.clear();
+            ++m_journalEntryCount;
+
+            // journal entries depend on each other, so they are never cancelled in favor of a newer entry
+            auto cancelled = std::make_shared<std::atomic<bool>>(false);
+            auto previousSave = m_pendingSave;
+
+            m_pendingSave = std::async(std::launch::async, [this, updatedObjects = std::move(updatedObjects), removedObjectIds = std::move(removedObjectIds), updates = std::move(updates), mapPath, previousSave, cancelled]() mutable {
+                auto world = std::move(updatedObjects);
+                return writeJournalEntry(*world, removedObjectIds, updates, mapPath, previousSave, *cancelled);
+            }).share();
+            m_pendingSaveCancelled = std::move(cancelled);
+        }
+
+        /**
+         * Returns whether the map file was saved after the given journal was last written. In that case, the map file
+         * contains all changes recorded in the journal.
+         */
+        static bool isJournalOlderThanMap(const IO::Path& journalPath, const IO::Path& mapPath) {
+            const auto journalInfo = QFileInfo(IO::pathAsQString(journalPath));
+            const auto mapInfo = QFileInfo(IO::pathAsQString(mapPath));
+            return journalInfo.exists() && mapInfo.exists() && journalInfo.lastModified() < mapInfo.lastModified();
+        }
+
+        void Autosaver::startJournalRecovery(std::shared_ptr<MapDocument> document) {
+            const auto mapPath = document->path();
+            const auto journalPath = makeJournalPath(mapPath);
+            if (!IO::Disk::fileExists(IO::Disk::fixPath(journalPath))) {
                 return;
             }
 
-            autosave(logger, document);
+            if (isJournalOlderThanMap(journalPath, mapPath)) {
+                QFile::remove(IO::pathAsQString(journalPath));
+                return;
+            }
+
+            auto game = document->game();
+            const auto mapFormat = document->world()->mapFormat();
+            const auto worldBounds = document->worldBounds();
+            auto previousSave = m_pendingSave;
+
+            m_pendingSave = std::async(std::launch::async, [this, game, mapFormat, worldBounds, mapPath, previousSave]() {
+                return writeRecoveredBackup(*game, mapFormat, worldBounds, mapPath, previousSave);
+            }).share();
+
+            // the recovered backup is not superseded by later backups
+            m_pendingSaveCancelled.reset();
         }
 
-        void Autosaver::autosave(Logger& logger, std::shared_ptr<MapDocument> document) {
-            const auto& mapPath = document->path();
-            assert(IO::Disk::fileExists(IO::Disk::fixPath(mapPath)));
+        void Autosaver::deleteRedundantJournal() {
+            if (m_journalMapPath.isEmpty()) {
+                return;
+            }
+
+            // the journal is redundant if it has no entries after its backup or if the map was saved after it
+            const auto journalPath = makeJournalPath(m_journalMapPath);
+            if ((m_journalValid && m_journalEntryCount == 0u) || isJournalOlderThanMap(journalPath, m_journalMapPath)) {
+                QFile::remove(IO::pathAsQString(journalPath));
+            }
+        }
+
+        Autosaver::SaveResult Autosaver::writeBackup(const Model::Game& game, Model::WorldNode& world, const IO::Path& mapPath, const std::shared_future<SaveResult>& previousSave, const std::atomic<bool>& cancelled, const std::optional<size_t> journalObjectCount) const {
+            // backups are numbered, so they must be written one after another
+            if (previousSave.valid()) {
+                previousSave.wait();
+            }
+            if (cancelled) {
+                return SaveResult{SaveResult::Status::Cancelled, IO::Path(), "", 0u, 0u};
+            }
 
             const auto mapFilename = mapPath.lastComponent();
             const auto mapBasename = mapFilename.deleteExtension();
 
             try {
-                auto fs = createBackupFileSystem(logger, mapPath);
+                auto fs = createBackupFileSystem(mapPath);
+
+                // the journal refers to its backup by name, which changes when the backups are thinned
+                const auto journalName = makeJournalPath(mapPath).lastComponent();
+                if (fs.fileExists(journalName)) {
+                    fs.deleteFile(journalName);
+                }
+
                 auto backups = collectBackups(fs, mapBasename);
 
-                thinBackups(logger, fs, backups);
+                thinBackups(fs, backups);
                 cleanBackups(fs, backups, mapBasename);
 
                 assert(backups.size() < m_maxBackups);
                 const auto backupNo = backups.size() + 1;
 
-                const auto backupFilePath = fs.makeAbsolute(makeBackupName(mapBasename, backupNo));
+                const auto backupName = makeBackupName(mapBasename, backupNo);
+                const auto tempName = backupName.addExtension("tmp");
 
-                m_lastSaveTime = Clock::now();
-                m_lastModificationCount = document->modificationCount();
-                document->saveDocumentTo(backupFilePath);
+                // write to a temporary file first so that an interrupted autosave never leaves a truncated backup
+                game.writeMap(world, fs.makeAbsolute(tempName));
+                if (cancelled) {
+                    fs.deleteFile(tempName);
+                    return SaveResult{SaveResult::Status::Cancelled, IO::Path(), "", 0u, 0u};
+                }
+
+                fs.moveFile(tempName, backupName, true);
+
+                auto journalSize = size_t(0u);
+                if (journalObjectCount) {
+                    const auto tempJournalName = journalName.addExtension("tmp");
+                    {
+                        auto stream = IO::openPathAsOutputStream(fs.makeAbsolute(tempJournalName), std::ios::out | std::ios::binary);
+                        writeAutosaveJournalHeader(stream, backupName.asString(), *journalObjectCount);
+                        if (!stream) {
+                            throw FileSystemException("Cannot write autosave journal " + journalName.asString());
+                        }
+                    }
+                    fs.moveFile(tempJournalName, journalName, true);
+                    journalSize = fileSize(fs.makeAbsolute(journalName));
+                }
 
-                logger.info() << "Created autosave backup at " << backupFilePath;
+                const auto backupFilePath = fs.makeAbsolute(backupName);
+                return SaveResult{SaveResult::Status::Saved, backupFilePath, "", fileSize(backupFilePath), journalSize};
             } catch (const FileSystemException& e) {
-                logger.error() << "Aborting autosave: " << e.what();
+                return SaveResult{SaveResult::Status::Failed, IO::Path(), e.what(), 0u, 0u};
             }
         }
 
-        IO::WritableDiskFileSystem Autosaver::createBackupFileSystem(Logger& logger, const IO::Path& mapPath) const {
+        Autosaver::SaveResult Autosaver::writeJournalEntry(const Model::WorldNode& updatedObjects, const std::vector<size_t>& removedObjectIds, const std::vector<AutosaveJournalUpdate>& updates, const IO::Path& mapPath, const std::shared_future<SaveResult>& previousSave, const std::atomic<bool>& cancelled) const {
+            // an entry cannot be applied if the backup or an entry before it is missing
+            if (previousSave.valid() && previousSave.get().status == SaveResult::Status::Failed) {
+                return SaveResult{SaveResult::Status::Failed, IO::Path(), "Previous autosave failed", 0u, 0u};
+            }
+            if (cancelled) {
+                return SaveResult{SaveResult::Status::Cancelled, IO::Path(), "", 0u, 0u};
+            }
+
+            const auto journalPath = makeJournalPath(mapPath);
+            try {
+                if (!IO::Disk::fileExists(IO::Disk::fixPath(journalPath))) {
+                    throw FileSystemException("Autosave journal " + journalPath.asString() + " does not exist");
+                }
+
+                // the entry is written at once so that a crash is unlikely to leave a partial entry
+                std::stringstream entry;
+                writeAutosaveJournalEntry(entry, updatedObjects, removedObjectIds, updates);
+
+                {
+                    auto stream = IO::openPathAsOutputStream(journalPath, std::ios::out | std::ios::app | std::ios::binary);
+                    stream << entry.str();
+                    stream.flush();
+                    if (!stream) {
+                        throw FileSystemException("Cannot write autosave journal " + journalPath.asString());
+                    }
+                }
+
+                return SaveResult{SaveResult::Status::Journaled, journalPath, "", 0u, fileSize(journalPath)};
+            } catch (const FileSystemException& e) {
+                return SaveResult{SaveResult::Status::Failed, IO::Path(), e.what(), 0u, 0u};
+            }
+        }
+
+        Autosaver::SaveResult Autosaver::writeRecoveredBackup(const Model::Game& game, const Model::MapFormat mapFormat, const vm::bbox3& worldBounds, const IO::Path& mapPath, const std::shared_future<SaveResult>& previousSave) const {
+            if (previousSave.valid()) {
+                previousSave.wait();
+            }
+
+            const auto journalPath = makeJournalPath(mapPath);
+            try {
+                std::unique_ptr<Model::WorldNode> world;
+                {
+                    auto stream = IO::openPathAsInputStream(journalPath, std::ios::in | std::ios::binary);
+                    NullLogger logger;
+                    world = replayAutosaveJournal(stream, journalPath.deleteLastComponent(), mapFormat, worldBounds, logger);
+                }
+
+                const std::atomic<bool> notCancelled(false);
+                auto result = writeBackup(game, *world, mapPath, std::shared_future<SaveResult>(), notCancelled, std::nullopt);
+                if (result.status == SaveResult::Status::Saved) {
+                    result.status = SaveResult::Status::Recovered;
+                }
+                return result;
+            } catch (const Exception& e) {
+                return SaveResult{SaveResult::Status::Failed, IO::Path(), std::string("Cannot recover autosave journal: ") + e.what(), 0u, 0u};
+            }
+        }
+
+        void Autosaver::logPendingSaveResult(Logger& logger) {
+            if (!m_pendingSave.valid() || m_pendingSave.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                return;
+            }
+
+            const auto result = m_pendingSave.get();
+            switch (result.status) {
+                case SaveResult::Status::Saved:
+                    logger.info() << "Created autosave backup at " << result.backupFilePath;
+                    m_backupSize = result.backupSize;
+                    m_journalSize = result.journalSize;
+                    break;
+                case SaveResult::Status::Journaled:
+                    logger.debug() << "Updated autosave journal at " << result.backupFilePath;
+                    m_journalSize = result.journalSize;
+                    break;
+                case SaveResult::Status::Recovered:
+                    logger.info() << "Recovered autosave backup from journal at " << result.backupFilePath;
+                    break;
+                case SaveResult::Status::Cancelled:
+                    logger.debug() << "Skipped autosave backup superseded by a newer one";
+                    break;
+                case SaveResult::Status::Failed:
+                    logger.error() << "Aborting autosave: " << result.errorMessage;
+                    m_journalValid = false;
+                    break;
+            }
+
+            m_pendingSave = std::shared_future<SaveResult>();
+            m_pendingSaveCancelled.reset();
+        }
+
+        IO::WritableDiskFileSystem Autosaver::createBackupFileSystem(const IO::Path& mapPath) const {
             const auto basePath = mapPath.deleteLastComponent();
             const auto autosavePath = basePath + IO::Path("autosave");
 
@@ -135,8 +659,7 @@ namespace TrenchBroom {
                 // ensures that the directory exists or is created if it doesn't
                 return IO::WritableDiskFileSystem(autosavePath, true);
             } catch (const FileSystemException& e) {
-                logger.error() << "Cannot create autosave directory at " << autosavePath;
-                throw e;
+                throw FileSystemException("Cannot create autosave directory at " + autosavePath.asString() + ": " + e.what());
             }
         }
 
@@ -151,16 +674,14 @@ namespace TrenchBroom {
             return backups;
         }
 
-        void Autosaver::thinBackups(Logger& logger, IO::WritableDiskFileSystem& fs, std::vector<IO::Path>& backups) const {
+        void Autosaver::thinBackups(IO::WritableDiskFileSystem& fs, std::vector<IO::Path>& backups) const {
             while (backups.size() > m_maxBackups - 1) {
                 const auto filename = backups.front();
                 try {
                     fs.deleteFile(filename);
-                    logger.debug() << "Deleted autosave backup " << filename;
                     backups.erase(std::begin(backups));
                 } catch (const FileSystemException& e) {
-                    logger.error() << "Cannot delete autosave backup " << filename;
-                    throw e;
+                    throw FileSystemException("Cannot delete autosave backup " + filename.asString() + ": " + e.what());
                 }
             }
         }
@@ -180,6 +701,11 @@ namespace TrenchBroom {
             return IO::Path(kdl::str_to_string(mapBasename,".", index, ".map"));
         }
 
+        IO::Path Autosaver::makeJournalPath(const IO::Path& mapPath) const {
+            const auto mapBasename = mapPath.lastComponent().deleteExtension();
+            return mapPath.deleteLastComponent() + IO::Path("autosave") + IO::Path(kdl::str_to_string(mapBasename, ".journal"));
+        }
+
         size_t extractBackupNo(const IO::Path& path) {
                 // currently this function is only used when comparing file names which have already been verified as
                 // valid backup file names, so this should not go wrong, but if it does, sort the invalid file names to
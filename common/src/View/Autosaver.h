@@ -19,10 +19,21 @@
 
 #pragma once
 
+#include "FloatType.h"
+#include "Macros.h"
 #include "IO/Path.h"
 
+#include <vecmath/forward.h>
+
+#include <atomic>
 #include <chrono>
+#include <future>
 #include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace TrenchBroom {
     class Logger;
@@ -31,10 +42,34 @@ namespace TrenchBroom {
         class WritableDiskFileSystem;
     }
 
+    namespace Model {
+        class Game;
+        class Node;
+        class WorldNode;
+        enum class MapFormat;
+    }
+
     namespace View {
         class Command;
         class MapDocument;
-
+        struct AutosaveJournalUpdate;
+
+        /**
+         * Periodically writes backups of a modified document to the autosave directory next to the map file.
+         *
+         * The world is copied on the calling thread, and the copy is written on a background thread so that saving
+         * a large map does not block the editor. A backup is first written to a temporary file which is renamed once
+         * it is complete. If a new autosave is triggered while a backup is still being written, the older backup is
+         * abandoned in favor of the newer one.
+         *
+         * If journaling is enabled, only the first autosave writes a full backup. The following autosaves append the
+         * objects that have changed since to a journal, see AutosaveJournal.h. The journal is compacted into a new
+         * full backup after a number of entries, once it has grown larger than its backup, or when the layers of the
+         * map change. When the autosaver is destroyed, the journal is deleted if it contains no changes that are not also
+         * contained in the map file or in the latest backup. If a journal is left over from a previous session, it is
+         * replayed into a full backup when the autosaver is triggered for the first time, unless the map file has been
+         * saved since the journal was last written.
+         */
         class Autosaver {
         public:
             class BackupFileMatcher {
@@ -46,6 +81,25 @@ namespace TrenchBroom {
             };
         private:
             using Clock = std::chrono::system_clock;
+
+            /**
+             * The outcome of writing a backup in the background.
+             */
+            struct SaveResult {
+                enum class Status {
+                    Saved,
+                    Journaled,
+                    Recovered,
+                    Cancelled,
+                    Failed
+                };
+
+                Status status;
+                IO::Path backupFilePath;
+                std::string errorMessage;
+                size_t backupSize;
+                size_t journalSize;
+            };
             
             std::weak_ptr<MapDocument> m_document;
 
@@ -69,21 +123,105 @@ namespace TrenchBroom {
              * The modification count that was last recorded.
              */
             size_t m_lastModificationCount;
-            
+
+            /**
+             * The backup that is currently being written in the background, if any.
+             */
+            std::shared_future<SaveResult> m_pendingSave;
+
+            /**
+             * Set to abandon the pending backup when a newer snapshot supersedes it.
+             */
+            std::shared_ptr<std::atomic<bool>> m_pendingSaveCancelled;
+
+            /**
+             * The maximum number of journal entries written after a full backup. If this is 0, journaling is disabled
+             * and every autosave writes a full backup.
+             */
+            size_t m_maxJournalEntries;
+
+            /**
+             * Whether a journal left over from a previous session must still be replayed.
+             */
+            bool m_journalRecoveryPending;
+
+            /**
+             * The path of the map file whose journal this autosaver writes, or an empty path if it hasn't written one.
+             */
+            IO::Path m_journalMapPath;
+
+            /**
+             * Whether the journal on disk matches the objects recorded below, that is, whether the next autosave can
+             * append to it.
+             */
+            bool m_journalValid;
+            size_t m_journalEntryCount;
+            size_t m_backupSize;
+            size_t m_journalSize;
+
+            /**
+             * The world and layer properties at the time of the last full backup. The journal cannot record changes
+             * to these.
+             */
+            std::string m_journalLayout;
+
+            /**
+             * The IDs of the objects of the map that are known to the journal.
+             */
+            std::unordered_map<const Model::Node*, size_t> m_journalObjectIds;
+            size_t m_nextJournalObjectId;
+
+            /**
+             * The objects that were added or changed and the IDs of the objects that were removed since the last
+             * autosave.
+             */
+            std::unordered_set<Model::Node*> m_changedJournalObjects;
+            std::vector<size_t> m_removedJournalObjectIds;
         public:
-            explicit Autosaver(std::weak_ptr<MapDocument> document, std::chrono::milliseconds saveInterval = std::chrono::milliseconds(10 * 60 * 1000), size_t maxBackups = 50);
+            explicit Autosaver(std::weak_ptr<MapDocument> document, std::chrono::milliseconds saveInterval = std::chrono::milliseconds(10 * 60 * 1000), size_t maxBackups = 50, size_t maxJournalEntries = 0);
+
+            /**
+             * Waits until the pending backup is written and deletes the journal if it is redundant.
+             */
+            ~Autosaver();
+
+            deleteCopyAndMove(Autosaver)
 
             void triggerAutosave(Logger& logger);
+
+            /**
+             * Waits until the backup that is being written in the background, if any, is complete and logs the
+             * outcome.
+             */
+            void waitForPendingSave(Logger& logger);
         private:
+            void bindObservers();
+            void unbindObservers();
+            void nodesWereAdded(const std::vector<Model::Node*>& nodes);
+            void nodesWillBeRemoved(const std::vector<Model::Node*>& nodes);
+            void nodesDidChange(const std::vector<Model::Node*>& nodes);
+            void documentWasCleared(MapDocument* document);
+            void invalidateJournal();
+
             void autosave(Logger& logger, std::shared_ptr<View::MapDocument> document);
-            IO::WritableDiskFileSystem createBackupFileSystem(Logger& logger, const IO::Path& mapPath) const;
+            bool canAppendToJournal(const std::string& layout) const;
+            void startFullBackup(std::shared_ptr<View::MapDocument> document, const IO::Path& mapPath, const std::string& layout);
+            void startJournalEntry(std::shared_ptr<View::MapDocument> document, const IO::Path& mapPath);
+            void startJournalRecovery(std::shared_ptr<View::MapDocument> document);
+            void deleteRedundantJournal();
+
+            SaveResult writeBackup(const Model::Game& game, Model::WorldNode& world, const IO::Path& mapPath, const std::shared_future<SaveResult>& previousSave, const std::atomic<bool>& cancelled, std::optional<size_t> journalObjectCount) const;
+            SaveResult writeJournalEntry(const Model::WorldNode& updatedObjects, const std::vector<size_t>& removedObjectIds, const std::vector<AutosaveJournalUpdate>& updates, const IO::Path& mapPath, const std::shared_future<SaveResult>& previousSave, const std::atomic<bool>& cancelled) const;
+            SaveResult writeRecoveredBackup(const Model::Game& game, Model::MapFormat mapFormat, const vm::bbox3& worldBounds, const IO::Path& mapPath, const std::shared_future<SaveResult>& previousSave) const;
+            void logPendingSaveResult(Logger& logger);
+            IO::WritableDiskFileSystem createBackupFileSystem(const IO::Path& mapPath) const;
             std::vector<IO::Path> collectBackups(const IO::WritableDiskFileSystem& fs, const IO::Path& mapBasename) const;
-            void thinBackups(Logger& logger, IO::WritableDiskFileSystem& fs, std::vector<IO::Path>& backups) const;
+            void thinBackups(IO::WritableDiskFileSystem& fs, std::vector<IO::Path>& backups) const;
             void cleanBackups(IO::WritableDiskFileSystem& fs, std::vector<IO::Path>& backups, const IO::Path& mapBasename) const;
             IO::Path makeBackupName(const IO::Path& mapBasename, const size_t index) const;
+            IO::Path makeJournalPath(const IO::Path& mapPath) const;
         };
 
         size_t extractBackupNo(const IO::Path& path);
     }
 }
-
@@ -0,0 +1,88 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Macros.h"
+#include "IO/Path.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+
+namespace TrenchBroom {
+    namespace View {
+        /**
+         * Loads a file on a worker thread by constructing an instance of T from the file's path, a progress value and a
+         * cancellation flag.
+         *
+         * Destroying a background load cancels it and waits for the worker to finish.
+         */
+        template <typename T>
+        class BackgroundLoad {
+        private:
+            IO::Path m_path;
+            std::shared_ptr<std::atomic<float>> m_progress;
+            std::shared_ptr<std::atomic<bool>> m_cancelled;
+            std::future<std::unique_ptr<T>> m_result;
+        public:
+            explicit BackgroundLoad(IO::Path path) :
+            m_path(std::move(path)),
+            m_progress(std::make_shared<std::atomic<float>>(0.0f)),
+            m_cancelled(std::make_shared<std::atomic<bool>>(false)) {
+                m_result = std::async(std::launch::async, [path = m_path, progress = m_progress, cancelled = m_cancelled]() {
+                    return std::make_unique<T>(path, *progress, *cancelled);
+                });
+            }
+
+            ~BackgroundLoad() {
+                *m_cancelled = true;
+                if (m_result.valid()) {
+                    m_result.wait();
+                }
+            }
+
+            const IO::Path& path() const {
+                return m_path;
+            }
+
+            /**
+             * Returns the fraction of the file that has been loaded so far.
+             */
+            float progress() const {
+                return *m_progress;
+            }
+
+            bool ready() const {
+                return m_result.valid() && m_result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+            }
+
+            /**
+             * Waits for the worker to finish and returns the loaded object. Rethrows any exception thrown while loading.
+             * Must be called at most once.
+             */
+            std::unique_ptr<T> get() {
+                return m_result.get();
+            }
+
+            deleteCopyAndMove(BackgroundLoad)
+        };
+    }
+}
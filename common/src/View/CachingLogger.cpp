@@ -31,10 +31,13 @@ namespace TrenchBroom {
         m_logger(nullptr) {}
 
         void CachingLogger::setParentLogger(Logger* logger) {
+            // the cached messages are replayed while holding the lock so that messages logged by other threads in the
+            // meantime cannot overtake them
+            std::lock_guard<std::mutex> lock(m_mutex);
             m_logger = logger;
             if (m_logger != nullptr) {
                 for (const Message& message : m_cachedMessages) {
-                    log(message.level, message.str);
+                    m_logger->log(message.level, message.str);
                 }
                 m_cachedMessages.clear();
             }
@@ -45,11 +48,17 @@ namespace TrenchBroom {
         }
 
         void CachingLogger::doLog(const LogLevel level, const QString& message) {
-            if (m_logger == nullptr) {
-                m_cachedMessages.push_back(Message(level, message));
-            } else {
-                m_logger->log(level, message);
+            Logger* logger = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_logger == nullptr) {
+                    m_cachedMessages.push_back(Message(level, message));
+                    return;
+                }
+                logger = m_logger;
             }
+
+            logger->log(level, message);
         }
     }
 }
@@ -29,6 +29,9 @@
 #include <kdl/vector_utils.h>
 
 #include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
 
 #include <QDateTime>
 
@@ -108,6 +111,14 @@ namespace TrenchBroom {
             bool doCollateWith(UndoableCommand*) override {
                 return false;
             }
+        public:
+            size_t memorySize() const override {
+                size_t result = UndoableCommand::memorySize();
+                for (const auto& command : m_commands) {
+                    result += command->memorySize();
+                }
+                return result;
+            }
         };
 
         const Command::CommandType CommandProcessor::TransactionCommand::Type = Command::freeType();
@@ -115,6 +126,8 @@ namespace TrenchBroom {
         CommandProcessor::CommandProcessor(MapDocumentCommandFacade* document, const std::chrono::milliseconds collationInterval) :
         m_document(document),
         m_collationInterval(collationInterval),
+        m_undoMemoryLimit(std::numeric_limits<size_t>::max()),
+        m_undoMemorySize(0u),
         m_lastCommandTimestamp(std::chrono::time_point<std::chrono::system_clock>()) {}
 
         CommandProcessor::~CommandProcessor() = default;
@@ -143,6 +156,21 @@ namespace TrenchBroom {
             }
         }
 
+        size_t CommandProcessor::undoMemoryLimit() const {
+            return m_undoMemoryLimit;
+        }
+
+        void CommandProcessor::setUndoMemoryLimit(const size_t undoMemoryLimit) {
+            m_undoMemoryLimit = undoMemoryLimit;
+            if (m_transactionStack.empty()) {
+                enforceUndoMemoryLimit();
+            }
+        }
+
+        size_t CommandProcessor::undoMemorySize() const {
+            return m_undoMemorySize;
+        }
+
         void CommandProcessor::startTransaction(const std::string& name) {
             m_transactionStack.push_back(TransactionState(name));
         }
@@ -172,6 +200,7 @@ namespace TrenchBroom {
             if (result->success()) {
                 m_undoStack.clear();
                 m_redoStack.clear();
+                m_undoMemorySize = 0u;
             }
             return result;
         }
@@ -217,6 +246,7 @@ namespace TrenchBroom {
 
             m_undoStack.clear();
             m_redoStack.clear();
+            m_undoMemorySize = 0u;
             m_lastCommandTimestamp = std::chrono::time_point<std::chrono::system_clock>();
         }
 
@@ -314,12 +344,17 @@ namespace TrenchBroom {
 
             if (collatable(collate, timestamp)) {
                 auto& lastCommand = m_undoStack.back();
+                const auto lastCommandMemorySize = lastCommand->memorySize();
                 if (lastCommand->collateWith(command.get())) {
+                    m_undoMemorySize = m_undoMemorySize - lastCommandMemorySize + lastCommand->memorySize();
+                    enforceUndoMemoryLimit();
                     return false;
                 }
             }
 
+            m_undoMemorySize += command->memorySize();
             m_undoStack.push_back(std::move(command));
+            enforceUndoMemoryLimit();
             return true;
         }
 
@@ -327,7 +362,23 @@ namespace TrenchBroom {
             assert(m_transactionStack.empty());
             assert(!m_undoStack.empty());
 
-            return kdl::vec_pop_back(m_undoStack);
+            auto command = kdl::vec_pop_back(m_undoStack);
+            m_undoMemorySize -= std::min(m_undoMemorySize, command->memorySize());
+            return command;
+        }
+
+        void CommandProcessor::enforceUndoMemoryLimit() {
+            assert(m_transactionStack.empty());
+
+            size_t count = 0u;
+            while (m_undoMemorySize > m_undoMemoryLimit && count + 1u < m_undoStack.size()) {
+                m_undoMemorySize -= std::min(m_undoMemorySize, m_undoStack[count]->memorySize());
+                ++count;
+            }
+
+            if (count > 0u) {
+                m_undoStack.erase(std::begin(m_undoStack), std::next(std::begin(m_undoStack), static_cast<std::ptrdiff_t>(count)));
+            }
         }
 
         bool CommandProcessor::collatable(const bool collate, const std::chrono::system_clock::time_point timestamp) const {
@@ -46,6 +46,9 @@ namespace TrenchBroom {
          *
          * The command processor supports nested transactions. Each transaction can be committed or rolled back
          * individually. Committing a nested transaction adds it as a command to the containing transaction.
+         *
+         * The memory held by the commands on the undo stack can be limited. If the estimated memory of these commands
+         * exceeds the limit, then the oldest commands are removed from the undo stack and can no longer be undone.
          */
         class CommandProcessor {
         private:
@@ -71,6 +74,16 @@ namespace TrenchBroom {
              */
             std::vector<std::unique_ptr<UndoableCommand>> m_redoStack;
 
+            /**
+             * Limits the estimated memory held by the commands on the undo stack, in bytes.
+             */
+            size_t m_undoMemoryLimit;
+
+            /**
+             * The estimated memory held by the commands on the undo stack, in bytes.
+             */
+            size_t m_undoMemorySize;
+
             /**
              * The time stamp of when the last command was executed.
              */
@@ -157,6 +170,27 @@ namespace TrenchBroom {
              */
             const std::string& redoCommandName() const;
 
+            /**
+             * Returns the limit of the estimated memory held by the commands on the undo stack, in bytes.
+             */
+            size_t undoMemoryLimit() const;
+
+            /**
+             * Sets the limit of the estimated memory held by the commands on the undo stack, in bytes. If the limit is
+             * exceeded, the oldest commands are removed from the undo stack. The most recently executed command is
+             * always kept, even if it exceeds the limit on its own.
+             *
+             * By default, the memory held by the undo stack is not limited.
+             *
+             * @param undoMemoryLimit the limit in bytes
+             */
+            void setUndoMemoryLimit(size_t undoMemoryLimit);
+
+            /**
+             * Returns the estimated memory held by the commands on the undo stack, in bytes.
+             */
+            size_t undoMemorySize() const;
+
             /**
              * Starts a new transaction. If a transaction is currently executing, then the newly started transaction
              * becomes a nested transaction and will be added as a command to its parent transaction upon commit.
@@ -341,6 +375,12 @@ namespace TrenchBroom {
              */
             std::unique_ptr<UndoableCommand> popFromUndoStack();
 
+            /**
+             * Removes the oldest commands from the undo stack until the estimated memory held by the remaining
+             * commands does not exceed the undo memory limit. The topmost command is never removed.
+             */
+            void enforceUndoMemoryLimit();
+
             bool collatable(bool collate, std::chrono::system_clock::time_point timestamp) const;
 
             /**
@@ -22,6 +22,8 @@
 #include "FileLogger.h"
 #include "View/ViewConstants.h"
 
+#include <algorithm>
+#include <iterator>
 #include <string>
 
 #include <QDebug>
@@ -32,7 +34,11 @@
 namespace TrenchBroom {
     namespace View {
         Console::Console(QWidget* parent) :
-        TabBookPage(parent) {
+        Console(FileLogger::instance(), parent) {}
+
+        Console::Console(FileLogger& fileLogger, QWidget* parent) :
+        TabBookPage(parent),
+        m_fileLogger(fileLogger) {
             m_textView = new QTextEdit();
             m_textView->setReadOnly(true);
             m_textView->setWordWrapMode(QTextOption::NoWrap);
@@ -43,18 +49,63 @@ namespace TrenchBroom {
             setLayout(sizer);
         }
 
+        Console::~Console() {
+            flushPendingMessages();
+        }
+
         void Console::doLog(const LogLevel level, const std::string& message) {
             doLog(level, QString::fromStdString(message));
         }
 
         void Console::doLog(const LogLevel level, const QString& message) {
             if (!message.isEmpty()) {
-                logToDebugOut(level, message);
-                logToConsole(level, message);
-                FileLogger::instance().log(level, message);
+                m_fileLogger.log(level, message);
+
+                std::lock_guard<std::mutex> lock(m_pendingMessagesMutex);
+
+                // only the first pending message schedules a flush, the others are shown in the same batch
+                if (m_pendingMessages.empty()) {
+                    QMetaObject::invokeMethod(this, "flushPendingMessages", Qt::QueuedConnection);
+                }
+                m_pendingMessages.push_back(Message{level, message});
             }
         }
 
+        void Console::flushPendingMessages() {
+            std::vector<Message> messages;
+            {
+                std::lock_guard<std::mutex> lock(m_pendingMessagesMutex);
+                messages = std::move(m_pendingMessages);
+                m_pendingMessages.clear();
+            }
+
+            if (messages.empty()) {
+                return;
+            }
+
+            for (auto it = std::begin(messages); it != std::end(messages);) {
+                const auto& message = *it;
+                const auto next = std::find_if(std::next(it), std::end(messages), [&](const Message& other) {
+                    return other.level != message.level || other.string != message.string;
+                });
+
+                logToDebugOut(message.level, message.string);
+                logToConsole(message.level, message.string);
+
+                const auto repetitions = std::distance(it, next) - 1;
+                if (repetitions > 0) {
+                    const auto repeated = QString("(last message repeated %1 times)").arg(repetitions);
+                    logToDebugOut(message.level, repeated);
+                    logToConsole(message.level, repeated);
+                }
+
+                it = next;
+            }
+
+            m_fileLogger.flush();
+            m_textView->moveCursor(QTextCursor::MoveOperation::End);
+        }
+
         void Console::logToDebugOut(const LogLevel /* level */, const QString& message) {
             qDebug("%s", message.toStdString().c_str());
         }
@@ -82,8 +133,6 @@ namespace TrenchBroom {
             cursor.movePosition(QTextCursor::MoveOperation::End);
             cursor.insertText(message, format);
             cursor.insertText("\n");
-
-            m_textView->moveCursor(QTextCursor::MoveOperation::End);
         }
     }
 }
@@ -22,25 +22,53 @@
 #include "Logger.h"
 #include "View/TabBook.h"
 
+#include <mutex>
 #include <string>
+#include <vector>
+
+#include <QString>
 
 class QTextEdit;
-class QString;
 class QWidget;
 
 namespace TrenchBroom {
+    class FileLogger;
+
     namespace View {
+        /**
+         * Shows log messages and writes them to the log file.
+         *
+         * Messages can be logged from any thread. They are passed to the file logger as they are logged, which buffers
+         * them. The file logger is flushed whenever a batch of messages has been shown, and by the crash handler. Showing
+         * the messages is deferred: they are collected and shown in batches on the GUI thread, which is much faster than
+         * updating the text view for every message when many messages are logged at once. Consecutive repetitions of a
+         * message within a batch are shown only once.
+         */
         class Console : public TabBookPage, public Logger {
+            Q_OBJECT
         private:
+            struct Message {
+                LogLevel level;
+                QString string;
+            };
+
+            FileLogger& m_fileLogger;
             QTextEdit* m_textView;
+
+            std::mutex m_pendingMessagesMutex;
+            std::vector<Message> m_pendingMessages;
         public:
             explicit Console(QWidget* parent = nullptr);
+            explicit Console(FileLogger& fileLogger, QWidget* parent = nullptr);
+            ~Console() override;
         private:
             void doLog(LogLevel level, const std::string& message) override;
             void doLog(LogLevel level, const QString& message) override;
+        private slots:
+            void flushPendingMessages();
+        private:
             void logToDebugOut(LogLevel level, const QString& message);
             void logToConsole(LogLevel level, const QString& message);
         };
     }
 }
-
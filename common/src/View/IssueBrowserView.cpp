@@ -20,6 +20,7 @@
 #include "IssueBrowserView.h"
 
 #include "Ensure.h"
+#include "Profiler.h"
 #include "Model/Issue.h"
 #include "Model/IssueQuickFix.h"
 #include "Model/BrushNode.h"
@@ -114,6 +115,7 @@ namespace TrenchBroom {
         }
 
         void IssueBrowserView::updateIssues() {
+            TB_PROFILE_SCOPE("IssueBrowserView::updateIssues");
             auto document = kdl::mem_lock(m_document);
             if (document->world() != nullptr) {
                 const auto& issueGenerators = document->world()->registeredIssueGenerators();
@@ -20,6 +20,7 @@
 #include "View/MapDocument.h"
 
 #include "Exceptions.h"
+#include "Profiler.h"
 #include "Model/EntityProperties.h"
 #include "PreferenceManager.h"
 #include "Preferences.h"
@@ -102,6 +103,7 @@
 #include <kdl/map_utils.h>
 #include <kdl/memory_utils.h>
 #include <kdl/overload.h>
+#include <kdl/parallel.h>
 #include <kdl/string_format.h>
 #include <kdl/result.h>
 #include <kdl/result_for_each.h>
@@ -115,7 +117,10 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdlib> // for std::abs
+#include <functional>
 #include <map>
+#include <numeric>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <type_traits>
@@ -124,6 +129,12 @@
 
 namespace TrenchBroom {
     namespace View {
+        /**
+         * The minimum number of brushes for which bulk edits are applied in parallel. For fewer brushes, spawning the
+         * worker threads takes longer than applying the edit.
+         */
+        static constexpr size_t MinParallelBrushCount = 64u;
+
         /**
          * Applies the given lambda to a copy of the contents of each of the given nodes and returns a vector of pairs of the original node and the modified contents.
          *
@@ -181,42 +192,182 @@ namespace TrenchBroom {
             return false;
         }
 
+        /**
+         * Applies the given lambda to a copy of the contents of each of the given nodes like applyToNodeContents, but the
+         * brushes are copied and modified in parallel. The contents of all other nodes are copied and modified on the
+         * calling thread because copying an entity changes the usage count of its entity definition, which notifies its
+         * observers.
+         *
+         * The lambda L needs the following overloads:
+         * - bool operator()(Model::Layer&);
+         * - bool operator()(Model::Group&);
+         * - bool operator()(Model::Entity&);
+         * - kdl::result<void, Model::BrushError> operator()(Model::Brush&);
+         *
+         * The overload for brushes is called concurrently and must not modify any shared state or log anything. Instead,
+         * each brush error is passed to the given error handler E on the calling thread, in the order of the given nodes.
+         * If the overload for brushes throws an exception, it is rethrown on the calling thread once all brushes have
+         * been processed, just like on the serial path, and no contents are returned.
+         *
+         * Returns a vector of pairs which map each node to its modified contents, in the order of the given nodes, if the
+         * lambda succeeded for every given node, or an empty optional otherwise.
+         */
+        template <typename N, typename L, typename E>
+        static std::optional<std::vector<std::pair<Model::Node*, Model::NodeContents>>> applyToNodeContentsInParallel(const std::vector<N*>& nodes, L lambda, E errorHandler) {
+            using NodeContentType = std::variant<Model::Layer, Model::Group, Model::Entity, Model::Brush>;
+
+            auto nodeContents = std::vector<std::optional<NodeContentType>>(nodes.size());
+            auto brushNodes = std::vector<std::pair<size_t, const Model::BrushNode*>>{};
+
+            bool success = true;
+            for (size_t i = 0u; i < nodes.size(); ++i) {
+                const auto apply = [&](auto contents) {
+                    success = success && lambda(contents);
+                    nodeContents[i] = std::move(contents);
+                };
+
+                nodes[i]->accept(kdl::overload(
+                    [&](const Model::WorldNode* worldNode)   { apply(worldNode->entity()); },
+                    [&](const Model::LayerNode* layerNode)   { apply(layerNode->layer()); },
+                    [&](const Model::GroupNode* groupNode)   { apply(groupNode->group()); },
+                    [&](const Model::EntityNode* entityNode) { apply(entityNode->entity()); },
+                    [&](const Model::BrushNode* brushNode)   { brushNodes.emplace_back(i, brushNode); }
+                ));
+            }
+
+            auto brushErrors = std::vector<std::optional<Model::BrushError>>(nodes.size());
+            const auto applyToBrush = [&](const size_t brushIndex) {
+                const auto& [i, brushNode] = brushNodes[brushIndex];
+
+                auto brush = brushNode->brush();
+                lambda(brush).handle_errors([&, i = i](const Model::BrushError e) {
+                    brushErrors[i] = e;
+                });
+                nodeContents[i] = std::move(brush);
+            };
+
+            if (brushNodes.size() < MinParallelBrushCount) {
+                for (size_t i = 0u; i < brushNodes.size(); ++i) {
+                    applyToBrush(i);
+                }
+            } else {
+                kdl::parallel_for(brushNodes.size(), applyToBrush);
+            }
+
+            for (const auto& brushError : brushErrors) {
+                if (brushError) {
+                    errorHandler(*brushError);
+                    success = false;
+                }
+            }
+
+            // every brush has its contents unless the lambda threw, in which case the exception was propagated, but
+            // don't rely on that when unwrapping the contents below
+            success = success && std::all_of(std::begin(nodeContents), std::end(nodeContents), [](const auto& contents) { return contents.has_value(); });
+
+            if (!success) {
+                return std::nullopt;
+            }
+
+            auto newNodes = std::vector<std::pair<Model::Node*, Model::NodeContents>>{};
+            newNodes.reserve(nodes.size());
+
+            for (size_t i = 0u; i < nodes.size(); ++i) {
+                newNodes.emplace_back(nodes[i], Model::NodeContents(std::move(*nodeContents[i])));
+            }
+
+            return newNodes;
+        }
+
+        /**
+         * Applies the given lambda to a copy of the contents of each of the given nodes in parallel and swaps the node
+         * contents if the given lambda succeeds for all node contents.
+         *
+         * See applyToNodeContentsInParallel for the requirements on the lambda L and the error handler E.
+         *
+         * Returns true if the given lambda could be applied successfully to all node contents and false otherwise. If the
+         * lambda fails, then no node contents will be swapped, and the original nodes remain unmodified.
+         */
+        template <typename N, typename L, typename E>
+        static bool applyAndSwapInParallel(MapDocument& document, const std::string& commandName, const std::vector<N*>& nodes, L lambda, E errorHandler) {
+            if (auto newNodes = applyToNodeContentsInParallel(nodes, std::move(lambda), std::move(errorHandler))) {
+                document.swapNodeContents(commandName, std::move(*newNodes));
+                return true;
+            }
+
+            return false;
+        }
+
         /**
          * Applies the given lambda to a copy of each of the given faces.
          *
-         * Specifically, each brush node of the given faces has its contents copied and the lambda applied to the copied faces. If the lambda succeeds for each
-         * face, the node contents are subsequently swapped.
+         * Specifically, the given faces are grouped by their brush nodes, and then each brush node has its contents
+         * copied and the lambda applied to the copied faces. The brushes are processed in parallel, so the lambda must
+         * not modify any shared state. If the lambda succeeds for each face, the node contents are subsequently swapped
+         * in the order in which the brush nodes first occur in the given faces.
          *
          * The lambda L needs to accept brush faces:
          * - bool operator()(Model::BrushFace&);
          *
          * The given node contents should be modified in place and the lambda should return true if it was applied successfully and false otherwise.
+         * If the lambda throws an exception, it is rethrown on the calling thread once all brushes have been processed.
          *
          * Returns true if the given lambda could be applied successfully to each face and false otherwise. If the lambda fails, then no
          * node contents will be swapped, and the original nodes remain unmodified.
          */
         template <typename L>
         static bool applyAndSwap(MapDocument& document, const std::string& commandName, const std::vector<Model::BrushFaceHandle>& faces, L lambda) {
-            auto brushes = std::unordered_map<Model::BrushNode*, Model::Brush>{};
+            // group the face handles by their brush nodes; the first index of each group is where its brush node first occurs
+            auto faceOrder = std::vector<size_t>(faces.size());
+            std::iota(std::begin(faceOrder), std::end(faceOrder), static_cast<size_t>(0));
+            std::stable_sort(std::begin(faceOrder), std::end(faceOrder), [&](const size_t lhs, const size_t rhs) {
+                return std::less<const Model::BrushNode*>{}(faces[lhs].node(), faces[rhs].node());
+            });
 
-            bool success = true;
-            std::for_each(std::begin(faces), std::end(faces), [&](const auto& faceHandle) {
-                auto* brushNode = faceHandle.node();
-                auto it = brushes.find(brushNode);
-                if (it == std::end(brushes)) {
-                    it = brushes.emplace(brushNode, brushNode->brush()).first;
+            struct BrushFaces {
+                size_t firstOccurrence;
+                Model::BrushNode* brushNode;
+                std::vector<size_t> faceIndices;
+            };
+
+            auto brushFaces = std::vector<BrushFaces>{};
+            for (const auto i : faceOrder) {
+                if (brushFaces.empty() || brushFaces.back().brushNode != faces[i].node()) {
+                    brushFaces.push_back({i, faces[i].node(), {}});
                 }
+                brushFaces.back().faceIndices.push_back(faces[i].faceIndex());
+            }
 
-                auto& brush = it->second;
-                success = success && lambda(brush.face(faceHandle.faceIndex()));
+            std::sort(std::begin(brushFaces), std::end(brushFaces), [](const auto& lhs, const auto& rhs) {
+                return lhs.firstOccurrence < rhs.firstOccurrence;
             });
 
+            auto brushes = std::vector<std::optional<Model::Brush>>(brushFaces.size());
+            const auto applyToBrush = [&](const size_t i) {
+                auto brush = brushFaces[i].brushNode->brush();
+                for (const auto faceIndex : brushFaces[i].faceIndices) {
+                    if (!lambda(brush.face(faceIndex))) {
+                        return;
+                    }
+                }
+                brushes[i] = std::move(brush);
+            };
+
+            if (brushFaces.size() < MinParallelBrushCount) {
+                for (size_t i = 0u; i < brushFaces.size(); ++i) {
+                    applyToBrush(i);
+                }
+            } else {
+                kdl::parallel_for(brushFaces.size(), applyToBrush);
+            }
+
+            const auto success = std::all_of(std::begin(brushes), std::end(brushes), [](const auto& brush) { return brush.has_value(); });
             if (success) {
                 auto newNodes = std::vector<std::pair<Model::Node*, Model::NodeContents>>{};
                 newNodes.reserve(brushes.size());
 
-                for (auto& [brushNode, brush] : brushes) {
-                    newNodes.emplace_back(brushNode, Model::NodeContents(std::move(brush)));
+                for (size_t i = 0u; i < brushes.size(); ++i) {
+                    newNodes.emplace_back(brushFaces[i].brushNode, Model::NodeContents(std::move(*brushes[i])));
                 }
 
                 document.swapNodeContents(commandName, std::move(newNodes));
@@ -259,6 +410,9 @@ namespace TrenchBroom {
         MapDocument::~MapDocument() {
             unbindObservers();
 
+            m_pointFileLoad = nullptr;
+            m_portalFileLoad = nullptr;
+
             if (isPointFileLoaded()) {
                 unloadPointFile();
             }
@@ -494,6 +648,35 @@ namespace TrenchBroom {
             return stream.str();
         }
 
+        std::vector<Model::Node*> MapDocument::cloneSelectedNodes() const {
+            std::vector<Model::Node*> result;
+            std::map<Model::EntityNode*, Model::Node*> entityClones;
+
+            for (auto* node : m_selectedNodes.nodes()) {
+                node->accept(kdl::overload(
+                    [] (Model::WorldNode*) {},
+                    [] (Model::LayerNode*) {},
+                    [&](Model::GroupNode* group)   { result.push_back(group->cloneRecursively(m_worldBounds)); },
+                    [&](Model::EntityNode* entity) { result.push_back(entity->cloneRecursively(m_worldBounds)); },
+                    [&](Model::BrushNode* brush)   {
+                        auto* clone = brush->clone(m_worldBounds);
+                        if (auto* entity = dynamic_cast<Model::EntityNode*>(brush->parent())) {
+                            auto& entityClone = entityClones[entity];
+                            if (entityClone == nullptr) {
+                                entityClone = entity->clone(m_worldBounds);
+                                result.push_back(entityClone);
+                            }
+                            entityClone->addChild(clone);
+                        } else {
+                            result.push_back(clone);
+                        }
+                    }
+                ));
+            }
+
+            return result;
+        }
+
         PasteType MapDocument::paste(const std::string& str) {
             // Try parsing as entities, then as brushes, in all compatible formats
             const std::vector<Model::Node*> nodes = m_game->parseNodes(str, m_world->mapFormat(), m_worldBounds, logger());
@@ -516,6 +699,10 @@ namespace TrenchBroom {
             return PasteType::Failed;
         }
 
+        PasteType MapDocument::paste(const std::vector<Model::Node*>& nodes) {
+            return pasteNodes(nodes) ? PasteType::Node : PasteType::Failed;
+        }
+
         bool MapDocument::pasteNodes(const std::vector<Model::Node*>& nodes) {
             auto nodesToDetach = std::vector<Model::Node*>{};
             auto nodesToDelete = std::vector<Model::Node*>{};
@@ -587,15 +774,9 @@ namespace TrenchBroom {
                 return;
             }
 
-            if (isPointFileLoaded()) {
-                unloadPointFile();
-            }
-
-            m_pointFilePath = path;
-            m_pointFile = std::make_unique<Model::PointFile>(m_pointFilePath);
-
-            info("Loaded point file " + m_pointFilePath.asString());
-            pointFileWasLoadedNotifier();
+            // replacing a pending load cancels it
+            m_pointFileLoad = std::make_unique<BackgroundLoad<Model::PointFile>>(path);
+            info("Loading point file " + path.asString());
         }
 
         bool MapDocument::isPointFileLoaded() const {
@@ -613,6 +794,7 @@ namespace TrenchBroom {
 
         void MapDocument::unloadPointFile() {
             assert(isPointFileLoaded());
+            m_pointFileLoad = nullptr;
             m_pointFile = nullptr;
             m_pointFilePath = IO::Path();
 
@@ -620,6 +802,13 @@ namespace TrenchBroom {
             pointFileWasUnloadedNotifier();
         }
 
+        std::optional<float> MapDocument::pointFileLoadProgress() const {
+            if (m_pointFileLoad == nullptr) {
+                return std::nullopt;
+            }
+            return m_pointFileLoad->progress();
+        }
+
         void MapDocument::loadPortalFile(const IO::Path path) {
             static_assert(!std::is_reference<decltype(path)>::value,
                           "path must be passed by value because reloadPortalFile() passes m_portalFilePath");
@@ -628,21 +817,9 @@ namespace TrenchBroom {
                 return;
             }
 
-            if (isPortalFileLoaded()) {
-                unloadPortalFile();
-            }
-
-            try {
-                m_portalFilePath = path;
-                m_portalFile = std::make_unique<Model::PortalFile>(path);
-            } catch (const std::exception &exception) {
-                info("Couldn't load portal file " + m_portalFilePath.asString() + ": " + exception.what());
-            }
-
-            if (isPortalFileLoaded()) {
-                info("Loaded portal file " + m_portalFilePath.asString());
-                portalFileWasLoadedNotifier();
-            }
+            // replacing a pending load cancels it
+            m_portalFileLoad = std::make_unique<BackgroundLoad<Model::PortalFile>>(path);
+            info("Loading portal file " + path.asString());
         }
 
         bool MapDocument::isPortalFileLoaded() const {
@@ -660,6 +837,7 @@ namespace TrenchBroom {
 
         void MapDocument::unloadPortalFile() {
             assert(isPortalFileLoaded());
+            m_portalFileLoad = nullptr;
             m_portalFile = nullptr;
             m_portalFilePath = IO::Path();
 
@@ -667,6 +845,73 @@ namespace TrenchBroom {
             portalFileWasUnloadedNotifier();
         }
 
+        std::optional<float> MapDocument::portalFileLoadProgress() const {
+            if (m_portalFileLoad == nullptr) {
+                return std::nullopt;
+            }
+            return m_portalFileLoad->progress();
+        }
+
+        void MapDocument::finishBackgroundLoads() {
+            if (m_pointFileLoad != nullptr && m_pointFileLoad->ready()) {
+                finishPointFileLoad();
+            }
+            if (m_portalFileLoad != nullptr && m_portalFileLoad->ready()) {
+                finishPortalFileLoad();
+            }
+        }
+
+        void MapDocument::waitForBackgroundLoads() {
+            if (m_pointFileLoad != nullptr) {
+                finishPointFileLoad();
+            }
+            if (m_portalFileLoad != nullptr) {
+                finishPortalFileLoad();
+            }
+        }
+
+        void MapDocument::finishPointFileLoad() {
+            assert(m_pointFileLoad != nullptr);
+            const auto load = std::move(m_pointFileLoad);
+
+            try {
+                auto pointFile = load->get();
+                if (isPointFileLoaded()) {
+                    unloadPointFile();
+                }
+
+                m_pointFilePath = load->path();
+                m_pointFile = std::move(pointFile);
+            } catch (const std::exception& exception) {
+                info("Couldn't load point file " + load->path().asString() + ": " + exception.what());
+                return;
+            }
+
+            info("Loaded point file " + m_pointFilePath.asString());
+            pointFileWasLoadedNotifier();
+        }
+
+        void MapDocument::finishPortalFileLoad() {
+            assert(m_portalFileLoad != nullptr);
+            const auto load = std::move(m_portalFileLoad);
+
+            try {
+                auto portalFile = load->get();
+                if (isPortalFileLoaded()) {
+                    unloadPortalFile();
+                }
+
+                m_portalFilePath = load->path();
+                m_portalFile = std::move(portalFile);
+            } catch (const std::exception& exception) {
+                info("Couldn't load portal file " + load->path().asString() + ": " + exception.what());
+                return;
+            }
+
+            info("Loaded portal file " + m_portalFilePath.asString());
+            portalFileWasLoadedNotifier();
+        }
+
         bool MapDocument::hasSelection() const {
             return hasSelectedNodes() || hasSelectedBrushFaces();
         }
@@ -1651,7 +1896,8 @@ namespace TrenchBroom {
                 ));
             }
 
-            const auto success = applyAndSwap(*this, commandName, nodesToTransform, kdl::overload(
+            const auto lockTextures = pref(Preferences::TextureLock);
+            const auto success = applyAndSwapInParallel(*this, commandName, nodesToTransform, kdl::overload(
                 [] (Model::Layer&) { return true; },
                 [] (Model::Group&) { return true; },
                 [&](Model::Entity& entity) {
@@ -1659,12 +1905,11 @@ namespace TrenchBroom {
                     return true;
                 },
                 [&](Model::Brush& brush)   {
-                    return brush.transform(m_worldBounds, transformation, pref(Preferences::TextureLock))
-                        .handle_errors([&](const Model::BrushError e) {
-                            error() << "Could not transform brush: " << e;
-                        });
+                    return brush.transform(m_worldBounds, transformation, lockTextures);
                 }
-            ));
+            ), [&](const Model::BrushError e) {
+                error() << "Could not transform brush: " << e;
+            });
 
             if (success) {
                 m_repeatStack->push([=]() { this->transformObjects(commandName, transformation); });
@@ -2387,6 +2632,7 @@ namespace TrenchBroom {
         }
 
         void MapDocument::pick(const vm::ray3& pickRay, Model::PickResult& pickResult) const {
+            TB_PROFILE_SCOPE("MapDocument::pick");
             if (m_world != nullptr)
                 m_world->pick(pickRay, pickResult);
         }
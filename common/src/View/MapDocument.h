@@ -26,6 +26,7 @@
 #include "Model/MapFacade.h"
 #include "Model/NodeCollection.h"
 #include "Model/NodeContents.h"
+#include "View/BackgroundLoad.h"
 #include "View/CachingLogger.h"
 
 #include <vecmath/forward.h>
@@ -98,6 +99,9 @@ namespace TrenchBroom {
             IO::Path m_pointFilePath;
             IO::Path m_portalFilePath;
 
+            std::unique_ptr<BackgroundLoad<Model::PointFile>> m_pointFileLoad;
+            std::unique_ptr<BackgroundLoad<Model::PortalFile>> m_portalFileLoad;
+
             std::unique_ptr<Assets::EntityDefinitionManager> m_entityDefinitionManager;
             std::unique_ptr<Assets::EntityModelManager> m_entityModelManager;
             std::unique_ptr<Assets::TextureManager> m_textureManager;
@@ -271,22 +275,66 @@ namespace TrenchBroom {
             std::string serializeSelectedNodes();
             std::string serializeSelectedBrushFaces();
 
+            /**
+             * Returns copies of the selected nodes, structured like the serialized selected nodes: selected brushes
+             * that belong to an entity are copied together with a copy of that entity. The caller takes ownership
+             * of the returned nodes.
+             */
+            std::vector<Model::Node*> cloneSelectedNodes() const;
+
             PasteType paste(const std::string& str);
+
+            /**
+             * Pastes the given nodes, which must not belong to any map. This document takes ownership of them.
+             */
+            PasteType paste(const std::vector<Model::Node*>& nodes);
         private:
             bool pasteNodes(const std::vector<Model::Node*>& nodes);
             bool pasteBrushFaces(const std::vector<Model::BrushFace>& faces);
         public: // point file management
+            /**
+             * Starts loading the given point file in the background. The file replaces the currently loaded point file
+             * once finishBackgroundLoads is called after it has finished loading.
+             */
             void loadPointFile(const IO::Path path);
             bool isPointFileLoaded() const;
             bool canReloadPointFile() const;
             void reloadPointFile();
             void unloadPointFile();
+
+            /**
+             * Returns the progress of the point file that is being loaded, or nullopt if no point file is being loaded.
+             */
+            std::optional<float> pointFileLoadProgress() const;
         public: // portal file management
+            /**
+             * Starts loading the given portal file in the background. The file replaces the currently loaded portal file
+             * once finishBackgroundLoads is called after it has finished loading.
+             */
             void loadPortalFile(const IO::Path path);
             bool isPortalFileLoaded() const;
             bool canReloadPortalFile() const;
             void reloadPortalFile();
             void unloadPortalFile();
+
+            /**
+             * Returns the progress of the portal file that is being loaded, or nullopt if no portal file is being loaded.
+             */
+            std::optional<float> portalFileLoadProgress() const;
+        public: // background loads
+            /**
+             * Installs the point and portal files that have finished loading in the background and notifies the
+             * observers. Must be called on the main thread.
+             */
+            void finishBackgroundLoads();
+
+            /**
+             * Blocks until all point and portal files that are being loaded have finished loading, then installs them.
+             */
+            void waitForBackgroundLoads();
+        private:
+            void finishPointFileLoad();
+            void finishPortalFileLoad();
         public: // selection
             bool hasSelection() const override;
             bool hasSelectedNodes() const override;
@@ -24,6 +24,7 @@
 #include "PreferenceManager.h"
 #include "Assets/EntityDefinitionFileSpec.h"
 #include "Assets/TextureManager.h"
+#include "IO/Path.h"
 #include "Model/Brush.h"
 #include "Model/BrushError.h"
 #include "Model/BrushFace.h"
@@ -32,6 +33,7 @@
 #include "Model/EditorContext.h"
 #include "Model/Entity.h"
 #include "Model/EntityNode.h"
+#include "Model/EntityNodeIndex.h"
 #include "Model/Game.h"
 #include "Model/GroupNode.h"
 #include "Model/Issue.h"
@@ -53,6 +55,7 @@
 #include <vecmath/segment.h>
 #include <vecmath/polygon.h>
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <string>
@@ -65,12 +68,20 @@ namespace TrenchBroom {
             return std::shared_ptr<MapDocument>(new MapDocumentCommandFacade());
         }
 
+        static size_t undoMemoryLimit() {
+            // the preference is given in megabytes
+            return static_cast<size_t>(std::max(pref(Preferences::UndoMemoryLimit), 1)) * 1024u * 1024u;
+        }
+
         MapDocumentCommandFacade::MapDocumentCommandFacade() :
         m_commandProcessor(std::make_unique<CommandProcessor>(this)) {
+            m_commandProcessor->setUndoMemoryLimit(undoMemoryLimit());
             bindObservers();
         }
 
-        MapDocumentCommandFacade::~MapDocumentCommandFacade() = default;
+        MapDocumentCommandFacade::~MapDocumentCommandFacade() {
+            unbindObservers();
+        }
 
         void MapDocumentCommandFacade::performSelect(const std::vector<Model::Node*>& nodes) {
             selectionWillChangeNotifier();
@@ -231,11 +242,14 @@ namespace TrenchBroom {
             Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
 
             std::vector<Model::Node*> addedNodes;
-            for (const auto& entry : nodes) {
-                Model::Node* parent = entry.first;
-                const std::vector<Model::Node*>& children = entry.second;
-                parent->addChildren(children);
-                addedNodes = kdl::vec_concat(std::move(addedNodes), children);
+            {
+                const auto indexBatch = Model::EntityNodeIndexBatch(m_world->entityNodeIndex());
+                for (const auto& entry : nodes) {
+                    Model::Node* parent = entry.first;
+                    const std::vector<Model::Node*>& children = entry.second;
+                    parent->addChildren(children);
+                    addedNodes = kdl::vec_concat(std::move(addedNodes), children);
+                }
             }
 
             setEntityDefinitions(addedNodes);
@@ -304,17 +318,21 @@ namespace TrenchBroom {
             Notifier<>::NotifyBeforeAndAfter notifyEntityDefinitions(notifyEntityDefinitionsChange, entityDefinitionsWillChangeNotifier, entityDefinitionsDidChangeNotifier);
             Notifier<>::NotifyBeforeAndAfter notifyMods(notifyModsChange, modsWillChangeNotifier, modsDidChangeNotifier);
 
-            for (auto& pair : nodesToSwap) {
-                auto* node = pair.first;
-                auto& contents = pair.second.get();
-
-                pair.second = node->accept(kdl::overload(
-                    [&](Model::WorldNode* worldNode)   -> Model::NodeContents { return Model::NodeContents(worldNode->setEntity(std::get<Model::Entity>(std::move(contents)))); },
-                    [&](Model::LayerNode* layerNode)   -> Model::NodeContents { return Model::NodeContents(layerNode->setLayer(std::get<Model::Layer>(std::move(contents)))); },
-                    [&](Model::GroupNode* groupNode)   -> Model::NodeContents { return Model::NodeContents(groupNode->setGroup(std::get<Model::Group>(std::move(contents)))); },
-                    [&](Model::EntityNode* entityNode) -> Model::NodeContents { return Model::NodeContents(entityNode->setEntity(std::get<Model::Entity>(std::move(contents)))); },
-                    [&](Model::BrushNode* brushNode)   -> Model::NodeContents { return Model::NodeContents(brushNode->setBrush(std::get<Model::Brush>(std::move(contents)))); }
-                ));
+            {
+                const auto indexBatch = Model::EntityNodeIndexBatch(m_world->entityNodeIndex());
+                const auto nodeTreeBatch = Model::NodeTreeBatch(*m_world);
+                for (auto& pair : nodesToSwap) {
+                    auto* node = pair.first;
+                    auto& contents = pair.second.get();
+
+                    pair.second = node->accept(kdl::overload(
+                        [&](Model::WorldNode* worldNode)   -> Model::NodeContents { return Model::NodeContents(worldNode->setEntity(std::get<Model::Entity>(std::move(contents)))); },
+                        [&](Model::LayerNode* layerNode)   -> Model::NodeContents { return Model::NodeContents(layerNode->setLayer(std::get<Model::Layer>(std::move(contents)))); },
+                        [&](Model::GroupNode* groupNode)   -> Model::NodeContents { return Model::NodeContents(groupNode->setGroup(std::get<Model::Group>(std::move(contents)))); },
+                        [&](Model::EntityNode* entityNode) -> Model::NodeContents { return Model::NodeContents(entityNode->setEntity(std::get<Model::Entity>(std::move(contents)))); },
+                        [&](Model::BrushNode* brushNode)   -> Model::NodeContents { return Model::NodeContents(brushNode->setBrush(std::get<Model::Brush>(std::move(contents)))); }
+                    ));
+                }
             }
 
             if (!notifyEntityDefinitionsChange && !notifyModsChange) {
@@ -450,6 +468,14 @@ namespace TrenchBroom {
             m_commandProcessor->transactionUndoneNotifier.addObserver(transactionUndoneNotifier);
             documentWasNewedNotifier.addObserver(this, &MapDocumentCommandFacade::documentWasNewed);
             documentWasLoadedNotifier.addObserver(this, &MapDocumentCommandFacade::documentWasLoaded);
+
+            PreferenceManager& prefs = PreferenceManager::instance();
+            prefs.preferenceDidChangeNotifier.addObserver(this, &MapDocumentCommandFacade::undoPreferenceDidChange);
+        }
+
+        void MapDocumentCommandFacade::unbindObservers() {
+            PreferenceManager& prefs = PreferenceManager::instance();
+            prefs.preferenceDidChangeNotifier.removeObserver(this, &MapDocumentCommandFacade::undoPreferenceDidChange);
         }
 
         void MapDocumentCommandFacade::documentWasNewed(MapDocument*) {
@@ -460,6 +486,12 @@ namespace TrenchBroom {
             m_commandProcessor->clear();
         }
 
+        void MapDocumentCommandFacade::undoPreferenceDidChange(const IO::Path& path) {
+            if (path == Preferences::UndoMemoryLimit.path()) {
+                m_commandProcessor->setUndoMemoryLimit(undoMemoryLimit());
+            }
+        }
+
         bool MapDocumentCommandFacade::doCanUndoCommand() const {
             return m_commandProcessor->canUndo();
         }
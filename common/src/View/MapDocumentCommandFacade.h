@@ -102,8 +102,10 @@ namespace TrenchBroom {
             void decModificationCount(size_t delta = 1);
         private: // notification
             void bindObservers();
+            void unbindObservers();
             void documentWasNewed(MapDocument* document);
             void documentWasLoaded(MapDocument* document);
+            void undoPreferenceDidChange(const IO::Path& path);
         private: // implement MapDocument interface
             bool doCanUndoCommand() const override;
             bool doCanRedoCommand() const override;
@@ -69,6 +69,7 @@
 #include "View/ViewUtils.h"
 #include "View/QtUtils.h"
 #include "View/MapViewToolBox.h"
+#include "View/NodeClipboard.h"
 
 #include <kdl/overload.h>
 #include <kdl/string_format.h>
@@ -80,6 +81,7 @@
 #include <cassert>
 #include <chrono>
 #include <iterator>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -109,8 +111,9 @@ namespace TrenchBroom {
         m_frameManager(frameManager),
         m_document(std::move(document)),
         m_lastInputTime(std::chrono::system_clock::now()),
-        m_autosaver(std::make_unique<Autosaver>(m_document)),
+        m_autosaver(std::make_unique<Autosaver>(m_document, std::chrono::minutes(10), 50u, 20u)),
         m_autosaveTimer(nullptr),
+        m_backgroundLoadTimer(nullptr),
         m_toolBar(nullptr),
         m_hSplitter(nullptr),
         m_vSplitter(nullptr),
@@ -150,6 +153,9 @@ namespace TrenchBroom {
             m_autosaveTimer = new QTimer(this);
             m_autosaveTimer->start(1000);
 
+            m_backgroundLoadTimer = new QTimer(this);
+            m_backgroundLoadTimer->start(100);
+
             bindObservers();
             bindEvents();
 
@@ -186,6 +192,7 @@ namespace TrenchBroom {
             // let's trigger a final autosave before releasing the document
             NullLogger logger;
             m_autosaver->triggerAutosave(logger);
+            m_autosaver->waitForPendingSave(logger);
 
             m_document->setViewEffectsService(nullptr);
             m_document.reset();
@@ -598,7 +605,14 @@ namespace TrenchBroom {
         }
 
         void MapFrame::updateStatusBar() {
-            m_statusBarLabel->setText(QString(describeSelection(m_document.get())));
+            auto text = describeSelection(m_document.get());
+            if (const auto progress = m_document->pointFileLoadProgress()) {
+                text += QString::fromLatin1("   |   ") + tr("Loading point file (%1%)").arg(static_cast<int>(*progress * 100.0f));
+            }
+            if (const auto progress = m_document->portalFileLoadProgress()) {
+                text += QString::fromLatin1("   |   ") + tr("Loading portal file (%1%)").arg(static_cast<int>(*progress * 100.0f));
+            }
+            m_statusBarLabel->setText(text);
         }
 
         void MapFrame::bindObservers() {
@@ -740,6 +754,7 @@ namespace TrenchBroom {
 
         void MapFrame::bindEvents() {
             connect(m_autosaveTimer, &QTimer::timeout, this, &MapFrame::triggerAutosave);
+            connect(m_backgroundLoadTimer, &QTimer::timeout, this, &MapFrame::finishBackgroundLoads);
             connect(qApp, &QApplication::focusChanged, this, &MapFrame::focusChange);
             connect(m_gridChoice, QOverload<int>::of(&QComboBox::activated), this, [this](const int index) { setGridSize(index + Grid::MinSize); });
             connect(QApplication::clipboard(), &QClipboard::dataChanged, this, [this]() {
@@ -1056,17 +1071,47 @@ namespace TrenchBroom {
             }
         }
 
+        /**
+         * Identifies the nodes held by the node clipboard of this process.
+         */
+        static const auto NodeClipboardMimeType = QString("application/x-trenchbroom-nodes");
+
+        static QByteArray nodeClipboardId(const size_t id) {
+            return QString("%1:%2").arg(QCoreApplication::applicationPid()).arg(id).toUtf8();
+        }
+
+        /**
+         * Returns nothing if the given ID was not put on the clipboard by this process.
+         */
+        static std::optional<size_t> parseNodeClipboardId(const QByteArray& data) {
+            const auto parts = data.split(':');
+            if (parts.size() != 2 || parts[0].toLongLong() != QCoreApplication::applicationPid()) {
+                return std::nullopt;
+            }
+
+            bool ok = false;
+            const auto id = parts[1].toULongLong(&ok);
+            return ok ? std::optional<size_t>(static_cast<size_t>(id)) : std::nullopt;
+        }
+
         void MapFrame::copyToClipboard() {
             QClipboard *clipboard = QApplication::clipboard();
+            auto* mimeData = new QMimeData();
 
             std::string str;
             if (m_document->hasSelectedNodes()) {
                 str = m_document->serializeSelectedNodes();
+
+                // pasting the copied nodes into a map in this process does not need to parse the text
+                auto& nodeClipboard = NodeClipboard::instance();
+                const auto id = nodeClipboard.setNodes(m_document->world()->mapFormat(), m_document->worldBounds(), m_document->cloneSelectedNodes());
+                mimeData->setData(NodeClipboardMimeType, nodeClipboardId(id));
             } else if (m_document->hasSelectedBrushFaces()) {
                 str = m_document->serializeSelectedBrushFaces();
             }
 
-            clipboard->setText(mapStringToUnicode(m_document->encoding(), str));
+            mimeData->setText(mapStringToUnicode(m_document->encoding(), str));
+            clipboard->setMimeData(mimeData);
         }
 
         bool MapFrame::canCutSelection() const {
@@ -1104,6 +1149,16 @@ namespace TrenchBroom {
 
         PasteType MapFrame::paste() {
             auto *clipboard = QApplication::clipboard();
+
+            if (const auto* mimeData = clipboard->mimeData(); mimeData != nullptr && mimeData->hasFormat(NodeClipboardMimeType)) {
+                if (const auto id = parseNodeClipboardId(mimeData->data(NodeClipboardMimeType))) {
+                    const auto nodes = NodeClipboard::instance().cloneNodes(*id, m_document->world()->mapFormat(), m_document->worldBounds());
+                    if (!nodes.empty()) {
+                        return m_document->paste(nodes);
+                    }
+                }
+            }
+
             const auto qtext = clipboard->text();
 
             if (qtext.isEmpty()) {
@@ -1847,6 +1902,14 @@ namespace TrenchBroom {
             }
         }
 
+        void MapFrame::finishBackgroundLoads() {
+            const auto loading = m_document->pointFileLoadProgress() || m_document->portalFileLoadProgress();
+            m_document->finishBackgroundLoads();
+            if (loading) {
+                updateStatusBar();
+            }
+        }
+
         // DebugPaletteWindow
 
         DebugPaletteWindow::DebugPaletteWindow(QWidget *parent)
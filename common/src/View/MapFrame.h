@@ -83,6 +83,7 @@ namespace TrenchBroom {
             std::chrono::time_point<std::chrono::system_clock> m_lastInputTime;
             std::unique_ptr<Autosaver> m_autosaver;
             QTimer* m_autosaveTimer;
+            QTimer* m_backgroundLoadTimer;
 
             QToolBar* m_toolBar;
 
@@ -375,6 +376,7 @@ namespace TrenchBroom {
             bool eventFilter(QObject* target, QEvent* event) override;
         private:
             void triggerAutosave();
+            void finishBackgroundLoads();
         };
 
         class DebugPaletteWindow : public QDialog {
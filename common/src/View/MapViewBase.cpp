@@ -68,8 +68,10 @@
 #include <kdl/string_compare.h>
 #include <kdl/string_format.h>
 
+#include <vecmath/bbox.h>
 #include <vecmath/polygon.h>
 #include <vecmath/util.h>
+#include <vecmath/vec.h>
 
 #include <sstream>
 #include <vector>
@@ -94,6 +96,7 @@ namespace TrenchBroom {
         m_renderer(renderer),
         m_compass(nullptr),
         m_portalFileRenderer(nullptr),
+        m_portalFileRendererPosition(vm::vec3f::zero()),
         m_isCurrent(false) {
             setToolBox(toolBox);
             bindObservers();
@@ -257,6 +260,8 @@ namespace TrenchBroom {
         void MapViewBase::preferenceDidChange(const IO::Path& path) {
             if(path == Preferences::RendererFontSize.path()) {
                 fontManager().clearCache();
+            } else if (path == Preferences::PortalFileRenderDistance.path()) {
+                invalidatePortalFileRenderer();
             }
 
             updateActionBindings();
@@ -920,6 +925,14 @@ namespace TrenchBroom {
         }
 
         void MapViewBase::renderPortalFile(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch) {
+            // only the portals near the camera are rendered, so they must be collected again once the camera has moved
+            // far enough to bring other portals into range
+            const auto distance = pref(Preferences::PortalFileRenderDistance);
+            if (m_portalFileRenderer != nullptr && renderContext.render3D() && distance > 0.0f &&
+                vm::length(renderContext.camera().position() - m_portalFileRendererPosition) > distance / 8.0f) {
+                invalidatePortalFileRenderer();
+            }
+
             if (m_portalFileRenderer == nullptr) {
                 validatePortalFileRenderer(renderContext);
                 assert(m_portalFileRenderer != nullptr);
@@ -931,24 +944,39 @@ namespace TrenchBroom {
             m_portalFileRenderer = nullptr;
         }
 
-        void MapViewBase::validatePortalFileRenderer(Renderer::RenderContext&) {
+        static void renderPortal(Renderer::PrimitiveRenderer& renderer, const vm::polygon3f& poly) {
+            renderer.renderFilledPolygon(pref(Preferences::PortalFileFillColor),
+                                         Renderer::PrimitiveRendererOcclusionPolicy::Hide,
+                                         Renderer::PrimitiveRendererCullingPolicy::ShowBackfaces,
+                                         poly.vertices());
+
+            const auto lineWidth = 4.0f;
+            renderer.renderPolygon(pref(Preferences::PortalFileBorderColor),
+                                   lineWidth,
+                                   Renderer::PrimitiveRendererOcclusionPolicy::Hide,
+                                   poly.vertices());
+        }
+
+        void MapViewBase::validatePortalFileRenderer(Renderer::RenderContext& renderContext) {
             assert(m_portalFileRenderer == nullptr);
             m_portalFileRenderer = std::make_unique<Renderer::PrimitiveRenderer>();
 
             auto document = kdl::mem_lock(m_document);
             Model::PortalFile* portalFile = document->portalFile();
             if (portalFile != nullptr) {
-                for (const auto& poly : portalFile->portals()) {
-                    m_portalFileRenderer->renderFilledPolygon(pref(Preferences::PortalFileFillColor),
-                                                              Renderer::PrimitiveRendererOcclusionPolicy::Hide,
-                                                              Renderer::PrimitiveRendererCullingPolicy::ShowBackfaces,
-                                                              poly.vertices());
-
-                    const auto lineWidth = 4.0f;
-                    m_portalFileRenderer->renderPolygon(pref(Preferences::PortalFileBorderColor),
-                                                        lineWidth,
-                                                        Renderer::PrimitiveRendererOcclusionPolicy::Hide,
-                                                        poly.vertices());
+                const auto& portals = portalFile->portals();
+                const auto distance = pref(Preferences::PortalFileRenderDistance);
+                if (renderContext.render3D() && distance > 0.0f) {
+                    m_portalFileRendererPosition = renderContext.camera().position();
+                    const auto bounds = vm::bbox3f(m_portalFileRendererPosition - vm::vec3f::fill(distance),
+                                                   m_portalFileRendererPosition + vm::vec3f::fill(distance));
+                    for (const auto index : portalFile->findPortals(bounds)) {
+                        renderPortal(*m_portalFileRenderer, portals[index]);
+                    }
+                } else {
+                    for (const auto& poly : portals) {
+                        renderPortal(*m_portalFileRenderer, poly);
+                    }
                 }
             }
         }
@@ -25,6 +25,8 @@
 #include "View/RenderView.h"
 #include "View/ToolBoxConnector.h"
 
+#include <vecmath/vec.h>
+
 #include <memory>
 #include <utility>
 #include <vector>
@@ -89,6 +91,7 @@ namespace TrenchBroom {
             Renderer::MapRenderer& m_renderer;
             std::unique_ptr<Renderer::Compass> m_compass;
             std::unique_ptr<Renderer::PrimitiveRenderer> m_portalFileRenderer;
+            vm::vec3f m_portalFileRendererPosition;
 
             /**
              * Tracks whether this map view has most recently gotten the focus. This is tracked and updated by a
@@ -0,0 +1,103 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NodeClipboard.h"
+
+#include "Model/Brush.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushNode.h"
+#include "Model/Entity.h"
+#include "Model/EntityNode.h"
+#include "Model/GroupNode.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/Node.h"
+#include "Model/WorldNode.h"
+
+#include <kdl/overload.h>
+#include <kdl/vector_utils.h>
+
+#include <utility>
+
+namespace TrenchBroom {
+    namespace View {
+        NodeClipboard::NodeClipboard() :
+        m_id(0u),
+        m_mapFormat(Model::MapFormat::Unknown) {}
+
+        NodeClipboard::~NodeClipboard() {
+            clear();
+        }
+
+        NodeClipboard& NodeClipboard::instance() {
+            static NodeClipboard Instance;
+            return Instance;
+        }
+
+        /**
+         * Removes the references to textures, entity definitions and entity models from the given nodes. These assets
+         * belong to the document that the nodes were copied from, and they may be deleted while the nodes are held by
+         * the clipboard. The document that the nodes are pasted into sets its own assets when the nodes are added.
+         */
+        static void stripAssets(const std::vector<Model::Node*>& nodes) {
+            Model::Node::visitAll(nodes, kdl::overload(
+                [](auto&& thisLambda, Model::WorldNode* world) { world->visitChildren(thisLambda); },
+                [](auto&& thisLambda, Model::LayerNode* layer) { layer->visitChildren(thisLambda); },
+                [](auto&& thisLambda, Model::GroupNode* group) { group->visitChildren(thisLambda); },
+                [](auto&& thisLambda, Model::EntityNode* entityNode) {
+                    auto entity = entityNode->entity();
+                    entity.setDefinition(nullptr);
+                    entity.setModel(nullptr);
+                    entityNode->setEntity(std::move(entity));
+                    entityNode->visitChildren(thisLambda);
+                },
+                [](Model::BrushNode* brushNode) {
+                    auto brush = brushNode->brush();
+                    for (auto& face : brush.faces()) {
+                        face.setTexture(nullptr);
+                    }
+                    brushNode->setBrush(std::move(brush));
+                }
+            ));
+        }
+
+        size_t NodeClipboard::setNodes(const Model::MapFormat mapFormat, const vm::bbox3& worldBounds, std::vector<Model::Node*> nodes) {
+            clear();
+
+            m_mapFormat = mapFormat;
+            m_worldBounds = worldBounds;
+            m_nodes = std::move(nodes);
+            stripAssets(m_nodes);
+            return m_id;
+        }
+
+        void NodeClipboard::clear() {
+            kdl::vec_clear_and_delete(m_nodes);
+            m_mapFormat = Model::MapFormat::Unknown;
+            ++m_id;
+        }
+
+        std::vector<Model::Node*> NodeClipboard::cloneNodes(const size_t id, const Model::MapFormat mapFormat, const vm::bbox3& worldBounds) const {
+            if (id != m_id || mapFormat != m_mapFormat || worldBounds != m_worldBounds) {
+                return {};
+            }
+            return Model::Node::cloneRecursively(worldBounds, m_nodes);
+        }
+    }
+}
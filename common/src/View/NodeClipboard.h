@@ -0,0 +1,83 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "FloatType.h"
+#include "Macros.h"
+
+#include <vecmath/bbox.h>
+
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        enum class MapFormat;
+        class Node;
+    }
+
+    namespace View {
+        /**
+         * Holds copies of the nodes that were most recently copied to the clipboard by this process. Pasting them
+         * into a map with the same format and world bounds clones the copies instead of parsing the text that was put
+         * on the system clipboard, which would rebuild the geometry of every brush.
+         *
+         * The text is still put on the system clipboard so that other applications and other instances of
+         * TrenchBroom can paste it. Every copy receives a new ID which is stored on the system clipboard along with
+         * the text, so that the copied nodes are only pasted if the system clipboard still holds the text they were
+         * copied with.
+         */
+        class NodeClipboard {
+        private:
+            size_t m_id;
+            Model::MapFormat m_mapFormat;
+            vm::bbox3 m_worldBounds;
+            std::vector<Model::Node*> m_nodes;
+        public:
+            NodeClipboard();
+            ~NodeClipboard();
+
+            static NodeClipboard& instance();
+
+            /**
+             * Replaces the contents of this clipboard with the given nodes, which were copied from a map with the
+             * given format and world bounds. This clipboard takes ownership of the given nodes and removes their
+             * references to the assets of the document they were copied from.
+             *
+             * @return the ID of the new contents
+             */
+            size_t setNodes(Model::MapFormat mapFormat, const vm::bbox3& worldBounds, std::vector<Model::Node*> nodes);
+
+            /**
+             * Deletes the contents of this clipboard.
+             */
+            void clear();
+
+            /**
+             * Returns clones of the nodes with the given ID if they can be pasted into a map with the given format
+             * and world bounds. Returns an empty vector if the contents of this clipboard have been replaced since the
+             * given ID was returned by setNodes, or if the nodes were copied from an incompatible map. The caller
+             * takes ownership of the returned nodes.
+             */
+            std::vector<Model::Node*> cloneNodes(size_t id, Model::MapFormat mapFormat, const vm::bbox3& worldBounds) const;
+
+            deleteCopyAndMove(NodeClipboard)
+        };
+    }
+}
@@ -79,6 +79,12 @@ namespace TrenchBroom {
 
         SelectionCommand::~SelectionCommand() = default;
 
+        size_t SelectionCommand::memorySize() const {
+            return UndoableCommand::memorySize()
+                + (m_nodes.capacity() + m_previouslySelectedNodes.capacity()) * sizeof(Model::Node*)
+                + (m_faceRefs.capacity() + m_previouslySelectedFaceRefs.capacity()) * sizeof(Model::BrushFaceReference);
+        }
+
         std::string SelectionCommand::makeName(const Action action, const size_t nodeCount, const size_t faceCount) {
             std::stringstream result;
             switch (action) {
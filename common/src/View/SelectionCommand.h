@@ -74,6 +74,8 @@ namespace TrenchBroom {
 
             SelectionCommand(Action action, const std::vector<Model::Node*>& nodes, const std::vector<Model::BrushFaceHandle>& faces);
             ~SelectionCommand() override;
+
+            size_t memorySize() const override;
         private:
             static std::string makeName(Action action, size_t nodeCount, size_t faceCount);
 
@@ -21,6 +21,7 @@
 
 #include "Model/Brush.h"
 #include "Model/Entity.h"
+#include "Model/ModelUtils.h"
 #include "Model/Node.h"
 #include "View/MapDocumentCommandFacade.h"
 
@@ -56,5 +57,13 @@ namespace TrenchBroom {
             kdl::vec_sort(theirNodes);
             return myNodes == theirNodes;
         }
+
+        size_t SwapNodeContentsCommand::memorySize() const {
+            size_t result = DocumentCommand::memorySize();
+            for (const auto& pair : m_nodes) {
+                result += sizeof(pair) + Model::estimateMemorySize(pair.second);
+            }
+            return result;
+        }
     }
 }
@@ -50,6 +50,8 @@ namespace TrenchBroom {
 
             bool doCollateWith(UndoableCommand* command) override;
 
+            size_t memorySize() const override;
+
             deleteCopyAndMove(SwapNodeContentsCommand)
         };
     }
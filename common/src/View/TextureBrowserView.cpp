@@ -25,6 +25,7 @@
 #include "Assets/Texture.h"
 #include "Assets/TextureCollection.h"
 #include "Assets/TextureManager.h"
+#include "Assets/TextureNameIndex.h"
 #include "Renderer/GL.h"
 #include "Renderer/FontManager.h"
 #include "Renderer/PrimType.h"
@@ -63,7 +64,8 @@ namespace TrenchBroom {
         m_group(false),
         m_hideUnused(false),
         m_sortOrder(TextureSortOrder::Name),
-        m_selectedTexture(nullptr) {
+        m_selectedTexture(nullptr),
+        m_cellCacheWidth(0.0f) {
             auto doc = kdl::mem_lock(m_document);
             doc->textureUsageCountsDidChangeNotifier.addObserver(this, &TextureBrowserView::usageCountDidChange);
         }
@@ -155,20 +157,56 @@ namespace TrenchBroom {
 
             const Renderer::FontDescriptor font(fontPath, static_cast<size_t>(fontSize));
 
+            // only keep the cached cells if they were measured with the same font and cell width, and drop the
+            // cells which are not part of the new layout
+            auto previousCells = CellCache();
+            if (m_cellCacheFont && m_cellCacheFont->compare(font) == 0 && m_cellCacheWidth == layout.maxCellWidth()) {
+                previousCells = std::move(m_cellCache);
+            }
+            m_cellCache.clear();
+            m_cellCacheFont = font;
+            m_cellCacheWidth = layout.maxCellWidth();
+
             if (m_group) {
-                for (const Assets::TextureCollection& collection : getCollections()) {
-                    layout.addGroup(collection.name(), static_cast<float>(fontSize) + 2.0f);
-                    for (const Assets::Texture* texture : getTextures(collection))
-                        addTextureToLayout(layout, texture, collection.name(), font);
+                const auto& collections = getCollections();
+                for (size_t i = 0; i < collections.size(); ++i) {
+                    const auto collectionName = collections[i].name();
+                    layout.addGroup(collectionName, static_cast<float>(fontSize) + 2.0f);
+                    for (const Assets::Texture* texture : getTextures(i))
+                        addTextureToLayout(layout, texture, collectionName, font, previousCells);
                 }
             } else {
                 for (const Assets::Texture* texture : getTextures())
-                    addTextureToLayout(layout, texture, "", font);
+                    addTextureToLayout(layout, texture, "", font, previousCells);
             }
         }
 
-        void TextureBrowserView::addTextureToLayout(Layout& layout, const Assets::Texture* texture, const std::string& groupName, const Renderer::FontDescriptor& font) {
+        void TextureBrowserView::addTextureToLayout(Layout& layout, const Assets::Texture* texture, const std::string& groupName, const Renderer::FontDescriptor& font, CellCache& previousCells) {
             const float maxCellWidth = layout.maxCellWidth();
+            const auto& cell = cachedCell(texture, groupName, font, maxCellWidth, previousCells);
+
+            const float scaleFactor = pref(Preferences::TextureBrowserIconSize);
+            const float scaledTextureWidth = vm::round(scaleFactor * static_cast<float>(texture->width()));
+            const float scaledTextureHeight = vm::round(scaleFactor * static_cast<float>(texture->height()));
+
+            auto cellData = std::make_shared<TextureCellData>(cell.cellData);
+            cellData->texture = texture;
+
+            layout.addItem(QVariant::fromValue(cellData),
+            scaledTextureWidth,
+            scaledTextureHeight,
+            maxCellWidth,
+            cell.titleHeight);
+        }
+
+        const TextureBrowserView::CachedCell& TextureBrowserView::cachedCell(const Assets::Texture* texture, const std::string& groupName, const Renderer::FontDescriptor& font, const float maxCellWidth, CellCache& previousCells) {
+            auto key = CellCacheKey(texture->name(), groupName);
+            if (const auto it = m_cellCache.find(key); it != std::end(m_cellCache)) {
+                return it->second;
+            }
+            if (auto node = previousCells.extract(key)) {
+                return m_cellCache.insert(std::move(node)).position->second;
+            }
 
             const auto  textureName = IO::Path(texture->name()).lastComponent().asString();
 
@@ -181,25 +219,20 @@ namespace TrenchBroom {
 
             const auto totalSize = vm::vec2f(vm::max(groupNameSize.x(), textureNameSize.x()), 2.0f * defaultTextHeight + 4.0f);
 
-            const float scaleFactor = pref(Preferences::TextureBrowserIconSize);
-            const float scaledTextureWidth = vm::round(scaleFactor * static_cast<float>(texture->width()));
-            const float scaledTextureHeight = vm::round(scaleFactor * static_cast<float>(texture->height()));
-
-            auto cellData = std::shared_ptr<TextureCellData>(new TextureCellData{
-                texture,
-                textureName,
-                groupName,
-                vm::vec2f((maxCellWidth - textureNameSize.x()) / 2.0f, defaultTextHeight + 3.0f),
-                vm::vec2f((maxCellWidth - groupNameSize.x()) / 2.0f, 1.0f),
-                textureFont,
-                groupFont
-            });
+            auto cell = CachedCell{
+                TextureCellData{
+                    nullptr,
+                    textureName,
+                    groupName,
+                    vm::vec2f((maxCellWidth - textureNameSize.x()) / 2.0f, defaultTextHeight + 3.0f),
+                    vm::vec2f((maxCellWidth - groupNameSize.x()) / 2.0f, 1.0f),
+                    textureFont,
+                    groupFont
+                },
+                totalSize.y()
+            };
 
-            layout.addItem(QVariant::fromValue(cellData),
-            scaledTextureWidth,
-            scaledTextureHeight,
-            maxCellWidth,
-            totalSize.y());
+            return m_cellCache.emplace(std::move(key), std::move(cell)).first->second;
         }
 
         struct TextureBrowserView::CompareByUsageCount {
@@ -232,41 +265,33 @@ namespace TrenchBroom {
             }
         };
 
-        struct TextureBrowserView::MatchName {
-            std::string pattern;
-
-            explicit MatchName(const std::string& i_pattern) : pattern(i_pattern) {}
-
-            bool operator()(const Assets::Texture* texture) const {
-                return !kdl::ci::str_contains(texture->name(), pattern);
-            }
-        };
-
         const std::vector<Assets::TextureCollection>& TextureBrowserView::getCollections() const {
             auto doc = kdl::mem_lock(m_document);
             return doc->textureManager().collections();
         }
 
-        std::vector<const Assets::Texture*> TextureBrowserView::getTextures(const Assets::TextureCollection& collection) const {
-            auto textures = kdl::vec_transform(collection.textures(), [](const auto& t) { return &t; });
-            filterTextures(textures);
+        std::vector<const Assets::Texture*> TextureBrowserView::getTextures(const size_t collectionIndex) const {
+            auto doc = kdl::mem_lock(m_document);
+            auto textures = filterTextures(doc->textureManager().collectionNameIndex(collectionIndex));
             sortTextures(textures);
             return textures;
         }
 
         std::vector<const Assets::Texture*> TextureBrowserView::getTextures() const {
             auto doc = kdl::mem_lock(m_document);
-            auto textures = doc->textureManager().textures();
-            filterTextures(textures);
-            sortTextures(textures);
+            auto textures = filterTextures(doc->textureManager().textureNameIndex());
+            // the texture manager's index is already sorted by name
+            if (m_sortOrder != TextureSortOrder::Name) {
+                sortTextures(textures);
+            }
             return textures;
         }
 
-        void TextureBrowserView::filterTextures(std::vector<const Assets::Texture*>& textures) const {
+        std::vector<const Assets::Texture*> TextureBrowserView::filterTextures(const Assets::TextureNameIndex& index) const {
+            auto textures = index.findTextures(m_filterText);
             if (m_hideUnused)
                 textures = kdl::vec_erase_if(std::move(textures), MatchUsageCount());
-            if (!m_filterText.empty())
-                textures = kdl::vec_erase_if(std::move(textures), MatchName(m_filterText));
+            return textures;
         }
 
         void TextureBrowserView::sortTextures(std::vector<const Assets::Texture*>& textures) const {
@@ -280,7 +305,9 @@ namespace TrenchBroom {
             }
         }
 
-        void TextureBrowserView::doClear() {}
+        void TextureBrowserView::doClear() {
+            m_cellCache.clear();
+        }
 
         void TextureBrowserView::doRender(Layout& layout, const float y, const float height) {
             auto doc = kdl::mem_lock(m_document);
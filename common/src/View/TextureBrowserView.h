@@ -25,7 +25,9 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 class QScrollBar;
@@ -34,6 +36,7 @@ namespace TrenchBroom {
     namespace Assets {
         class Texture;
         class TextureCollection;
+        class TextureNameIndex;
     }
 
     namespace View {
@@ -62,6 +65,17 @@ namespace TrenchBroom {
             using TextVertex = Renderer::GLVertexTypes::P2T2C4::Vertex;
             using StringMap = std::map<Renderer::FontDescriptor, std::vector<TextVertex>>;
 
+            /**
+             * Measuring the cell titles is expensive, so the measured cells are cached by texture name and group
+             * name and reused when the layout is reloaded.
+             */
+            struct CachedCell {
+                TextureCellData cellData;
+                float titleHeight;
+            };
+            using CellCacheKey = std::pair<std::string, std::string>;
+            using CellCache = std::map<CellCacheKey, CachedCell>;
+
             std::weak_ptr<MapDocument> m_document;
             bool m_group;
             bool m_hideUnused;
@@ -69,6 +83,10 @@ namespace TrenchBroom {
             std::string m_filterText;
 
             const Assets::Texture* m_selectedTexture;
+
+            CellCache m_cellCache;
+            std::optional<Renderer::FontDescriptor> m_cellCacheFont;
+            float m_cellCacheWidth;
         public:
             TextureBrowserView(QScrollBar* scrollBar,
                                GLContextManager& contextManager,
@@ -89,18 +107,18 @@ namespace TrenchBroom {
 
             void doInitLayout(Layout& layout) override;
             void doReloadLayout(Layout& layout) override;
-            void addTextureToLayout(Layout& layout, const Assets::Texture* texture, const std::string& groupName, const Renderer::FontDescriptor& font);
+            void addTextureToLayout(Layout& layout, const Assets::Texture* texture, const std::string& groupName, const Renderer::FontDescriptor& font, CellCache& previousCells);
+            const CachedCell& cachedCell(const Assets::Texture* texture, const std::string& groupName, const Renderer::FontDescriptor& font, float maxCellWidth, CellCache& previousCells);
 
             struct CompareByUsageCount;
             struct CompareByName;
             struct MatchUsageCount;
-            struct MatchName;
 
             const std::vector<Assets::TextureCollection>& getCollections() const;
-            std::vector<const Assets::Texture*> getTextures(const Assets::TextureCollection& collection) const;
+            std::vector<const Assets::Texture*> getTextures(size_t collectionIndex) const;
             std::vector<const Assets::Texture*> getTextures() const;
 
-            void filterTextures(std::vector<const Assets::Texture*>& textures) const;
+            std::vector<const Assets::Texture*> filterTextures(const Assets::TextureNameIndex& index) const;
             void sortTextures(std::vector<const Assets::Texture*>& textures) const;
 
             void doClear() override;
@@ -48,6 +48,10 @@ namespace TrenchBroom {
             return doCollateWith(command);
         }
 
+        size_t UndoableCommand::memorySize() const {
+            return sizeof(UndoableCommand) + m_name.capacity();
+        }
+
         size_t UndoableCommand::documentModificationCount() const {
             throw CommandProcessorException("Command does not modify the document");
         }
@@ -38,6 +38,13 @@ namespace TrenchBroom {
             virtual std::unique_ptr<CommandResult> performUndo(MapDocumentCommandFacade* document);
 
             virtual bool collateWith(UndoableCommand* command);
+
+            /**
+             * Returns an estimate of the number of bytes held by this command. The command processor uses this to
+             * limit the memory held by the undo stack, so commands which store copies of nodes or node contents should
+             * account for them.
+             */
+            virtual size_t memorySize() const;
         private:
             virtual std::unique_ptr<CommandResult> doPerformUndo(MapDocumentCommandFacade* document) = 0;
 
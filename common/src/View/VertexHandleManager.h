@@ -20,6 +20,7 @@
 #pragma once
 
 #include "FloatType.h"
+#include "Macros.h"
 #include "Model/BrushNode.h"
 #include "Model/BrushFace.h"
 #include "Model/HitType.h"
@@ -28,10 +29,20 @@
 
 #include <kdl/vector_set.h>
 
+#include <vecmath/bbox.h>
+#include <vecmath/intersection.h>
+#include <vecmath/polygon.h>
+#include <vecmath/ray.h>
+#include <vecmath/scalar.h>
 #include <vecmath/segment.h>
+#include <vecmath/vec.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <iterator>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom {
@@ -91,6 +102,43 @@ namespace TrenchBroom {
             virtual void removeHandles(const Model::BrushNode* brushNode) = 0;
         };
 
+        /**
+         * Returns the position at which the given handle is stored in the spatial index of a handle manager.
+         */
+        inline vm::vec3 handleCenter(const vm::vec3& handle) {
+            return handle;
+        }
+
+        inline vm::vec3 handleCenter(const vm::segment3& handle) {
+            return handle.center();
+        }
+
+        inline vm::vec3 handleCenter(const vm::polygon3& handle) {
+            return handle.center();
+        }
+
+        /**
+         * Returns the bounds of the given handle. Picking a handle always yields a point within these bounds.
+         */
+        inline vm::bbox3 handleBounds(const vm::vec3& handle) {
+            return vm::bbox3(handle, handle);
+        }
+
+        inline vm::bbox3 handleBounds(const vm::segment3& handle) {
+            vm::bbox3::builder builder;
+            builder.add(handle.start());
+            builder.add(handle.end());
+            return builder.bounds();
+        }
+
+        inline vm::bbox3 handleBounds(const vm::polygon3& handle) {
+            vm::bbox3::builder builder;
+            for (const auto& vertex : handle) {
+                builder.add(vertex);
+            }
+            return builder.bounds();
+        }
+
         template <typename H>
         class VertexHandleManagerBaseT : public VertexHandleManagerBase {
         public:
@@ -169,11 +217,44 @@ namespace TrenchBroom {
              * The total number of selected handles, not counting duplicates.
              */
             size_t m_selectedHandleCount;
+        private:
+            /**
+             * The edge length of the cells of the spatial index.
+             */
+            static constexpr FloatType CellSize = static_cast<FloatType>(256.0);
+
+            using CellKey = std::array<long, 3>;
+
+            struct CellKeyHash {
+                size_t operator()(const CellKey& key) const {
+                    auto result = static_cast<size_t>(key[0]);
+                    result = result * 31u + static_cast<size_t>(key[1]);
+                    result = result * 31u + static_cast<size_t>(key[2]);
+                    return result;
+                }
+            };
+
+            /**
+             * A cell of the spatial index contains the entries of all handles whose center lies within the cell. Its
+             * bounds contain the bounds of these handles, so a handle can stick out of its cell.
+             */
+            struct Cell {
+                vm::bbox3 bounds;
+                std::vector<HandleEntry*> entries;
+            };
+
+            /**
+             * Spatial index of the entries of m_handles. The entries of a std::map are not moved when other entries
+             * are added or removed, so the cells can point to them.
+             */
+            std::unordered_map<CellKey, Cell, CellKeyHash> m_cells;
         public:
             VertexHandleManagerBaseT() :
             m_selectedHandleCount(0) {}
 
             virtual ~VertexHandleManagerBaseT() {}
+
+            deleteCopyAndMove(VertexHandleManagerBaseT)
         public:
             /**
              * Returns the hit type value of the picking hits reported by this manager.
@@ -302,7 +383,12 @@ namespace TrenchBroom {
              * @param handle the handle to add
              */
             void add(const Handle& handle) {
-                m_handles[handle].inc(); // unknown value gets value constructed, which for HandleInfo means its default constructor is called
+                const auto [it, inserted] = m_handles.try_emplace(handle);
+                it->second.inc();
+
+                if (inserted) {
+                    addToIndex(*it);
+                }
             }
 
             /**
@@ -319,6 +405,7 @@ namespace TrenchBroom {
 
                     if (info.count == 0) {
                         deselect(info);
+                        removeFromIndex(*it);
                         m_handles.erase(it);
                     }
                     return true;
@@ -332,6 +419,7 @@ namespace TrenchBroom {
              */
             void clear() {
                 m_handles.clear();
+                m_cells.clear();
                 m_selectedHandleCount = 0;
             }
 
@@ -422,13 +510,62 @@ namespace TrenchBroom {
             template <typename F>
             void forEachCloseHandle(const H& handle, F fun) {
                 static const auto epsilon = 0.001 * 0.001;
-                for (auto& entry : m_handles) {
-                    if (compare(handle, entry.first, epsilon) == 0) {
-                        fun(entry.second);
+
+                // the centers of close handles are close, too, but they may be in a neighbouring cell
+                const auto center = handleCenter(handle);
+                const auto min = cellKey(center - vm::vec3::fill(0.001));
+                const auto max = cellKey(center + vm::vec3::fill(0.001));
+
+                for (auto x = min[0]; x <= max[0]; ++x) {
+                    for (auto y = min[1]; y <= max[1]; ++y) {
+                        for (auto z = min[2]; z <= max[2]; ++z) {
+                            const auto it = m_cells.find(CellKey{x, y, z});
+                            if (it == std::end(m_cells)) {
+                                continue;
+                            }
+
+                            for (auto* entry : it->second.entries) {
+                                if (compare(handle, entry->first, epsilon) == 0) {
+                                    fun(entry->second);
+                                }
+                            }
+                        }
                     }
                 }
             }
 
+            static CellKey cellKey(const vm::vec3& position) {
+                return CellKey{
+                    static_cast<long>(std::floor(position.x() / CellSize)),
+                    static_cast<long>(std::floor(position.y() / CellSize)),
+                    static_cast<long>(std::floor(position.z() / CellSize))
+                };
+            }
+
+            void addToIndex(HandleEntry& entry) {
+                auto& cell = m_cells[cellKey(handleCenter(entry.first))];
+                const auto bounds = handleBounds(entry.first);
+                cell.bounds = cell.entries.empty() ? bounds : vm::merge(cell.bounds, bounds);
+                cell.entries.push_back(&entry);
+            }
+
+            void removeFromIndex(HandleEntry& entry) {
+                const auto cellIt = m_cells.find(cellKey(handleCenter(entry.first)));
+                assert(cellIt != std::end(m_cells));
+
+                // the cell bounds are not shrunk, they only need to contain the remaining handles
+                auto& entries = cellIt->second.entries;
+                const auto entryIt = std::find(std::begin(entries), std::end(entries), &entry);
+                assert(entryIt != std::end(entries));
+
+                *entryIt = entries.back();
+                entries.pop_back();
+
+                if (entries.empty()) {
+                    m_cells.erase(cellIt);
+                }
+            }
+
             void select(HandleInfo& info) {
                 if (info.select()) {
                     assert(selectedHandleCount() < totalHandleCount());
@@ -452,6 +589,39 @@ namespace TrenchBroom {
                     --m_selectedHandleCount;
                 }
             }
+        protected:
+            /**
+             * Calls the given function for every handle that might be hit by the given pick ray. A handle is hit if
+             * the pick ray intersects a sphere around a point within the handle's bounds, and the radius of that sphere
+             * depends on the distance of the point to the camera (see Camera::pickPointHandle). Therefore, the handles
+             * of a cell are only considered if the pick ray hits the cell bounds expanded by the largest pick radius
+             * at any corner of the cell bounds.
+             *
+             * @tparam F the type of the function to call, must accept a handle
+             * @param pickRay the pick ray
+             * @param camera the camera
+             * @param handleRadius the handle radius
+             * @param fun the function to call
+             */
+            template <typename F>
+            void forEachHandleCloseToRay(const vm::ray3& pickRay, const Renderer::Camera& camera, const FloatType handleRadius, F fun) const {
+                for (const auto& cellEntry : m_cells) {
+                    const auto& cell = cellEntry.second;
+
+                    auto maxScalingFactor = 0.0f;
+                    for (const auto& corner : cell.bounds.vertices()) {
+                        maxScalingFactor = vm::max(maxScalingFactor, vm::abs(camera.perspectiveScalingFactor(vm::vec3f(corner))));
+                    }
+
+                    const auto maxPickRadius = static_cast<FloatType>(2.0) * handleRadius * static_cast<FloatType>(maxScalingFactor);
+                    const auto pickBounds = vm::bbox3(cell.bounds.min - vm::vec3::fill(maxPickRadius), cell.bounds.max + vm::vec3::fill(maxPickRadius));
+                    if (pickBounds.contains(pickRay.origin) || !vm::is_nan(vm::intersect_ray_bbox(pickRay, pickBounds))) {
+                        for (const auto* entry : cell.entries) {
+                            fun(entry->first);
+                        }
+                    }
+                }
+            }
         public:
             /**
              * Applies the given picking test to all handles in this manager and adds all hits to the given picking
@@ -520,8 +690,10 @@ namespace TrenchBroom {
              */
             template <typename I, typename O>
             void findIncidentBrushes(const Handle& handle, I begin, I end, O out) const {
+                const auto bounds = handleBounds(handle);
                 for (auto cur = begin; cur != end; ++cur) {
-                    if (isIncident(handle, *cur)) {
+                    // the bounds check is much cheaper than searching the brush for the handle
+                    if ((*cur)->logicalBounds().contains(bounds) && isIncident(handle, *cur)) {
                         out++ = *cur;
                     }
                 }
@@ -124,6 +124,9 @@ namespace TrenchBroom {
             m_fovSlider = new SliderWithLabel(50, 150);
             m_fovSlider->setMaximumWidth(400);
             m_fovSlider->setToolTip("Sets the field of vision in the 3D editing view.");
+            m_portalFileDistanceSlider = new SliderWithLabel(0, 16384);
+            m_portalFileDistanceSlider->setMaximumWidth(400);
+            m_portalFileDistanceSlider->setToolTip("Sets the distance from the camera up to which portals are shown in the 3D editing view. Set to 0 to show all portals.");
 
             m_showAxes = new QCheckBox();
             m_showAxes->setToolTip("Toggle showing the coordinate system axes in the 3D editing view.");
@@ -167,6 +170,7 @@ namespace TrenchBroom {
             layout->addRow("Brightness", m_brightnessSlider);
             layout->addRow("Grid", m_gridAlphaSlider);
             layout->addRow("FOV", m_fovSlider);
+            layout->addRow("Portal distance", m_portalFileDistanceSlider);
             layout->addRow("Show axes", m_showAxes);
             layout->addRow("Texture mode", m_textureModeCombo);
             layout->addRow("Enable multisampling", m_enableMsaa);
@@ -188,6 +192,7 @@ namespace TrenchBroom {
             connect(m_brightnessSlider, &SliderWithLabel::valueChanged, this, &ViewPreferencePane::brightnessChanged);
             connect(m_gridAlphaSlider, &SliderWithLabel::valueChanged, this, &ViewPreferencePane::gridAlphaChanged);
             connect(m_fovSlider, &SliderWithLabel::valueChanged, this, &ViewPreferencePane::fovChanged);
+            connect(m_portalFileDistanceSlider, &SliderWithLabel::valueChanged, this, &ViewPreferencePane::portalFileDistanceChanged);
             connect(m_showAxes, &QCheckBox::stateChanged, this, &ViewPreferencePane::showAxesChanged);
             connect(m_enableMsaa, &QCheckBox::stateChanged, this, &ViewPreferencePane::enableMsaaChanged);
             connect(m_themeCombo, QOverload<int>::of(&QComboBox::activated), this, &ViewPreferencePane::themeChanged);
@@ -206,6 +211,7 @@ namespace TrenchBroom {
             prefs.resetToDefault(Preferences::Brightness);
             prefs.resetToDefault(Preferences::GridAlpha);
             prefs.resetToDefault(Preferences::CameraFov);
+            prefs.resetToDefault(Preferences::PortalFileRenderDistance);
             prefs.resetToDefault(Preferences::ShowAxes);
             prefs.resetToDefault(Preferences::EnableMSAA);
             prefs.resetToDefault(Preferences::TextureMinFilter);
@@ -220,6 +226,7 @@ namespace TrenchBroom {
             m_brightnessSlider->setValue(brightnessToUI(pref(Preferences::Brightness)));
             m_gridAlphaSlider->setRatio(pref(Preferences::GridAlpha));
             m_fovSlider->setValue(int(pref(Preferences::CameraFov)));
+            m_portalFileDistanceSlider->setValue(int(pref(Preferences::PortalFileRenderDistance)));
 
             const auto textureModeIndex = findTextureMode(pref(Preferences::TextureMinFilter), pref(Preferences::TextureMagFilter));
             m_textureModeCombo->setCurrentIndex(int(textureModeIndex));
@@ -294,6 +301,11 @@ namespace TrenchBroom {
             prefs.set(Preferences::CameraFov, float(value));
         }
 
+        void ViewPreferencePane::portalFileDistanceChanged(const int value) {
+            auto& prefs = PreferenceManager::instance();
+            prefs.set(Preferences::PortalFileRenderDistance, float(value));
+        }
+
         void ViewPreferencePane::showAxesChanged(const int state) {
             const auto value = state == Qt::Checked;
             auto& prefs = PreferenceManager::instance();
@@ -35,6 +35,7 @@ namespace TrenchBroom {
             SliderWithLabel* m_brightnessSlider;
             SliderWithLabel* m_gridAlphaSlider;
             SliderWithLabel* m_fovSlider;
+            SliderWithLabel* m_portalFileDistanceSlider;
             QCheckBox* m_showAxes;
             QComboBox* m_textureModeCombo;
             QCheckBox* m_enableMsaa;
@@ -61,6 +62,7 @@ namespace TrenchBroom {
             void brightnessChanged(int value);
             void gridAlphaChanged(int value);
             void fovChanged(int value);
+            void portalFileDistanceChanged(int value);
             void showAxesChanged(int state);
             void enableMsaaChanged(int state);
             void textureModeChanged(int index);
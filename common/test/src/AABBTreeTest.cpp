@@ -24,6 +24,7 @@
 
 #include <set>
 #include <sstream>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -49,6 +50,15 @@ namespace TrenchBroom {
         CHECK(actual == expected);
     }
 
+    static void assertIntersectors(const AABB& tree, const BOX& box, std::initializer_list<AABB::DataType> items) {
+        const std::set<AABB::DataType> expected(items);
+        std::set<AABB::DataType> actual;
+
+        tree.findIntersectors(box, std::inserter(actual, std::end(actual)));
+
+        CHECK(actual == expected);
+    }
+
     static void assertTreeContains(const AABB& tree, const BOX& box, AABB::DataType data) {
         CHECK(tree.contains(data));
 
@@ -485,6 +495,88 @@ L [ ( -1 -1 -1 ) ( 1 1 1 ) ]: 1
         return BOX(VEC(static_cast<double>(min), -1.0, -1.0), VEC(static_cast<double>(max), 1.0, 1.0));
     }
 
+    TEST_CASE("AABBTreeTest.updateNode", "[AABBTreeTest]") {
+        AABB tree;
+        tree.insert(makeBounds(0, 1), 1u);
+        tree.insert(makeBounds(2, 3), 2u);
+        tree.insert(makeBounds(4, 5), 3u);
+
+        // the parent of node 1 is the root, so the node is refit
+        tree.update(makeBounds(0.5, 1.5), 1u);
+        assertTree(R"(
+O [ ( 0.5 -1 -1 ) ( 5 1 1 ) ]
+  L [ ( 0.5 -1 -1 ) ( 1.5 1 1 ) ]: 1
+  O [ ( 2 -1 -1 ) ( 5 1 1 ) ]
+    L [ ( 2 -1 -1 ) ( 3 1 1 ) ]: 2
+    L [ ( 4 -1 -1 ) ( 5 1 1 ) ]: 3
+)" , tree);
+
+        // the new bounds of node 2 are not contained in the root, so the node is reinserted
+        tree.update(makeBounds(-3, -2), 2u);
+        assertTree(R"(
+O [ ( -3 -1 -1 ) ( 5 1 1 ) ]
+  O [ ( -3 -1 -1 ) ( 1.5 1 1 ) ]
+    L [ ( 0.5 -1 -1 ) ( 1.5 1 1 ) ]: 1
+    L [ ( -3 -1 -1 ) ( -2 1 1 ) ]: 2
+  L [ ( 4 -1 -1 ) ( 5 1 1 ) ]: 3
+)" , tree);
+
+        assertTreeContains(tree, makeBounds(0.5, 1.5), 1u);
+        assertTreeContains(tree, makeBounds(-3, -2), 2u);
+        assertTreeContains(tree, makeBounds(4, 5), 3u);
+
+        CHECK_THROWS_AS(tree.update(makeBounds(0, 1), 4u), NodeTreeException);
+    }
+
+    TEST_CASE("AABBTreeTest.updateAll", "[AABBTreeTest]") {
+        AABB tree;
+        tree.insert(makeBounds(0, 1), 1u);
+        tree.insert(makeBounds(2, 3), 2u);
+        tree.insert(makeBounds(4, 5), 3u);
+
+        auto bounds = std::vector<BOX>{ makeBounds(0, 0), makeBounds(0, 1), makeBounds(2.5, 3.5), makeBounds(4.5, 5.5) };
+        const auto getBounds = [&](const size_t i) { return bounds[i]; };
+
+        tree.updateAll(std::vector<size_t>{ 2u, 3u }, getBounds);
+        assertTree(R"(
+O [ ( 0 -1 -1 ) ( 5.5 1 1 ) ]
+  L [ ( 0 -1 -1 ) ( 1 1 1 ) ]: 1
+  O [ ( 2.5 -1 -1 ) ( 5.5 1 1 ) ]
+    L [ ( 2.5 -1 -1 ) ( 3.5 1 1 ) ]: 2
+    L [ ( 4.5 -1 -1 ) ( 5.5 1 1 ) ]: 3
+)" , tree);
+
+        // the root has degraded and is rebuilt
+        bounds[1] = makeBounds(100, 101);
+        tree.updateAll(std::vector<size_t>{ 1u }, getBounds);
+        assertTree(R"(
+O [ ( 2.5 -1 -1 ) ( 101 1 1 ) ]
+  L [ ( 100 -1 -1 ) ( 101 1 1 ) ]: 1
+  O [ ( 2.5 -1 -1 ) ( 5.5 1 1 ) ]
+    L [ ( 2.5 -1 -1 ) ( 3.5 1 1 ) ]: 2
+    L [ ( 4.5 -1 -1 ) ( 5.5 1 1 ) ]: 3
+)" , tree);
+
+        for (size_t i = 1u; i < bounds.size(); ++i) {
+            assertTreeContains(tree, bounds[i], i);
+        }
+
+        CHECK_THROWS_AS(tree.updateAll(std::vector<size_t>{ 4u }, getBounds), NodeTreeException);
+    }
+
+    TEST_CASE("AABBTreeTest.sahCost", "[AABBTreeTest]") {
+        AABB tree;
+        CHECK(tree.sahCost() == 0.0);
+
+        tree.insert(makeBounds(0, 1), 1u);
+        CHECK(tree.sahCost() == 1.0);
+
+        // the half surface area of each leaf is 8, and that of the root is 16
+        tree.insert(makeBounds(2, 3), 2u);
+        CHECK(tree.sahCost() == 2.0);
+        CHECK(tree.height() == 2u);
+    }
+
     TEST_CASE("AABBTreeTest.findIntersectorsOfEmptyTree", "[AABBTreeTest]") {
         AABB tree;
         assertIntersectors(tree, RAY(VEC::zero(), VEC::pos_x()), {});
@@ -528,4 +620,19 @@ L [ ( -1 -1 -1 ) ( 1 1 1 ) ]: 1
 
         assertIntersectors(tree, RAY(VEC(0.0,  0.0,  0.0), VEC::pos_x()), { 2u });
     }
+
+    TEST_CASE("AABBTreeTest.findBoxIntersectors", "[AABBTreeTest]") {
+        AABB tree;
+        assertIntersectors(tree, BOX(VEC(-1.0, -1.0, -1.0), VEC(+1.0, +1.0, +1.0)), {});
+
+        tree.insert(BOX(VEC(-4.0, -1.0, -1.0), VEC(-2.0, +1.0, +1.0)), 1u);
+        tree.insert(BOX(VEC(+2.0, -1.0, -1.0), VEC(+4.0, +1.0, +1.0)), 2u);
+        tree.insert(BOX(VEC(+2.0, +2.0, -1.0), VEC(+4.0, +4.0, +1.0)), 3u);
+
+        assertIntersectors(tree, BOX(VEC(-1.0, -1.0, -1.0), VEC(+1.0, +1.0, +1.0)), {});
+        assertIntersectors(tree, BOX(VEC(-3.0, -1.0, -1.0), VEC(-2.5, +1.0, +1.0)), { 1u });
+        assertIntersectors(tree, BOX(VEC(-5.0, -5.0, -5.0), VEC(-4.0, -1.0, -1.0)), { 1u });
+        assertIntersectors(tree, BOX(VEC(+3.0, 0.0, 0.0), VEC(+5.0, +3.0, +3.0)), { 2u, 3u });
+        assertIntersectors(tree, BOX(VEC(-5.0, -5.0, -5.0), VEC(+5.0, +5.0, +5.0)), { 1u, 2u, 3u });
+    }
 }
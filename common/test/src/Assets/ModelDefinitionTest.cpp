@@ -0,0 +1,63 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Assets/ModelDefinition.h"
+#include "EL/Value.h"
+#include "EL/VariableStore.h"
+#include "IO/ELParser.h"
+#include "IO/Path.h"
+
+#include <string>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace Assets {
+        static ModelSpecification evaluate(const ModelDefinition& definition, const std::string& spawnflags, const std::string& model) {
+            auto variableStore = EL::VariableTable();
+            variableStore.declare("spawnflags", EL::Value(spawnflags));
+            variableStore.declare("model", EL::Value(model));
+            return definition.modelSpecification(variableStore);
+        }
+
+        TEST_CASE("ModelDefinitionTest.modelSpecification", "[ModelDefinitionTest]") {
+            const auto definition = ModelDefinition(IO::ELParser::parseStrict(R"({{ spawnflags == "1" -> { "path": "a.mdl", "skin": 1 }, spawnflags == "2" -> model, "default.mdl" }})"));
+
+            CHECK(evaluate(definition, "0", "x.mdl") == ModelSpecification(IO::Path("default.mdl")));
+            CHECK(evaluate(definition, "1", "x.mdl") == ModelSpecification(IO::Path("a.mdl"), 1, 0));
+            CHECK(evaluate(definition, "2", "x.mdl") == ModelSpecification(IO::Path("x.mdl")));
+            CHECK(evaluate(definition, "2", "y.mdl") == ModelSpecification(IO::Path("y.mdl")));
+
+            // repeated evaluations yield the same results
+            CHECK(evaluate(definition, "2", "x.mdl") == ModelSpecification(IO::Path("x.mdl")));
+            CHECK(evaluate(definition, "1", "y.mdl") == ModelSpecification(IO::Path("a.mdl"), 1, 0));
+            CHECK(evaluate(definition, "0", "y.mdl") == ModelSpecification(IO::Path("default.mdl")));
+        }
+
+        TEST_CASE("ModelDefinitionTest.append", "[ModelDefinitionTest]") {
+            auto definition = ModelDefinition(IO::ELParser::parseStrict(R"(spawnflags == "1" -> "a.mdl")"));
+            CHECK(evaluate(definition, "0", "") == ModelSpecification());
+            CHECK(evaluate(definition, "1", "") == ModelSpecification(IO::Path("a.mdl")));
+
+            definition.append(ModelDefinition(IO::ELParser::parseStrict("model")));
+            CHECK(evaluate(definition, "0", "b.mdl") == ModelSpecification(IO::Path("b.mdl")));
+            CHECK(evaluate(definition, "1", "b.mdl") == ModelSpecification(IO::Path("a.mdl")));
+        }
+    }
+}
@@ -0,0 +1,70 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Assets/Texture.h"
+#include "Assets/TextureNameIndex.h"
+
+#include <kdl/vector_utils.h>
+
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace Assets {
+        static std::vector<std::string> findTextureNames(const TextureNameIndex& index, const std::string& pattern) {
+            return kdl::vec_transform(index.findTextures(pattern), [](const auto* texture) { return texture->name(); });
+        }
+
+        TEST_CASE("TextureNameIndexTest.findTextures", "[TextureNameIndexTest]") {
+            auto textures = std::vector<Texture>();
+            textures.emplace_back("base/brick_01", 64, 64);
+            textures.emplace_back("base/BRICK_02", 64, 64);
+            textures.emplace_back("base/metal", 64, 64);
+            textures.emplace_back("sky/bricksky", 64, 64);
+            textures.emplace_back("trim/metal_brick", 64, 64);
+            textures.emplace_back("aaaa", 64, 64);
+
+            const auto index = TextureNameIndex(kdl::vec_transform(textures, [](const auto& texture) { return &texture; }));
+            CHECK(index.textures().size() == textures.size());
+
+            CHECK(findTextureNames(index, "") == std::vector<std::string>{ "base/brick_01", "base/BRICK_02", "base/metal", "sky/bricksky", "trim/metal_brick", "aaaa" });
+            CHECK(findTextureNames(index, "x").empty());
+            CHECK(findTextureNames(index, "xyz").empty());
+
+            // patterns shorter than a trigram
+            CHECK(findTextureNames(index, "m") == std::vector<std::string>{ "base/metal", "trim/metal_brick" });
+            CHECK(findTextureNames(index, "Sk") == std::vector<std::string>{ "sky/bricksky" });
+
+            // the order of the indexed textures is kept
+            CHECK(findTextureNames(index, "brick") == std::vector<std::string>{ "base/brick_01", "base/BRICK_02", "sky/bricksky", "trim/metal_brick" });
+            CHECK(findTextureNames(index, "BRICK_") == std::vector<std::string>{ "base/brick_01", "base/BRICK_02" });
+            CHECK(findTextureNames(index, "metal") == std::vector<std::string>{ "base/metal", "trim/metal_brick" });
+            CHECK(findTextureNames(index, "base/brick_01") == std::vector<std::string>{ "base/brick_01" });
+
+            // all trigrams of the pattern occur, but not the pattern itself
+            CHECK(findTextureNames(index, "brickbrick").empty());
+
+            // repeated trigrams
+            CHECK(findTextureNames(index, "aaa") == std::vector<std::string>{ "aaaa" });
+            CHECK(findTextureNames(index, "aaaaa").empty());
+        }
+    }
+}
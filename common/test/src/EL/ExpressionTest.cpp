@@ -27,6 +27,7 @@
 #include "IO/ELParser.h"
 
 #include <string>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -341,5 +342,36 @@ namespace TrenchBroom {
             evaluateAndAssert("true && true -> false", false);
             evaluateAndAssert("2 + 3 < 2 + 4 -> 6 % 5", 1);
         }
+
+        TEST_CASE("ExpressionTest.testOptimizeCaseExpression", "[ExpressionTest]") {
+            assertOptimizable("false -> x");
+            assertNotOptimizable("true -> x");
+            assertNotOptimizable("x -> 1");
+
+            auto expression = IO::ELParser::parseStrict("false -> x");
+            expression.optimize();
+            CHECK(expression.evaluate(EvaluationContext()) == Value::Undefined);
+        }
+
+        TEST_CASE("ExpressionTest.testOptimizeSwitchExpression", "[ExpressionTest]") {
+            assertOptimizable("{{ false -> x, 1 }}");
+            assertOptimizable("{{ false -> x, false -> y }}");
+            assertNotOptimizable("{{ x == 1 -> 1, 2 }}");
+
+            auto expression = IO::ELParser::parseStrict("{{ false -> a, x == 1 -> 1, 2, y }}");
+            expression.optimize();
+            CHECK(expression.asString() == "{{ x == 1 -> 1, 2 }}");
+            CHECK(expression.variables() == std::vector<std::string>{ "x" });
+
+            evaluateAndAssert("{{ false -> a, x == 1 -> 1, 2, y }}", 1, "x", 1);
+            evaluateAndAssert("{{ false -> a, x == 1 -> 1, 2, y }}", 2, "x", 2);
+        }
+
+        TEST_CASE("ExpressionTest.testVariables", "[ExpressionTest]") {
+            CHECK(IO::ELParser::parseStrict("1 + 2").variables().empty());
+            CHECK(IO::ELParser::parseStrict("x + y * x").variables() == std::vector<std::string>{ "x", "y" });
+            CHECK(IO::ELParser::parseStrict("{{ spawnflags & 1 -> { \"path\": model }, \"default.mdl\" }}").variables() == std::vector<std::string>{ "model", "spawnflags" });
+            CHECK(IO::ELParser::parseStrict("[ a, b ][ ..1 ]").variables() == std::vector<std::string>{ "a", "b" });
+        }
     }
 }
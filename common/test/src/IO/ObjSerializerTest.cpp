@@ -0,0 +1,127 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IO/NodeWriter.h"
+#include "IO/ObjSerializer.h"
+#include "IO/Path.h"
+#include "IO/TestEnvironment.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/Entity.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/WorldNode.h"
+
+#include <kdl/result.h>
+#include <kdl/string_compare.h>
+#include <kdl/string_utils.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
+#include <vecmath/vec.h>
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        static std::vector<std::string> readLines(const std::string& path) {
+            std::ifstream stream(path);
+            REQUIRE(stream.good());
+
+            std::vector<std::string> result;
+            std::string line;
+            while (std::getline(stream, line)) {
+                result.push_back(line);
+            }
+            return result;
+        }
+
+        static std::vector<std::string> linesWithPrefix(const std::vector<std::string>& lines, const std::string& prefix) {
+            std::vector<std::string> result;
+            for (const auto& line : lines) {
+                if (kdl::cs::str_is_prefix(line, prefix)) {
+                    result.push_back(line);
+                }
+            }
+            return result;
+        }
+
+        TEST_CASE("ObjSerializerTest.writeBrushes", "[ObjSerializerTest]") {
+            const vm::bbox3 worldBounds(8192.0);
+
+            Model::WorldNode map(Model::Entity(), Model::MapFormat::Standard);
+            Model::BrushBuilder builder(map.mapFormat(), worldBounds);
+
+            Model::Brush brush1 = builder.createCube(64.0, "tex1").value();
+            Model::Brush brush2 = builder.createCube(64.0, "tex2").value();
+            REQUIRE(brush2.transform(worldBounds, vm::translation_matrix(vm::vec3(64.0, 0.0, 0.0)), false).is_success());
+
+            map.defaultLayer()->addChild(new Model::BrushNode(std::move(brush1)));
+            map.defaultLayer()->addChild(new Model::BrushNode(std::move(brush2)));
+
+            TestEnvironment env("ObjSerializerTest");
+            const auto objPath = env.dir() + Path("ObjSerializerTest.obj");
+            {
+                NodeWriter writer(map, std::make_unique<ObjFileSerializer>(objPath));
+                writer.writeMap();
+            }
+
+            const auto lines = readLines(objPath.asString());
+            CHECK(lines.front() == "mtllib ObjSerializerTest.mtl");
+
+            // vertex positions are not shared between brushes, but normals are
+            CHECK(linesWithPrefix(lines, "v ").size() == 16u);
+            CHECK(linesWithPrefix(lines, "vn ").size() == 6u);
+            CHECK(linesWithPrefix(lines, "o ") == std::vector<std::string>{ "o entity0_brush0", "o entity0_brush1" });
+            CHECK(linesWithPrefix(lines, "usemtl ").size() == 12u);
+
+            const auto faces = linesWithPrefix(lines, "f ");
+            REQUIRE(faces.size() == 12u);
+            for (size_t i = 0u; i < faces.size(); ++i) {
+                const auto vertices = kdl::str_split(faces[i].substr(2u), " ");
+                CHECK(vertices.size() == 4u);
+
+                for (const auto& vertex : vertices) {
+                    const auto indices = kdl::str_split(vertex, "/");
+                    REQUIRE(indices.size() == 3u);
+
+                    // the faces of each brush only refer to the vertex positions of that brush
+                    const auto vertexIndex = std::stoul(indices[0]);
+                    CHECK(vertexIndex > (i / 6u) * 8u);
+                    CHECK(vertexIndex <= (i / 6u + 1u) * 8u);
+                    CHECK(std::stoul(indices[2]) <= 6u);
+                }
+            }
+
+            const auto mtlLines = readLines(objPath.replaceExtension("mtl").asString());
+            CHECK(linesWithPrefix(mtlLines, "newmtl ") == std::vector<std::string>{ "newmtl tex1", "newmtl tex2" });
+
+            // the temporary section files are removed
+            CHECK_FALSE(env.fileExists(Path("ObjSerializerTest.obj.texcoords.tmp")));
+            CHECK_FALSE(env.fileExists(Path("ObjSerializerTest.obj.normals.tmp")));
+            CHECK_FALSE(env.fileExists(Path("ObjSerializerTest.obj.objects.tmp")));
+        }
+    }
+}
@@ -58,7 +58,7 @@ namespace TrenchBroom {
             const vm::vec3 p2(0.0, -1.0, 4.0);
 
             const BrushFaceAttributes attribs("");
-            BrushFace face = BrushFace::create(p0, p1, p2, attribs, std::make_unique<ParaxialTexCoordSystem>(p0, p1, p2, attribs)).value();
+            BrushFace face = BrushFace::create(p0, p1, p2, attribs, ParaxialTexCoordSystem(p0, p1, p2, attribs)).value();
             CHECK(face.points()[0] == vm::approx(p0));
             CHECK(face.points()[1] == vm::approx(p1));
             CHECK(face.points()[2] == vm::approx(p2));
@@ -72,7 +72,7 @@ namespace TrenchBroom {
             const vm::vec3 p2(2.0, 0.0, 4.0);
 
             const BrushFaceAttributes attribs("");
-            CHECK_FALSE(BrushFace::create(p0, p1, p2, attribs, std::make_unique<ParaxialTexCoordSystem>(p0, p1, p2, attribs)).is_success());
+            CHECK_FALSE(BrushFace::create(p0, p1, p2, attribs, ParaxialTexCoordSystem(p0, p1, p2, attribs)).is_success());
         }
 
         TEST_CASE("BrushFaceTest.textureUsageCount", "[BrushFaceTest]") {
@@ -88,7 +88,7 @@ namespace TrenchBroom {
             BrushFaceAttributes attribs("");
             {
                 // test constructor
-                BrushFace face = BrushFace::create(p0, p1, p2, attribs, std::make_unique<ParaxialTexCoordSystem>(p0, p1, p2, attribs)).value();
+                BrushFace face = BrushFace::create(p0, p1, p2, attribs, ParaxialTexCoordSystem(p0, p1, p2, attribs)).value();
                 CHECK(texture.usageCount() == 0u);
 
                 // test setTexture
@@ -704,6 +704,48 @@ namespace TrenchBroom {
             doWithTextureLockTestTransforms(true, testTransform);
         }
 
+        TEST_CASE("BrushFaceTest.textureProjection", "[BrushFaceTest]") {
+            const vm::bbox3 worldBounds(4096.0);
+            const auto mapFormat = GENERATE(MapFormat::Standard, MapFormat::Valve);
+
+            BrushBuilder builder(mapFormat, worldBounds);
+            Assets::Texture texture("testTexture", 64, 32);
+
+            Brush brush = builder.createCube(128.0, "").value();
+            for (size_t i = 0; i < brush.faceCount(); ++i) {
+                BrushFace& face = brush.face(i);
+                face.setTexture(&texture);
+
+                auto attributes = face.attributes();
+                attributes.setOffset(vm::vec2f(3.0f, -5.0f));
+                attributes.setScale(vm::vec2f(0.5f, -2.0f));
+                attributes.setRotation(30.0f);
+                face.setAttributes(attributes);
+            }
+
+            for (const BrushFace& face : brush.faces()) {
+                const auto projection = face.textureProjection();
+                for (const auto* vertex : face.vertices()) {
+                    CHECK(projection(vertex->position()) == face.textureCoords(vertex->position()));
+                }
+            }
+        }
+
+        TEST_CASE("BrushFaceTest.copyTexCoordSystem", "[BrushFaceTest]") {
+            const vm::bbox3 worldBounds(4096.0);
+            BrushBuilder builder(MapFormat::Valve, worldBounds);
+
+            const Brush brush = builder.createCube(128.0, "").value();
+            const BrushFace& original = brush.face(0);
+
+            BrushFace copy = original;
+            CHECK(copy.texCoordSystem() == original.texCoordSystem());
+            CHECK(&copy.texCoordSystem() != &original.texCoordSystem());
+
+            copy.shearTexture(vm::vec2f(0.5f, 0.0f));
+            CHECK(copy.texCoordSystem() != original.texCoordSystem());
+        }
+
         TEST_CASE("BrushFaceTest.nodeReaderConversion", "[BrushFaceTest]") {
             const std::string data(R"(
 // entity 0
@@ -466,6 +466,92 @@ namespace TrenchBroom {
             CHECK(!canMoveBoundary(brush1, worldBounds, *rightFaceIndex, vm::vec3(8000, 0, 0)));
         }
 
+        TEST_CASE("BrushTest.transform", "[BrushTest]") {
+            const vm::bbox3 worldBounds(8192.0);
+            const BrushBuilder builder(MapFormat::Standard, worldBounds);
+
+            const Brush brush = builder.createCuboid(vm::bbox3(vm::vec3(-64, -32, -16), vm::vec3(64, 32, 16)), "texture").value();
+
+            const auto transformations = std::vector<vm::mat4x4>{
+                vm::translation_matrix(vm::vec3(16, 32, -48)),
+                vm::rotation_matrix(0.0, 0.0, vm::to_radians(90.0)),
+                vm::rotation_matrix(0.0, vm::to_radians(30.0), 0.0),
+                vm::scaling_matrix(vm::vec3(2, 0.5, 1)),
+                vm::mirror_matrix<double>(vm::axis::x),
+            };
+
+            for (const auto& transformation : transformations) {
+                Brush transformed = brush;
+                REQUIRE(transformed.transform(worldBounds, transformation, false).is_success());
+
+                // the geometry must match the geometry rebuilt from the transformed faces
+                const Brush rebuilt = Brush::create(worldBounds, transformed.faces()).value();
+                CHECK(transformed.faceCount() == rebuilt.faceCount());
+                CHECK(transformed.vertexCount() == rebuilt.vertexCount());
+                CHECK(vm::is_equal(transformed.bounds(), rebuilt.bounds(), vm::C::almost_zero()));
+                for (const auto& vertexPosition : rebuilt.vertexPositions()) {
+                    CHECK(transformed.hasVertex(vertexPosition, vm::C::almost_zero()));
+                }
+
+                for (size_t i = 0u; i < transformed.faceCount(); ++i) {
+                    CHECK(transformed.face(i).geometry()->payload() == i);
+                }
+
+                // the face order must not depend on whether the geometry was transformed or rebuilt
+                for (size_t i = 0u; i < transformed.faceCount(); ++i) {
+                    CHECK(vm::is_equal(transformed.face(i).boundary().normal, rebuilt.face(i).boundary().normal, vm::C::almost_zero()));
+                    CHECK(vm::is_equal(transformed.face(i).boundary().distance, rebuilt.face(i).boundary().distance, vm::C::almost_zero()));
+                }
+            }
+        }
+
+        TEST_CASE("BrushTest.transformPastWorldBounds", "[BrushTest]") {
+            const vm::bbox3 worldBounds(8192.0);
+            const BrushBuilder builder(MapFormat::Standard, worldBounds);
+
+            Brush brush = builder.createCube(64.0, "texture").value();
+            CHECK(brush.transform(worldBounds, vm::translation_matrix(vm::vec3(8192, 0, 0)), false).is_error());
+        }
+
+        TEST_CASE("BrushTest.copySharesGeometry", "[BrushTest]") {
+            const vm::bbox3 worldBounds(8192.0);
+            const BrushBuilder builder(MapFormat::Standard, worldBounds);
+
+            const Brush brush = builder.createCube(64.0, "texture").value();
+            CHECK(brush.geometryShareCount() == 1u);
+
+            Brush copy = brush;
+            CHECK(brush.geometryShareCount() == 2u);
+            REQUIRE(copy.faceCount() == brush.faceCount());
+            for (size_t i = 0u; i < brush.faceCount(); ++i) {
+                CHECK(copy.face(i).geometry() != nullptr);
+                CHECK(copy.face(i).geometry() == brush.face(i).geometry());
+                CHECK(copy.face(i).vertexPositions() == brush.face(i).vertexPositions());
+            }
+
+            // changing the face attributes does not change the geometry
+            auto attributes = copy.face(0u).attributes();
+            attributes.setTextureName("other");
+            copy.face(0u).setAttributes(attributes);
+            CHECK(brush.geometryShareCount() == 2u);
+            CHECK(brush.face(0u).attributes().textureName() == "texture");
+
+            // a failed transformation leaves the shared geometry intact
+            CHECK(copy.transform(worldBounds, vm::translation_matrix(vm::vec3(8192, 0, 0)), false).is_error());
+            CHECK(brush.bounds() == vm::bbox3(32.0));
+
+            copy = brush;
+            REQUIRE(copy.transform(worldBounds, vm::translation_matrix(vm::vec3(16, 0, 0)), false).is_success());
+            CHECK(brush.geometryShareCount() == 1u);
+            CHECK(copy.geometryShareCount() == 1u);
+            CHECK(brush.bounds() == vm::bbox3(32.0));
+            CHECK(copy.bounds() == vm::bbox3(vm::vec3(-16, -32, -32), vm::vec3(48, 32, 32)));
+            for (size_t i = 0u; i < brush.faceCount(); ++i) {
+                CHECK(brush.face(i).geometry()->payload() == i);
+                CHECK(copy.face(i).geometry() != brush.face(i).geometry());
+            }
+        }
+
         TEST_CASE("BrushTest.expand", "[BrushTest]") {
             const vm::bbox3 worldBounds(8192.0);
             const BrushBuilder builder(MapFormat::Standard, worldBounds);
@@ -26,9 +26,11 @@
 #include "Model/Entity.h"
 #include "Model/EntityNode.h"
 #include "Model/GroupNode.h"
+#include "Model/Layer.h"
 #include "Model/LayerNode.h"
 #include "Model/LockState.h"
 #include "Model/MapFormat.h"
+#include "Model/Tag.h"
 #include "Model/WorldNode.h"
 #include "Model/VisibilityState.h"
 
@@ -822,5 +824,61 @@ namespace TrenchBroom {
             context.popGroup();
             context.popGroup();
         }
+
+        TEST_CASE_METHOD(EditorContextTest, "EditorContextTest.cachedVisibility") {
+            GroupNode* outerGroup;
+            GroupNode* innerGroup;
+            BrushNode* brush;
+            std::tie(outerGroup, innerGroup, brush) = createdNestedGroupedBrush();
+
+            CHECK(context.visible(outerGroup));
+            CHECK(context.visible(innerGroup));
+
+            // hiding a brush must invalidate the cached visibility of the groups containing it
+            brush->setVisibilityState(VisibilityState::Visibility_Hidden);
+            CHECK_FALSE(context.visible(brush));
+            CHECK_FALSE(context.visible(innerGroup));
+            CHECK_FALSE(context.visible(outerGroup));
+
+            innerGroup->select();
+            CHECK(context.visible(innerGroup));
+            CHECK(context.visible(outerGroup));
+            innerGroup->deselect();
+            CHECK_FALSE(context.visible(outerGroup));
+
+            brush->setVisibilityState(VisibilityState::Visibility_Inherited);
+            CHECK(context.visible(outerGroup));
+
+            // hiding a layer must invalidate the cached visibility of its descendants
+            auto* layer = new LayerNode(Layer("layer"));
+            world->addChild(layer);
+            layer->setVisibilityState(VisibilityState::Visibility_Hidden);
+            CHECK(context.visible(brush));
+
+            innerGroup->removeChild(brush);
+            layer->addChild(brush);
+            CHECK_FALSE(context.visible(brush));
+            CHECK_FALSE(context.visible(outerGroup));
+
+            layer->setVisibilityState(VisibilityState::Visibility_Inherited);
+            CHECK(context.visible(brush));
+
+            // changing the editor context must invalidate all cached visibilities
+            const auto tag = Tag(0u, "tag", {});
+            brush->addTag(tag);
+            CHECK(context.visible(brush));
+
+            context.setHiddenTags(tag.type());
+            CHECK_FALSE(context.visible(brush));
+
+            context.setHiddenTags(0u);
+            CHECK(context.visible(brush));
+
+            setPref(Preferences::ShowBrushes, false);
+            CHECK_FALSE(context.visible(brush));
+
+            resetPref(Preferences::ShowBrushes);
+            CHECK(context.visible(brush));
+        }
     }
 }
@@ -230,5 +230,76 @@ namespace TrenchBroom {
             CHECK_THAT(index.allValuesForKeys(EntityNodeIndexQuery::exact("test")), 
                 Catch::UnorderedEquals(std::vector<std::string>{ "somevalue", "somevalue2" }));
         }
+
+        TEST_CASE("EntityNodeIndexTest.batch", "[EntityNodeIndexTest]") {
+            EntityNodeIndex index;
+
+            EntityNode* entity1 = new EntityNode({
+                {"test", "somevalue"}
+            });
+
+            EntityNode* entity2 = new EntityNode({
+                {"test", "somevalue"},
+                {"other", "someothervalue"}
+            });
+
+            index.beginBatch();
+            index.addEntityNode(entity1);
+            index.addEntityNode(entity2);
+
+            SECTION("Queries during a batch see pending changes") {
+                std::vector<EntityNodeBase*> nodes = findExactExact(index, "test", "somevalue");
+                CHECK(nodes.size() == 2u);
+                CHECK(kdl::vec_contains(nodes, entity1));
+                CHECK(kdl::vec_contains(nodes, entity2));
+
+                CHECK_THAT(index.allKeys(), Catch::UnorderedEquals(std::vector<std::string>{ "test", "other" }));
+
+                index.removeProperty(entity2, "other", "someothervalue");
+                CHECK(findExactExact(index, "other", "someothervalue").empty());
+                CHECK_THAT(index.allKeys(), Catch::UnorderedEquals(std::vector<std::string>{ "test" }));
+
+                index.endBatch();
+            }
+
+            SECTION("Changes that cancel each other out are dropped") {
+                index.removeProperty(entity2, "other", "someothervalue");
+                index.addProperty(entity2, "other", "someothervalue");
+                index.removeEntityNode(entity1);
+                index.endBatch();
+
+                const std::vector<EntityNodeBase*> nodes = findExactExact(index, "test", "somevalue");
+                CHECK(nodes.size() == 1u);
+                CHECK(kdl::vec_contains(nodes, entity2));
+
+                CHECK(findExactExact(index, "other", "someothervalue") == std::vector<EntityNodeBase*>{ entity2 });
+                CHECK_THAT(index.allKeys(), Catch::UnorderedEquals(std::vector<std::string>{ "test", "other" }));
+            }
+
+            SECTION("Nested batches apply their changes when the outermost batch is closed") {
+                {
+                    const auto batch = EntityNodeIndexBatch(index);
+                    index.removeEntityNode(entity2);
+                }
+                index.endBatch();
+
+                CHECK(findExactExact(index, "test", "somevalue") == std::vector<EntityNodeBase*>{ entity1 });
+                CHECK(findExactExact(index, "other", "someothervalue").empty());
+            }
+
+            SECTION("Queries with wildcards during a batch see pending changes for all matching values") {
+                const std::vector<EntityNodeBase*> nodes = findExactExact(index, "test", "some*");
+                CHECK(nodes.size() == 2u);
+                CHECK(kdl::vec_contains(nodes, entity1));
+                CHECK(kdl::vec_contains(nodes, entity2));
+
+                CHECK(findExactExact(index, "other", "someother?alue") == std::vector<EntityNodeBase*>{ entity2 });
+
+                index.endBatch();
+            }
+
+            delete entity1;
+            delete entity2;
+        }
     }
 }
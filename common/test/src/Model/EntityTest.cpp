@@ -168,6 +168,57 @@ namespace TrenchBroom {
             CHECK(*entity.property("key") == "value");
         }
 
+        TEST_CASE("EntityTest.wellKnownProperty") {
+            Entity entity;
+            entity.setProperties({
+                EntityProperty("key", "value"),
+                EntityProperty(PropertyKeys::Target, "some_target"),
+                EntityProperty(PropertyKeys::Targetname, "some_name"),
+            });
+
+            REQUIRE(entity.property(PropertyKeys::Targetname) != nullptr);
+            CHECK(*entity.property(PropertyKeys::Targetname) == "some_name");
+            CHECK(entity.property(PropertyKeys::Killtarget) == nullptr);
+
+            SECTION("Removing a property updates the positions of subsequent well known properties") {
+                entity.removeProperty("key");
+                REQUIRE(entity.property(PropertyKeys::Target) != nullptr);
+                CHECK(*entity.property(PropertyKeys::Target) == "some_target");
+                REQUIRE(entity.property(PropertyKeys::Targetname) != nullptr);
+                CHECK(*entity.property(PropertyKeys::Targetname) == "some_name");
+            }
+
+            SECTION("Renaming a property to a well known key makes it accessible") {
+                entity.renameProperty("key", PropertyKeys::Killtarget);
+                REQUIRE(entity.property(PropertyKeys::Killtarget) != nullptr);
+                CHECK(*entity.property(PropertyKeys::Killtarget) == "value");
+            }
+
+            SECTION("Adding a well known property makes it accessible") {
+                entity.addOrUpdateProperty(PropertyKeys::Killtarget, "other_target");
+                REQUIRE(entity.property(PropertyKeys::Killtarget) != nullptr);
+                CHECK(*entity.property(PropertyKeys::Killtarget) == "other_target");
+            }
+
+            SECTION("Looking up a well known key by value finds the same property") {
+                CHECK(entity.property(std::string("targetname")) == entity.property(PropertyKeys::Targetname));
+            }
+        }
+
+        TEST_CASE("EntityTest.wellKnownPropertyWithDuplicateKey") {
+            Entity entity;
+            entity.setProperties({
+                EntityProperty(PropertyKeys::Target, "first_target"),
+                EntityProperty("key", "value"),
+                EntityProperty(PropertyKeys::Target, "second_target"),
+            });
+
+            // the first occurrence of a duplicated key is found, whether the key is well known or not
+            REQUIRE(entity.property(PropertyKeys::Target) != nullptr);
+            CHECK(*entity.property(PropertyKeys::Target) == "first_target");
+            CHECK(entity.property(PropertyKeys::Target) == entity.property(std::string("target")));
+        }
+
         TEST_CASE("EntityTest.classname") {
             Entity entity;
             REQUIRE(!entity.hasProperty(PropertyKeys::Classname));
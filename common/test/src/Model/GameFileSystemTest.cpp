@@ -0,0 +1,110 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "Logger.h"
+#include "IO/File.h"
+#include "IO/Path.h"
+#include "IO/Reader.h"
+#include "IO/TestEnvironment.h"
+#include "Model/GameConfig.h"
+#include "Model/GameFileSystem.h"
+
+#include <miniz/miniz.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        static void createZipFile(const IO::Path& path, const std::vector<std::pair<std::string, std::string>>& entries) {
+            mz_zip_archive archive;
+            mz_zip_zero_struct(&archive);
+
+            REQUIRE(mz_zip_writer_init_file(&archive, path.asString().c_str(), 0));
+            for (const auto& [name, contents] : entries) {
+                REQUIRE(mz_zip_writer_add_mem(&archive, name.c_str(), contents.data(), contents.size(), MZ_DEFAULT_LEVEL));
+            }
+            REQUIRE(mz_zip_writer_finalize_archive(&archive));
+            REQUIRE(mz_zip_writer_end(&archive));
+        }
+
+        static GameConfig createZipGameConfig() {
+            return GameConfig(
+                "Quake3",
+                IO::Path(),
+                IO::Path(),
+                false,
+                std::vector<MapFormatConfig>(),
+                FileSystemConfig(
+                    IO::Path("baseq3"),
+                    PackageFormatConfig("pk3", "zip")
+                ),
+                TextureConfig(
+                    TexturePackageConfig(IO::Path("textures")),
+                    PackageFormatConfig(std::vector<std::string>{ "tga", "jpg" }, "image"),
+                    IO::Path(),
+                    "_tb_textures",
+                    IO::Path(),
+                    std::vector<std::string>()
+                ),
+                EntityConfig(),
+                FaceAttribsConfig(),
+                std::vector<SmartTag>(),
+                std::nullopt, // soft map bounds
+                {} // compilation tools
+            );
+        }
+
+        static std::string readFile(const GameFileSystem& fs, const IO::Path& path) {
+            const auto file = fs.openFile(path);
+            auto reader = file->reader().buffer();
+            return std::string(reader.stringView());
+        }
+
+        TEST_CASE("GameFileSystemTest.packagePriority", "[GameFileSystemTest]") {
+            IO::TestEnvironment env("GameFileSystemTest");
+            env.createDirectory(IO::Path("baseq3"));
+
+            // the packages are written in reverse order to make sure that they are not added in file system order
+            for (size_t i = 0; i < 8u; ++i) {
+                const auto index = std::to_string(7u - i);
+                createZipFile(env.dir() + IO::Path("baseq3/pak" + index + ".pk3"), {
+                    { "shared.txt", "pak" + index },
+                    { "pak" + index + ".txt", index }
+                });
+            }
+            env.createFile(IO::Path("baseq3/corrupt.pk3"), "not a zip file");
+
+            NullLogger logger;
+            GameFileSystem fs;
+            fs.initialize(createZipGameConfig(), env.dir(), {}, logger);
+
+            // later packages take precedence over earlier ones
+            CHECK(readFile(fs, IO::Path("shared.txt")) == "pak7");
+            for (size_t i = 0; i < 8u; ++i) {
+                const auto index = std::to_string(i);
+                CHECK(readFile(fs, IO::Path("pak" + index + ".txt")) == index);
+            }
+        }
+    }
+}
@@ -21,9 +21,14 @@
 #include "IO/DiskIO.h"
 #include "IO/Path.h"
 
+#include <vecmath/bbox.h>
 #include <vecmath/polygon.h>
+#include <vecmath/vec.h>
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -62,5 +67,38 @@ namespace TrenchBroom {
             const Model::PortalFile portalFile(path);
             CHECK(portalFile.portals() == ExpectedPortals);
         }
+
+        TEST_CASE("PortalFileTest.reportProgress", "[PortalFileTest]") {
+            const auto path = IO::Path("fixture/test/Model/PortalFile/portaltest_prt1.prt");
+            std::atomic<float> progress(0.0f);
+            const std::atomic<bool> cancelled(false);
+
+            const Model::PortalFile portalFile(path, progress, cancelled);
+            CHECK(portalFile.portals() == ExpectedPortals);
+            CHECK(progress == 1.0f);
+        }
+
+        TEST_CASE("PortalFileTest.cancelLoading", "[PortalFileTest]") {
+            const auto path = IO::Path("fixture/test/Model/PortalFile/portaltest_prt1.prt");
+            std::atomic<float> progress(0.0f);
+            const std::atomic<bool> cancelled(true);
+
+            const Model::PortalFile portalFile(path, progress, cancelled);
+            CHECK(portalFile.portals().empty());
+            CHECK(portalFile.findPortals(vm::bbox3f(-1024.0f, 1024.0f)).empty());
+        }
+
+        TEST_CASE("PortalFileTest.findPortals", "[PortalFileTest]") {
+            const auto path = IO::Path("fixture/test/Model/PortalFile/portaltest_prt1.prt");
+            const Model::PortalFile portalFile(path);
+
+            CHECK(portalFile.findPortals(vm::bbox3f(vm::vec3f(-512.0f, -512.0f, 512.0f), vm::vec3f(512.0f, 512.0f, 1024.0f))).empty());
+            CHECK(portalFile.findPortals(vm::bbox3f(vm::vec3f(-60.0f, -8.0f, 72.0f), vm::vec3f(-40.0f, 8.0f, 88.0f))) == std::vector<size_t>{ 0u });
+            CHECK(portalFile.findPortals(vm::bbox3f(vm::vec3f(60.0f, 40.0f, 30.0f), vm::vec3f(70.0f, 56.0f, 34.0f))) == std::vector<size_t>{ 2u });
+
+            auto allPortals = portalFile.findPortals(vm::bbox3f(-1024.0f, 1024.0f));
+            std::sort(std::begin(allPortals), std::end(allPortals));
+            CHECK(allPortals == std::vector<size_t>{ 0u, 1u, 2u, 3u, 4u });
+        }
     }
 }
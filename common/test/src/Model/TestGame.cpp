@@ -39,8 +39,6 @@
 #include <memory>
 #include <vector>
 
-#include "Catch2.h"
-
 #include "TestGame.h"
 
 namespace TrenchBroom {
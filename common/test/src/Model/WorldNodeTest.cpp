@@ -17,6 +17,9 @@
  along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
 #include "Model/Entity.h"
 #include "Model/Group.h"
 #include "Model/GroupNode.h"
@@ -25,6 +28,15 @@
 #include "Model/MapFormat.h"
 #include "Model/WorldNode.h"
 
+#include <kdl/result.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
+#include <vecmath/vec.h>
+
+#include <vector>
+
 #include "Catch2.h"
 
 namespace TrenchBroom {
@@ -127,5 +139,70 @@ namespace TrenchBroom {
             layerNode->addChild(groupNode);
             CHECK(groupNode->persistentId() == 2u);
         }
+
+        static std::vector<Node*> findNodesContaining(WorldNode& worldNode, const vm::vec3& point) {
+            auto result = std::vector<Node*>{};
+            worldNode.findNodesContaining(point, result);
+            return result;
+        }
+
+        TEST_CASE("WorldNodeTest.nodeTreeBatch", "[WorldNodeTest]") {
+            const auto worldBounds = vm::bbox3(8192.0);
+
+            auto worldNode = WorldNode{Entity{}, MapFormat::Standard};
+            auto* groupNode = new GroupNode{Group{"group"}};
+            auto* brushNode1 = new BrushNode{BrushBuilder{MapFormat::Standard, worldBounds}.createCube(32.0, "texture").value()};
+            auto* brushNode2 = new BrushNode{BrushBuilder{MapFormat::Standard, worldBounds}.createCube(32.0, "texture").value()};
+
+            worldNode.defaultLayer()->addChild(groupNode);
+            groupNode->addChild(brushNode1);
+            groupNode->addChild(brushNode2);
+
+            const auto translate = [&](BrushNode* brushNode, const vm::vec3& delta) {
+                auto brush = brushNode->brush();
+                REQUIRE(brush.transform(worldBounds, vm::translation_matrix(delta), false).is_success());
+                brushNode->setBrush(std::move(brush));
+            };
+
+            const auto newPosition = vm::vec3(128.0, 0.0, 0.0);
+
+            SECTION("Node tree is updated when the batch is closed") {
+                {
+                    const auto batch = NodeTreeBatch{worldNode};
+                    translate(brushNode1, newPosition);
+
+                    // the node tree still contains the old bounds
+                    CHECK(findNodesContaining(worldNode, newPosition).empty());
+                }
+
+                CHECK(findNodesContaining(worldNode, newPosition) == std::vector<Node*>{brushNode1});
+                CHECK(groupNode->physicalBounds().contains(brushNode1->physicalBounds()));
+            }
+
+            SECTION("Several nodes are updated when the batch is closed") {
+                {
+                    const auto batch = NodeTreeBatch{worldNode};
+                    translate(brushNode1, newPosition / 2.0);
+                    translate(brushNode1, newPosition / 2.0);
+                    translate(brushNode2, newPosition);
+                }
+
+                CHECK_THAT(findNodesContaining(worldNode, newPosition), Catch::UnorderedEquals(std::vector<Node*>{brushNode1, brushNode2}));
+                CHECK(findNodesContaining(worldNode, vm::vec3::zero()).empty());
+            }
+
+            SECTION("Removing a changed node within a batch") {
+                {
+                    const auto batch = NodeTreeBatch{worldNode};
+                    translate(brushNode1, newPosition);
+                    translate(brushNode2, newPosition);
+
+                    groupNode->removeChild(brushNode1);
+                    delete brushNode1;
+                }
+
+                CHECK(findNodesContaining(worldNode, newPosition) == std::vector<Node*>{brushNode2});
+            }
+        }
     }
 }
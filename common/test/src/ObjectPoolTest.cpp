@@ -0,0 +1,67 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ObjectPool.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    struct PooledObject {
+        double value;
+        char padding[20];
+    };
+
+    TEST_CASE("ObjectPoolTest.allocateAndDeallocate", "[ObjectPoolTest]") {
+        ObjectPool<PooledObject, 4u> pool;
+        CHECK(pool.allocatedCount() == 0u);
+        CHECK(pool.reservedBytes() == 0u);
+
+        std::vector<void*> ptrs;
+        for (size_t i = 0u; i < 6u; ++i) {
+            auto* ptr = pool.allocate();
+            CHECK(reinterpret_cast<std::uintptr_t>(ptr) % alignof(PooledObject) == 0u);
+            ptrs.push_back(ptr);
+        }
+
+        CHECK(pool.allocatedCount() == 6u);
+        CHECK(pool.reservedBytes() >= 8u * sizeof(PooledObject));
+
+        // allocating more objects than fit in one block must not return the same memory twice
+        for (size_t i = 0u; i < ptrs.size(); ++i) {
+            for (size_t j = i + 1u; j < ptrs.size(); ++j) {
+                CHECK(ptrs[i] != ptrs[j]);
+            }
+        }
+
+        const auto reservedBytes = pool.reservedBytes();
+        pool.deallocate(ptrs[2]);
+        pool.deallocate(nullptr);
+        CHECK(pool.allocatedCount() == 5u);
+
+        // freed slots are reused before new blocks are allocated
+        CHECK(pool.allocate() == ptrs[2]);
+        CHECK(pool.allocate() != nullptr);
+        CHECK(pool.allocate() != nullptr);
+        CHECK(pool.allocatedCount() == 8u);
+        CHECK(pool.reservedBytes() == reservedBytes);
+    }
+}
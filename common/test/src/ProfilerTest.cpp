@@ -0,0 +1,71 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Profiler.h"
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    static size_t countOccurrences(const std::string& str, const std::string& pattern) {
+        size_t result = 0u;
+        for (auto i = str.find(pattern); i != std::string::npos; i = str.find(pattern, i + pattern.size())) {
+            ++result;
+        }
+        return result;
+    }
+
+    static std::string writeTrace() {
+        std::stringstream stream;
+        Profiler::writeTrace(stream);
+        return stream.str();
+    }
+
+    TEST_CASE("ProfilerTest.writeTrace", "[ProfilerTest]") {
+        Profiler::clear();
+
+        {
+            const ProfileScope outer("outer");
+            {
+                const ProfileScope inner("inner \"quoted\"");
+            }
+            Profiler::recordCounter("counter", 42);
+        }
+
+        std::thread thread([]() {
+            const ProfileScope scope("worker");
+        });
+        thread.join();
+
+        const auto trace = writeTrace();
+        CHECK(trace.find("{\"traceEvents\":[") == 0u);
+        CHECK(countOccurrences(trace, "\"ph\":\"X\"") == 3u);
+        CHECK(countOccurrences(trace, "\"ph\":\"C\"") == 1u);
+        CHECK(trace.find("\"name\":\"outer\"") != std::string::npos);
+        CHECK(trace.find("\"name\":\"inner \\\"quoted\\\"\"") != std::string::npos);
+        CHECK(trace.find("\"name\":\"worker\"") != std::string::npos);
+        CHECK(trace.find("\"args\":{\"value\":42}") != std::string::npos);
+
+        Profiler::clear();
+        CHECK(countOccurrences(writeTrace(), "\"name\"") == 0u);
+    }
+}
@@ -0,0 +1,106 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/EntityNode.h"
+#include "Renderer/EntityModelBatcher.h"
+#include "Renderer/TexturedIndexRangeRenderer.h"
+
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace Renderer {
+        static const EntityModelBatch* findBatch(const std::vector<EntityModelBatch>& batches, const TexturedRenderer* renderer) {
+            const auto it = std::find_if(std::begin(batches), std::end(batches), [&](const auto& batch) { return batch.renderer == renderer; });
+            return it != std::end(batches) ? &*it : nullptr;
+        }
+
+        TEST_CASE("EntityModelBatcherTest.groupByRenderer", "[EntityModelBatcherTest]") {
+            TexturedIndexRangeRenderer renderer1, renderer2;
+            Model::EntityNode entityNode1, entityNode2, entityNode3;
+
+            const auto transformation1 = vm::translation_matrix(vm::vec3f(1, 0, 0));
+            const auto transformation2 = vm::translation_matrix(vm::vec3f(2, 0, 0));
+            const auto transformation3 = vm::translation_matrix(vm::vec3f(3, 0, 0));
+
+            EntityModelBatcher batcher;
+            batcher.setInstance(&entityNode1, &renderer1, transformation1);
+            batcher.setInstance(&entityNode2, &renderer2, transformation2);
+            batcher.setInstance(&entityNode3, &renderer1, transformation3);
+            CHECK(batcher.instanceCount() == 3u);
+
+            const auto& batches = batcher.batches();
+            REQUIRE(batches.size() == 2u);
+
+            const auto* batch1 = findBatch(batches, &renderer1);
+            REQUIRE(batch1 != nullptr);
+            REQUIRE(batch1->entityNodes.size() == 2u);
+            REQUIRE(batch1->transformations.size() == 2u);
+            for (size_t i = 0; i < batch1->entityNodes.size(); ++i) {
+                const auto& expected = batch1->entityNodes[i] == &entityNode1 ? transformation1 : transformation3;
+                CHECK(batch1->transformations[i] == expected);
+            }
+
+            const auto* batch2 = findBatch(batches, &renderer2);
+            REQUIRE(batch2 != nullptr);
+            CHECK(batch2->entityNodes == std::vector<Model::EntityNode*>{ &entityNode2 });
+            CHECK(batch2->transformations == std::vector<vm::mat4x4f>{ transformation2 });
+        }
+
+        TEST_CASE("EntityModelBatcherTest.updateAndRemove", "[EntityModelBatcherTest]") {
+            TexturedIndexRangeRenderer renderer1, renderer2;
+            Model::EntityNode entityNode1, entityNode2;
+
+            const auto transformation1 = vm::translation_matrix(vm::vec3f(1, 0, 0));
+            const auto transformation2 = vm::translation_matrix(vm::vec3f(2, 0, 0));
+
+            EntityModelBatcher batcher;
+            batcher.setInstance(&entityNode1, &renderer1, transformation1);
+            batcher.setInstance(&entityNode2, &renderer1, transformation1);
+            REQUIRE(batcher.batches().size() == 1u);
+
+            // changing the renderer moves the entity to another batch
+            batcher.setInstance(&entityNode2, &renderer2, transformation2);
+            CHECK(batcher.instanceCount() == 2u);
+            REQUIRE(batcher.batches().size() == 2u);
+            CHECK(findBatch(batcher.batches(), &renderer2)->transformations == std::vector<vm::mat4x4f>{ transformation2 });
+
+            // a null renderer removes the entity
+            batcher.setInstance(&entityNode2, nullptr, transformation2);
+            CHECK(batcher.instanceCount() == 1u);
+            REQUIRE(batcher.batches().size() == 1u);
+            CHECK(batcher.batches().front().entityNodes == std::vector<Model::EntityNode*>{ &entityNode1 });
+
+            batcher.removeInstance(&entityNode1);
+            CHECK(batcher.instanceCount() == 0u);
+            CHECK(batcher.batches().empty());
+
+            batcher.setInstance(&entityNode1, &renderer1, transformation1);
+            batcher.clear();
+            CHECK(batcher.instanceCount() == 0u);
+            CHECK(batcher.batches().empty());
+        }
+    }
+}
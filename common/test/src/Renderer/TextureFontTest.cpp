@@ -0,0 +1,83 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Renderer/AttrString.h"
+#include "Renderer/FontGlyph.h"
+#include "Renderer/FontTexture.h"
+#include "Renderer/TextureFont.h"
+
+#include <vecmath/vec.h>
+
+#include <memory>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace Renderer {
+        static std::unique_ptr<TextureFont> makeFont() {
+            // the font texture does not allocate any GL resources until it is activated
+            const size_t cellCount = 10u;
+            const size_t cellSize = 16u;
+            const unsigned char firstChar = ' ';
+            const unsigned char charCount = 95u;
+
+            std::vector<FontGlyph> glyphs;
+            for (size_t i = 0u; i < charCount; ++i) {
+                glyphs.emplace_back((i % cellCount) * cellSize, (i / cellCount) * cellSize, 8u + i % 4u, 12u, 9u + i % 4u);
+            }
+
+            return std::make_unique<TextureFont>(std::make_unique<FontTexture>(cellCount, cellSize, 1u), glyphs, 14, firstChar, charCount);
+        }
+
+        TEST_CASE("TextureFontTest.layout", "[TextureFontTest]") {
+            auto font = makeFont();
+
+            const auto string = AttrString("info_player_start");
+            const auto layout = font->layout(string);
+            REQUIRE(layout != nullptr);
+            CHECK(layout->vertices == font->quads(string, true));
+            CHECK(layout->size == font->measure(string));
+        }
+
+        TEST_CASE("TextureFontTest.layoutIsCached", "[TextureFontTest]") {
+            auto font = makeFont();
+
+            const auto layout1 = font->layout(AttrString("light"));
+            const auto layout2 = font->layout(AttrString("light"));
+            const auto layout3 = font->layout(AttrString("light_torch"));
+
+            CHECK(layout1 == layout2);
+            CHECK(layout1 != layout3);
+            CHECK(layout1->vertices != layout3->vertices);
+        }
+
+        TEST_CASE("TextureFontTest.layoutMultipleLines", "[TextureFontTest]") {
+            auto font = makeFont();
+
+            auto string = AttrString();
+            string.appendLeftJustified("func_door");
+            string.appendCentered("door1");
+
+            const auto layout = font->layout(string);
+            CHECK(layout->vertices == font->quads(string, true));
+            CHECK(layout->size == font->measure(string));
+        }
+    }
+}
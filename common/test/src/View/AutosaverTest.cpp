@@ -20,13 +20,31 @@
 #include "Logger.h"
 #include "IO/Path.h"
 #include "IO/TestEnvironment.h"
+#include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/Brush.h"
 #include "Model/BrushNode.h"
+#include "Model/Entity.h"
+#include "Model/EntityNode.h"
+#include "Model/GroupNode.h"
 #include "Model/LayerNode.h"
+#include "Model/WorldNode.h"
 #include "View/Autosaver.h"
 #include "View/MapDocumentTest.h"
 
+#include <kdl/overload.h>
+#include <kdl/string_compare.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+
 #include <chrono>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -99,6 +117,7 @@ namespace TrenchBroom {
             std::this_thread::sleep_for(100ms);
 
             autosaver.triggerAutosave(logger);
+            autosaver.waitForPendingSave(logger);
 
             CHECK(env.fileExists(IO::Path("autosave/test.1.map")));
             CHECK(env.directoryExists(IO::Path("autosave")));
@@ -123,6 +142,7 @@ namespace TrenchBroom {
             std::this_thread::sleep_for(100ms);
 
             autosaver.triggerAutosave(logger);
+            autosaver.waitForPendingSave(logger);
 
             CHECK(env.fileExists(IO::Path("autosave/test.1.map")));
             CHECK(env.directoryExists(IO::Path("autosave")));
@@ -132,12 +152,14 @@ namespace TrenchBroom {
             std::this_thread::sleep_for(100ms);
 
             autosaver.triggerAutosave(logger);
+            autosaver.waitForPendingSave(logger);
             CHECK_FALSE(env.fileExists(IO::Path("autosave/test.2.map")));
 
             // modify the map
             document->addNode(createBrushNode("some_texture"), document->currentLayer());
 
             autosaver.triggerAutosave(logger);
+            autosaver.waitForPendingSave(logger);
             CHECK(env.fileExists(IO::Path("autosave/test.2.map")));
         }
 
@@ -163,8 +185,242 @@ namespace TrenchBroom {
             document->addNode(createBrushNode("some_texture"), document->currentLayer());
 
             autosaver.triggerAutosave(logger);
+            autosaver.waitForPendingSave(logger);
+
+            CHECK(env.fileExists(IO::Path("autosave/test.2.map")));
+        }
+
+        static size_t countBrushes(const IO::Path& path) {
+            std::ifstream stream(path.asString());
+            REQUIRE(stream.good());
+
+            size_t result = 0u;
+            std::string line;
+            while (std::getline(stream, line)) {
+                if (kdl::cs::str_is_prefix(line, "// brush ")) {
+                    ++result;
+                }
+            }
+            return result;
+        }
+
+        TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverSavesSnapshotWhileEditing") {
+            using namespace std::literals::chrono_literals;
+
+            IO::TestEnvironment env("autosaver_test");
+            NullLogger logger;
+
+            for (size_t i = 0u; i < 1000u; ++i) {
+                document->addNode(createBrushNode("some_texture"), document->currentLayer());
+            }
+
+            document->saveDocumentAs(env.dir() + IO::Path("test.map"));
+            assert(env.fileExists(IO::Path("test.map")));
+
+            const auto savedBrushCount = countBrushes(env.dir() + IO::Path("test.map"));
+            const auto savedChildCount = document->currentLayer()->childCount();
+
+            Autosaver autosaver(document, 0s);
+
+            // modify the map
+            document->addNode(createBrushNode("some_texture"), document->currentLayer());
+            autosaver.triggerAutosave(logger);
+
+            // keep editing while the backup is being written
+            document->addNode(createBrushNode("some_texture"), document->currentLayer());
+            CHECK(document->currentLayer()->childCount() == savedChildCount + 2u);
+
+            autosaver.waitForPendingSave(logger);
+
+            // the backup contains the state of the map at the time the autosave was triggered
+            CHECK(env.fileExists(IO::Path("autosave/test.1.map")));
+            CHECK_FALSE(env.fileExists(IO::Path("autosave/test.1.map.tmp")));
+            CHECK(countBrushes(env.dir() + IO::Path("autosave/test.1.map")) == savedBrushCount + 1u);
+
+            document->addNode(createBrushNode("some_texture"), document->currentLayer());
+            autosaver.triggerAutosave(logger);
+
+            // the second backup supersedes the first one if it is triggered before the first one is written
+            document->addNode(createBrushNode("some_texture"), document->currentLayer());
+            autosaver.triggerAutosave(logger);
+            autosaver.waitForPendingSave(logger);
+
+            CHECK_FALSE(env.fileExists(IO::Path("autosave/test.3.map.tmp")));
+            if (env.fileExists(IO::Path("autosave/test.3.map"))) {
+                CHECK(countBrushes(env.dir() + IO::Path("autosave/test.3.map")) == savedBrushCount + 4u);
+            } else {
+                CHECK(countBrushes(env.dir() + IO::Path("autosave/test.2.map")) == savedBrushCount + 4u);
+            }
+        }
+
+        static std::vector<const Model::Node*> collectObjects(const Model::WorldNode& world) {
+            std::vector<const Model::Node*> result;
+            world.accept(kdl::overload(
+                [] (auto&& thisLambda, const Model::WorldNode* worldNode) { worldNode->visitChildren(thisLambda); },
+                [] (auto&& thisLambda, const Model::LayerNode* layer)     { layer->visitChildren(thisLambda); },
+                [] (auto&& thisLambda, const Model::GroupNode* group)     { group->visitChildren(thisLambda); },
+                [&](auto&& thisLambda, const Model::EntityNode* entity)   { result.push_back(entity); entity->visitChildren(thisLambda); },
+                [&](const Model::BrushNode* brush)                        { result.push_back(brush); }
+            ));
+            return result;
+        }
+
+        static size_t countBrushesWithBounds(const std::vector<const Model::Node*>& objects, const vm::bbox3& bounds) {
+            size_t result = 0u;
+            for (const auto* object : objects) {
+                if (const auto* brushNode = dynamic_cast<const Model::BrushNode*>(object)) {
+                    if (brushNode->brush().bounds() == bounds) {
+                        ++result;
+                    }
+                }
+            }
+            return result;
+        }
+
+        static size_t countEntitiesWithClassname(const std::vector<const Model::Node*>& objects, const std::string& classname) {
+            size_t result = 0u;
+            for (const auto* object : objects) {
+                if (const auto* entityNode = dynamic_cast<const Model::EntityNode*>(object)) {
+                    if (entityNode->entity().classname() == classname) {
+                        ++result;
+                    }
+                }
+            }
+            return result;
+        }
+
+        TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverRecoversJournal") {
+            using namespace std::literals::chrono_literals;
+
+            IO::TestEnvironment env("autosaver_test");
+            NullLogger logger;
+
+            auto* brushNode1 = createBrushNode("some_texture");
+            auto* brushNode2 = createBrushNode("some_texture");
+            document->addNode(brushNode1, document->currentLayer());
+            document->addNode(brushNode2, document->currentLayer());
+
+            document->saveDocumentAs(env.dir() + IO::Path("test.map"));
+            assert(env.fileExists(IO::Path("test.map")));
+
+            const auto savedBrushCount = countBrushes(env.dir() + IO::Path("test.map"));
+
+            {
+                Autosaver autosaver(document, 0s, 50u, 10u);
+
+                // the first autosave writes a full backup and starts a journal
+                document->addNode(createBrushNode("some_texture"), document->currentLayer());
+                autosaver.triggerAutosave(logger);
+                autosaver.waitForPendingSave(logger);
+
+                CHECK(env.fileExists(IO::Path("autosave/test.1.map")));
+                CHECK(env.fileExists(IO::Path("autosave/test.journal")));
+
+                // the following autosaves only append to the journal
+                document->addNode(new Model::EntityNode({
+                    {"classname", "info_player_start"}
+                }), document->currentLayer());
+                document->removeNode(brushNode1);
+                autosaver.triggerAutosave(logger);
+                autosaver.waitForPendingSave(logger);
+
+                document->select(brushNode2);
+                REQUIRE(document->translateObjects(vm::vec3(64.0, 0.0, 0.0)));
+                document->deselectAll();
+                autosaver.triggerAutosave(logger);
+                autosaver.waitForPendingSave(logger);
+
+                CHECK_FALSE(env.fileExists(IO::Path("autosave/test.2.map")));
+            }
+
+            // the journal is left behind as if the editor had crashed, so it is replayed into a new backup
+            Autosaver autosaver(document, 0s, 50u, 10u);
+            autosaver.triggerAutosave(logger);
+            autosaver.waitForPendingSave(logger);
+
+            CHECK(env.fileExists(IO::Path("autosave/test.2.map")));
+            CHECK_FALSE(env.fileExists(IO::Path("autosave/test.journal")));
+            CHECK(countBrushes(env.dir() + IO::Path("autosave/test.2.map")) == savedBrushCount);
+
+            std::ifstream stream((env.dir() + IO::Path("autosave/test.2.map")).asString());
+            const auto recoveredMap = std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+
+            IO::TestParserStatus status;
+            IO::WorldReader reader(recoveredMap, document->world()->mapFormat());
+            const auto recoveredWorld = reader.read(document->worldBounds(), status);
+            const auto recoveredObjects = collectObjects(*recoveredWorld);
+            CHECK(recoveredObjects.size() == collectObjects(*document->world()).size());
+            CHECK(countBrushesWithBounds(recoveredObjects, brushNode2->brush().bounds()) == 1u);
+            CHECK(countEntitiesWithClassname(recoveredObjects, "info_player_start") == 1u);
+        }
+
+        TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverDeletesRedundantJournal") {
+            using namespace std::literals::chrono_literals;
+
+            IO::TestEnvironment env("autosaver_test");
+            NullLogger logger;
+
+            document->saveDocumentAs(env.dir() + IO::Path("test.map"));
+            assert(env.fileExists(IO::Path("test.map")));
+
+            {
+                Autosaver autosaver(document, 0s, 50u, 10u);
+
+                document->addNode(createBrushNode("some_texture"), document->currentLayer());
+                autosaver.triggerAutosave(logger);
+                autosaver.waitForPendingSave(logger);
+
+                CHECK(env.fileExists(IO::Path("autosave/test.1.map")));
+                CHECK(env.fileExists(IO::Path("autosave/test.journal")));
+            }
+
+            // the journal has no entries, so the backup contains all of its changes
+            CHECK(env.fileExists(IO::Path("autosave/test.1.map")));
+            CHECK_FALSE(env.fileExists(IO::Path("autosave/test.journal")));
+
+            // no backup is recovered in the next session
+            Autosaver autosaver(document, 0s, 50u, 10u);
+            autosaver.triggerAutosave(logger);
+            autosaver.waitForPendingSave(logger);
+
+            CHECK_FALSE(env.fileExists(IO::Path("autosave/test.2.map")));
+        }
+
+        TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverCompactsJournal") {
+            using namespace std::literals::chrono_literals;
+
+            IO::TestEnvironment env("autosaver_test");
+            NullLogger logger;
+
+            // make the backup large enough that the journal is compacted because of its number of entries
+            for (size_t i = 0u; i < 20u; ++i) {
+                document->addNode(createBrushNode("some_texture"), document->currentLayer());
+            }
+
+            document->saveDocumentAs(env.dir() + IO::Path("test.map"));
+            assert(env.fileExists(IO::Path("test.map")));
+
+            const auto savedBrushCount = countBrushes(env.dir() + IO::Path("test.map"));
+
+            Autosaver autosaver(document, 0s, 50u, 2u);
+
+            const auto autosave = [&]() {
+                document->addNode(createBrushNode("some_texture"), document->currentLayer());
+                autosaver.triggerAutosave(logger);
+                autosaver.waitForPendingSave(logger);
+            };
+
+            autosave();
+            CHECK(env.fileExists(IO::Path("autosave/test.1.map")));
+
+            autosave();
+            autosave();
+            CHECK_FALSE(env.fileExists(IO::Path("autosave/test.2.map")));
 
+            autosave();
             CHECK(env.fileExists(IO::Path("autosave/test.2.map")));
+            CHECK(env.fileExists(IO::Path("autosave/test.journal")));
+            CHECK(countBrushes(env.dir() + IO::Path("autosave/test.2.map")) == savedBrushCount + 4u);
         }
     }
 }
@@ -27,7 +27,9 @@
 #include <memory>
 #include <thread>
 #include <optional>
+#include <string>
 #include <variant>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -106,6 +108,7 @@ namespace TrenchBroom {
         class TestCommand : public UndoableCommand {
         private:
             mutable std::vector<TestCommandCall> m_expectedCalls;
+            std::optional<size_t> m_memorySize;
         public:
             static const CommandType Type;
 
@@ -119,6 +122,10 @@ namespace TrenchBroom {
             ~TestCommand() {
                 CHECK(m_expectedCalls.empty());
             }
+
+            size_t memorySize() const override {
+                return m_memorySize ? *m_memorySize : UndoableCommand::memorySize();
+            }
         private:
             template <class T>
             T popCall() const {
@@ -171,6 +178,13 @@ namespace TrenchBroom {
                 m_expectedCalls.emplace_back(DoCollateWith{returnCanCollate, expectedOtherCommand});
             }
 
+            /**
+             * Sets the memory size that this command reports to the command processor.
+             */
+            void setMemorySize(const size_t memorySize) {
+                m_memorySize = memorySize;
+            }
+
             deleteCopyAndMove(TestCommand)
         };
 
@@ -582,5 +596,91 @@ namespace TrenchBroom {
             REQUIRE(commandProcessor.undoCommandName() == commandName1);
             REQUIRE(commandProcessor.redoCommandName() == commandName2);
         }
+
+        TEST_CASE("CommandProcessorTest.undoMemoryLimit", "[CommandProcessorTest]") {
+            /*
+             * Simulate a long session of commands that each hold one megabyte. The memory held by the undo stack must
+             * never exceed the limit, and only the most recent commands can be undone.
+             */
+
+            constexpr size_t CommandCount = 1000u;
+            constexpr size_t CommandMemorySize = 1024u * 1024u;
+            constexpr size_t KeptCommandCount = 64u;
+
+            // use a long collation interval so that every command is offered for collation
+            CommandProcessor commandProcessor(nullptr, std::chrono::hours(1));
+            commandProcessor.setUndoMemoryLimit(KeptCommandCount * CommandMemorySize);
+
+            std::vector<TestCommand*> commands;
+            for (size_t i = 0u; i < CommandCount; ++i) {
+                auto command = TestCommand::create("test command " + std::to_string(i));
+                command->setMemorySize(CommandMemorySize);
+                command->expectDo(true);
+                if (!commands.empty()) {
+                    commands.back()->expectCollate(command.get(), false);
+                }
+
+                commands.push_back(command.get());
+                CHECK(commandProcessor.executeAndStore(std::move(command))->success());
+                CHECK(commandProcessor.undoMemorySize() <= commandProcessor.undoMemoryLimit());
+            }
+
+            CHECK(commandProcessor.undoMemorySize() == KeptCommandCount * CommandMemorySize);
+
+            // the older commands were deleted when they were removed from the undo stack
+            for (size_t i = 0u; i < KeptCommandCount; ++i) {
+                auto* command = commands[CommandCount - i - 1u];
+                command->expectUndo(true);
+
+                REQUIRE(commandProcessor.undoCommandName() == command->name());
+                CHECK(commandProcessor.undo()->success());
+            }
+
+            CHECK_FALSE(commandProcessor.canUndo());
+            CHECK(commandProcessor.undoMemorySize() == 0u);
+        }
+
+        TEST_CASE("CommandProcessorTest.setUndoMemoryLimit", "[CommandProcessorTest]") {
+            /*
+             * Lowering the limit removes the oldest commands, but the most recent command is always kept.
+             */
+
+            CommandProcessor commandProcessor(nullptr, std::chrono::hours(1));
+
+            const auto commandName1 = "test command 1";
+            auto command1 = TestCommand::create(commandName1);
+            command1->setMemorySize(100u);
+
+            const auto commandName2 = "test command 2";
+            auto command2 = TestCommand::create(commandName2);
+            command2->setMemorySize(200u);
+
+            const auto commandName3 = "test command 3";
+            auto command3 = TestCommand::create(commandName3);
+            command3->setMemorySize(300u);
+
+            command1->expectDo(true);
+            command1->expectCollate(command2.get(), false);
+            command2->expectDo(true);
+            command2->expectCollate(command3.get(), false);
+            command3->expectDo(true);
+            command3->expectUndo(true);
+
+            commandProcessor.executeAndStore(std::move(command1));
+            commandProcessor.executeAndStore(std::move(command2));
+            commandProcessor.executeAndStore(std::move(command3));
+            CHECK(commandProcessor.undoMemorySize() == 600u);
+
+            commandProcessor.setUndoMemoryLimit(500u);
+            CHECK(commandProcessor.undoMemorySize() == 500u);
+
+            commandProcessor.setUndoMemoryLimit(1u);
+            CHECK(commandProcessor.undoMemorySize() == 300u);
+            REQUIRE(commandProcessor.undoCommandName() == commandName3);
+
+            CHECK(commandProcessor.undo()->success());
+            CHECK_FALSE(commandProcessor.canUndo());
+            CHECK(commandProcessor.undoMemorySize() == 0u);
+        }
     }
 }
@@ -25,6 +25,7 @@
 #include "Model/BrushFace.h"
 #include "Model/BrushFaceHandle.h"
 #include "Model/BrushNode.h"
+#include "Model/ChangeBrushFaceAttributesRequest.h"
 #include "Model/EmptyPropertyKeyIssueGenerator.h"
 #include "Model/EmptyPropertyValueIssueGenerator.h"
 #include "Model/Entity.h"
@@ -41,11 +42,13 @@
 #include "Model/ParallelTexCoordSystem.h"
 #include "Model/PickResult.h"
 #include "Model/Polyhedron.h"
+#include "Model/PortalFile.h"
 #include "Model/TestGame.h"
 #include "Model/VisibilityState.h"
 #include "Model/WorldNode.h"
 #include "View/MapDocument.h"
 #include "View/MapDocumentCommandFacade.h"
+#include "View/NodeClipboard.h"
 #include "View/PasteType.h"
 #include "View/SelectionTool.h"
 
@@ -199,6 +202,61 @@ namespace TrenchBroom {
             CHECK(brushNode2->logicalBounds() == brush2ExpectedBounds);
         }
 
+        TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.transformManyBrushes") {
+            // enough brushes so that they are transformed in parallel
+            Model::BrushBuilder builder(document->world()->mapFormat(), document->worldBounds());
+
+            std::vector<Model::Node*> brushNodes;
+            for (size_t i = 0; i < 100; ++i) {
+                const auto x = static_cast<FloatType>(i) * 64.0;
+                brushNodes.push_back(new Model::BrushNode(builder.createCuboid(vm::bbox3(vm::vec3(x, 0.0, 0.0), vm::vec3(x + 32.0, 32.0, 32.0)), "texture").value()));
+            }
+
+            document->addNodes(brushNodes, document->parentForNodes());
+            document->select(brushNodes);
+
+            CHECK(document->translateObjects(vm::vec3(0.0, 16.0, 0.0)));
+            for (size_t i = 0; i < brushNodes.size(); ++i) {
+                const auto x = static_cast<FloatType>(i) * 64.0;
+                CHECK(brushNodes[i]->logicalBounds() == vm::bbox3(vm::vec3(x, 16.0, 0.0), vm::vec3(x + 32.0, 48.0, 32.0)));
+            }
+
+            // the last brush would be moved out of the world bounds, so no brush must be moved
+            CHECK_FALSE(document->translateObjects(vm::vec3(2048.0, 0.0, 0.0)));
+            for (size_t i = 0; i < brushNodes.size(); ++i) {
+                const auto x = static_cast<FloatType>(i) * 64.0;
+                CHECK(brushNodes[i]->logicalBounds() == vm::bbox3(vm::vec3(x, 16.0, 0.0), vm::vec3(x + 32.0, 48.0, 32.0)));
+            }
+        }
+
+        TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.setFaceAttributesOfManyBrushes") {
+            // enough brushes so that they are modified in parallel
+            std::vector<Model::BrushNode*> brushNodes;
+            for (size_t i = 0; i < 100; ++i) {
+                brushNodes.push_back(createBrushNode());
+            }
+            document->addNodes(kdl::vec_element_cast<Model::Node*>(brushNodes), document->parentForNodes());
+
+            // interleave the faces of different brushes
+            std::vector<Model::BrushFaceHandle> faceHandles;
+            for (size_t faceIndex = 0; faceIndex < 6; ++faceIndex) {
+                for (auto* brushNode : brushNodes) {
+                    faceHandles.emplace_back(brushNode, faceIndex);
+                }
+            }
+            document->select(faceHandles);
+
+            Model::ChangeBrushFaceAttributesRequest request;
+            request.setXOffset(8.0f);
+            CHECK(document->setFaceAttributes(request));
+
+            for (const auto* brushNode : brushNodes) {
+                for (const auto& face : brushNode->brush().faces()) {
+                    CHECK(face.attributes().xOffset() == 8.0f);
+                }
+            }
+        }
+
         TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.shearCube") {
             const vm::bbox3 initialBBox(vm::vec3(100,100,100), vm::vec3(200,200,200));
 
@@ -1114,6 +1172,72 @@ namespace TrenchBroom {
             CHECK(document->selectionBounds() == box.translate(delta));
         }
 
+        TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.pasteClonedNodes") {
+            // delete default brush
+            document->selectAllNodes();
+            document->deleteObjects();
+
+            auto* brushNode1 = createBrushNode();
+            auto* brushNode2 = createBrushNode();
+            auto* brushNode3 = createBrushNode();
+            document->addNode(brushNode1, document->parentForNodes());
+            document->addNode(brushNode2, document->parentForNodes());
+            document->addNode(brushNode3, document->parentForNodes());
+
+            document->select(std::vector<Model::Node*>{ brushNode1, brushNode2 });
+            auto* brushEntity = document->createBrushEntity(m_brushEntityDef);
+            REQUIRE(brushEntity != nullptr);
+
+            document->deselectAll();
+            document->select(std::vector<Model::Node*>{ brushNode1, brushNode3 });
+
+            // the selected brush of the entity is copied together with a copy of the entity
+            auto clones = document->cloneSelectedNodes();
+            REQUIRE(clones.size() == 2u);
+
+            auto* entityClone = dynamic_cast<Model::EntityNode*>(clones[0]);
+            REQUIRE(entityClone != nullptr);
+            CHECK(entityClone->entity().classname() == brushEntity->entity().classname());
+            CHECK(entityClone->childCount() == 1u);
+            CHECK(dynamic_cast<Model::BrushNode*>(clones[1]) != nullptr);
+
+            NodeClipboard clipboard;
+            const auto id = clipboard.setNodes(document->world()->mapFormat(), document->worldBounds(), std::move(clones));
+
+            // the clipboard does not refer to the assets of the document
+            CHECK(entityClone->entity().definition() == nullptr);
+            CHECK(clipboard.cloneNodes(id + 1u, document->world()->mapFormat(), document->worldBounds()).empty());
+            CHECK(clipboard.cloneNodes(id, Model::MapFormat::Quake3, document->worldBounds()).empty());
+            CHECK(clipboard.cloneNodes(id, document->world()->mapFormat(), vm::bbox3(1024.0)).empty());
+
+            const auto layerChildCount = document->currentLayer()->childCount();
+            CHECK(document->paste(clipboard.cloneNodes(id, document->world()->mapFormat(), document->worldBounds())) == PasteType::Node);
+            CHECK(document->currentLayer()->childCount() == layerChildCount + 2u);
+            CHECK(document->selectedNodes().brushCount() == 2u);
+            CHECK(document->selectedNodes().brushes().front()->brush() == brushNode1->brush());
+
+            // the pasted brushes have complete geometry
+            const auto& pastedBrush = document->selectedNodes().brushes().front()->brush();
+            REQUIRE(pastedBrush.faceCount() == brushNode1->brush().faceCount());
+            CHECK(pastedBrush.vertexPositions() == brushNode1->brush().vertexPositions());
+            for (size_t i = 0u; i < pastedBrush.faceCount(); ++i) {
+                CHECK(pastedBrush.face(i).geometry() != nullptr);
+                CHECK(pastedBrush.face(i).vertexPositions() == brushNode1->brush().face(i).vertexPositions());
+            }
+
+            // the pasted nodes refer to the assets of the document again
+            const auto* pastedEntity = dynamic_cast<const Model::EntityNode*>(document->selectedNodes().brushes().front()->entity());
+            REQUIRE(pastedEntity != nullptr);
+            CHECK(pastedEntity->entity().definition() == m_brushEntityDef);
+
+            // the clipboard keeps its nodes so that they can be pasted again
+            CHECK(document->paste(clipboard.cloneNodes(id, document->world()->mapFormat(), document->worldBounds())) == PasteType::Node);
+            CHECK(document->currentLayer()->childCount() == layerChildCount + 4u);
+
+            clipboard.clear();
+            CHECK(clipboard.cloneNodes(id, document->world()->mapFormat(), document->worldBounds()).empty());
+        }
+
         // https://github.com/TrenchBroom/TrenchBroom/issues/3117
         TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.isolate") {
             // delete default brush
@@ -1550,5 +1674,25 @@ namespace TrenchBroom {
             document->redoCommand();
             CHECK(document->currentLayer() == layerNode2);
         }
+
+        TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.loadPortalFileInBackground", "[MapDocumentTest]") {
+            const auto path = IO::Path("fixture/test/Model/PortalFile/portaltest_prt1.prt");
+
+            document->loadPortalFile(path);
+            CHECK(document->portalFileLoadProgress().has_value());
+
+            document->waitForBackgroundLoads();
+            CHECK_FALSE(document->portalFileLoadProgress().has_value());
+            REQUIRE(document->isPortalFileLoaded());
+            CHECK(document->portalFile()->portals().size() == 5u);
+
+            document->loadPortalFile(IO::Path("fixture/test/Model/PortalFile/portaltest_prt1_invalid.prt"));
+            document->waitForBackgroundLoads();
+            REQUIRE(document->isPortalFileLoaded());
+            CHECK(document->portalFile()->portals().size() == 5u);
+
+            document->unloadPortalFile();
+            CHECK_FALSE(document->isPortalFileLoaded());
+        }
     }
 }
@@ -0,0 +1,173 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FloatType.h"
+#include "PreferenceManager.h"
+#include "Preferences.h"
+#include "Model/PickResult.h"
+#include "Renderer/PerspectiveCamera.h"
+#include "View/VertexHandleManager.h"
+
+#include <vecmath/ray.h>
+#include <vecmath/segment.h>
+#include <vecmath/vec.h>
+
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace View {
+        static std::vector<vm::vec3> makePositions() {
+            // spread the handles over several cells of the spatial index
+            std::vector<vm::vec3> result;
+            for (int x = -1024; x <= 1024; x += 128) {
+                for (int y = -1024; y <= 1024; y += 128) {
+                    for (int z = -1024; z <= 1024; z += 128) {
+                        result.emplace_back(x, y, z);
+                    }
+                }
+            }
+            return result;
+        }
+
+        static Renderer::PerspectiveCamera makeCamera() {
+            const Renderer::Camera::Viewport viewport(0, 0, 1920, 1080);
+            return Renderer::PerspectiveCamera(90.0f, 1.0f, 8000.0f, viewport, vm::vec3f(256.0f, -2048.0f, 128.0f), vm::vec3f::pos_y(), vm::vec3f::pos_z());
+        }
+
+        static size_t countPointHits(const vm::ray3& pickRay, const Renderer::Camera& camera, const std::vector<vm::vec3>& positions) {
+            const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+
+            size_t result = 0u;
+            for (const auto& position : positions) {
+                if (!vm::is_nan(camera.pickPointHandle(pickRay, position, handleRadius))) {
+                    ++result;
+                }
+            }
+            return result;
+        }
+
+        TEST_CASE("VertexHandleManagerTest.pick", "[VertexHandleManagerTest]") {
+            const auto positions = makePositions();
+            const auto camera = makeCamera();
+
+            VertexHandleManager manager;
+            for (const auto& position : positions) {
+                manager.add(position);
+            }
+
+            const auto targets = std::vector<vm::vec3>{
+                vm::vec3(0, 0, 0),
+                vm::vec3(1024, 1024, 1024),
+                vm::vec3(-1024, -1024, -1024),
+                vm::vec3(128, -512, 256),
+                vm::vec3(-64, 300, 2),
+                vm::vec3(4096, 0, 0),
+            };
+
+            for (const auto& target : targets) {
+                const auto pickRay = vm::ray3(vm::vec3(camera.position()), vm::normalize(target - vm::vec3(camera.position())));
+
+                Model::PickResult pickResult;
+                manager.pick(pickRay, camera, pickResult);
+                CHECK(pickResult.size() == countPointHits(pickRay, camera, positions));
+            }
+        }
+
+        TEST_CASE("VertexHandleManagerTest.pickAfterRemove", "[VertexHandleManagerTest]") {
+            const auto camera = makeCamera();
+            const auto position = vm::vec3(128, 512, 256);
+            const auto pickRay = vm::ray3(vm::vec3(camera.position()), vm::normalize(position - vm::vec3(camera.position())));
+
+            VertexHandleManager manager;
+            manager.add(position);
+            manager.add(position);
+
+            Model::PickResult pickResult;
+            manager.pick(pickRay, camera, pickResult);
+            CHECK(pickResult.size() == 1u);
+
+            CHECK(manager.remove(position));
+
+            pickResult.clear();
+            manager.pick(pickRay, camera, pickResult);
+            CHECK(pickResult.size() == 1u);
+
+            CHECK(manager.remove(position));
+            CHECK_FALSE(manager.remove(position));
+
+            pickResult.clear();
+            manager.pick(pickRay, camera, pickResult);
+            CHECK(pickResult.empty());
+
+            manager.add(position);
+            manager.clear();
+
+            pickResult.clear();
+            manager.pick(pickRay, camera, pickResult);
+            CHECK(pickResult.empty());
+        }
+
+        TEST_CASE("VertexHandleManagerTest.selectCloseHandles", "[VertexHandleManagerTest]") {
+            // the second handle lies in a neighbouring cell of the spatial index, but it is close to the first one
+            const auto handle1 = vm::vec3(256.0, 0.0, 0.0);
+            const auto handle2 = vm::vec3(255.9999995, 0.0, 0.0);
+            const auto handle3 = vm::vec3(255.0, 0.0, 0.0);
+
+            VertexHandleManager manager;
+            manager.add(handle1);
+            manager.add(handle2);
+            manager.add(handle3);
+
+            manager.select(handle1);
+            CHECK(manager.selected(handle1));
+            CHECK(manager.selected(handle2));
+            CHECK_FALSE(manager.selected(handle3));
+            CHECK(manager.selectedHandleCount() == 2u);
+        }
+
+        TEST_CASE("EdgeHandleManagerTest.pickCenterHandle", "[EdgeHandleManagerTest]") {
+            const auto positions = makePositions();
+            const auto camera = makeCamera();
+
+            EdgeHandleManager manager;
+            std::vector<vm::vec3> centers;
+            for (const auto& position : positions) {
+                const auto edge = vm::segment3(position, position + vm::vec3(64, 64, 0));
+                manager.add(edge);
+                centers.push_back(edge.center());
+            }
+
+            const auto targets = std::vector<vm::vec3>{
+                vm::vec3(32, 32, 0),
+                vm::vec3(-992, 1056, 1024),
+                vm::vec3(-64, 300, 2),
+            };
+
+            for (const auto& target : targets) {
+                const auto pickRay = vm::ray3(vm::vec3(camera.position()), vm::normalize(target - vm::vec3(camera.position())));
+
+                Model::PickResult pickResult;
+                manager.pickCenterHandle(pickRay, camera, pickResult);
+                CHECK(pickResult.size() == countPointHits(pickRay, camera, centers));
+            }
+        }
+    }
+}
@@ -23,6 +23,7 @@
 
 #include <cassert>
 #include <exception>
+#include <iterator>
 #include <set>
 #include <string>
 #include <string_view>
@@ -252,15 +253,19 @@ namespace kdl {
             m_key(std::move(key)) {}
 
             /**
-             * Inserts the given value into this node's subtree. If this node's key is empty, then it is the root node.
+             * Inserts the values in the given range into this node's subtree. If this node's key is empty, then it is
+             * the root node.
              *
              * Precondition: Unless this node is the root node, the given key must share a non-empty prefix with this
              * node's key.
              *
+             * @tparam I the type of the value iterators
              * @param key the key to insert
-             * @param value the value to insert
+             * @param values_cur the start of the range of values to insert
+             * @param values_end the end of the range of values to insert
              */
-            void insert(const std::string_view key, const V& value) const {
+            template <typename I>
+            void insert(const std::string_view key, I values_cur, I values_end) const {
                 /*
                  Possible cases for insertion:
                   index: 01234567 |   | #m_key: 6
@@ -292,11 +297,11 @@ namespace kdl {
                         // the remainder of key and insert there
                         const auto remainder = key.substr(mismatch);
                         const auto& child = *m_children.insert(node(std::string(remainder))).first;
-                        child.insert(remainder, value);
+                        child.insert(remainder, values_cur, values_end);
                     } else { // mismatch == m_key.size()
                         // case 2: key and m_key have a common prefix, split this node and insert again
                         split_node(mismatch);
-                        insert(key, value);
+                        insert(key, values_cur, values_end);
                     }
                 } else if (mismatch == key.size()) {
                     // cases 3, 4: key is a prefix of m_key, or key == m_key
@@ -304,19 +309,24 @@ namespace kdl {
                         // case 3: key is a prefix of m_key, split this node
                         split_node(mismatch);
                     }
-                    insert_value(value);
+                    while (values_cur != values_end) {
+                        insert_value(*values_cur++);
+                    }
                 }
             }
 
             /**
-             * Removes the given value from this node's subtree.
+             * Removes the values in the given range from this node's subtree.
              *
+             * @tparam I the type of the value iterators
              * @param key the key to remove
-             * @param value the value to remove
-             * @return true if the given key and value were removed from this node's subtree
+             * @param values_cur the start of the range of values to remove
+             * @param values_end the end of the range of values to remove
+             * @return the number of values that were removed from this node's subtree
              */
-            bool remove(const std::string_view key, const V& value) const {
-                bool result = false;
+            template <typename I>
+            std::size_t remove(const std::string_view key, I values_cur, I values_end) const {
+                std::size_t result = 0u;
 
                 const std::size_t mismatch = kdl::cs::str_mismatch(key, m_key);
                 if (m_key.size() <= key.length() && mismatch == m_key.length()) {
@@ -327,13 +337,17 @@ namespace kdl {
                         const auto it = m_children.find(remainder);
                         assert(it != std::end(m_children));
 
-                        result = it->remove(remainder, value);
+                        result = it->remove(remainder, values_cur, values_end);
                         if (!it->m_key.empty() && it->m_values.empty() && it->m_children.empty()) {
                             m_children.erase(it);
                         }
                     } else {
                         // m_key == key
-                        result = remove_value(value);
+                        while (values_cur != values_end) {
+                            if (remove_value(*values_cur++)) {
+                                ++result;
+                            }
+                        }
                     }
 
                     if (!m_key.empty() && m_values.empty() && m_children.size() == 1u) {
@@ -659,7 +673,23 @@ namespace kdl {
          * @param value the value to insert
          */
         void insert(const std::string_view key, const V& value) {
-            m_root.insert(key, value);
+            m_root.insert(key, &value, std::next(&value));
+        }
+
+        /**
+         * Inserts the values in the given range under the given key. This is more efficient than inserting each value
+         * individually because the node for the given key is only looked up once.
+         *
+         * @tparam I the type of the value iterators
+         * @param key the key to insert
+         * @param values_begin the start of the range of values to insert
+         * @param values_end the end of the range of values to insert
+         */
+        template <typename I>
+        void insert(const std::string_view key, I values_begin, I values_end) {
+            if (values_begin != values_end) {
+                m_root.insert(key, values_begin, values_end);
+            }
         }
 
         /**
@@ -670,7 +700,25 @@ namespace kdl {
          * @return `true` if the given value was found under the given key, and `false` otherwise
          */
         bool remove(const std::string_view key, const V& value) {
-            return m_root.remove(key, value);
+            return m_root.remove(key, &value, std::next(&value)) > 0u;
+        }
+
+        /**
+         * Removes the values in the given range using the given key. This is more efficient than removing each value
+         * individually because the node for the given key is only looked up once.
+         *
+         * @tparam I the type of the value iterators
+         * @param key the key to remove
+         * @param values_begin the start of the range of values to remove
+         * @param values_end the end of the range of values to remove
+         * @return the number of values that were found under the given key and removed
+         */
+        template <typename I>
+        std::size_t remove(const std::string_view key, I values_begin, I values_end) {
+            if (values_begin == values_end) {
+                return 0u;
+            }
+            return m_root.remove(key, values_begin, values_end);
         }
 
         /**
@@ -33,6 +33,10 @@ namespace kdl {
      * Because the threads are spawned with std::async(std::launch::async, ...) and no thread pool is used,
      * there is a relatively large overhead and this should only be used on large/slow to process data sets.
      *
+     * If the lambda throws an exception, the thread that called it stops processing indices. Once all threads have
+     * finished, the exception is rethrown on the calling thread. If several calls throw, only one of the exceptions is
+     * rethrown.
+     *
      * @tparam L type of lambda
      * @param count the maximum value (exclusive) to pass to lambda
      * @param lambda the lambda to run
@@ -64,6 +68,12 @@ namespace kdl {
         for (size_t i = 0; i < numThreads; ++i) {
             threads[i].wait();
         }
+
+        // rethrow any exception thrown by the lambda only after all threads have finished, since they refer to the
+        // lambda and to nextIndex
+        for (size_t i = 0; i < numThreads; ++i) {
+            threads[i].get();
+        }
     }
 
     /**
@@ -104,6 +104,43 @@ namespace kdl {
         assertMatches(index, "*", {});
     }
 
+    TEST_CASE("compact_trie_test.insert_range", "[compact_trie_test]") {
+        test_index index;
+        index.insert("key", "value");
+
+        const auto values = std::vector<std::string>{ "value", "value2", "value3" };
+        index.insert("key", std::begin(values), std::end(values));
+        index.insert("key2", std::begin(values), std::end(values));
+        index.insert("ke", std::begin(values), std::begin(values));
+
+        assertMatches(index, "key", { "value", "value", "value2", "value3" });
+        assertMatches(index, "key2", { "value", "value2", "value3" });
+        assertMatches(index, "ke", {});
+
+        std::vector<std::string> keys;
+        index.get_keys(std::back_inserter(keys));
+        CHECK_THAT(keys, Catch::UnorderedEquals(std::vector<std::string>{ "key", "key2" }));
+    }
+
+    TEST_CASE("compact_trie_test.remove_range", "[compact_trie_test]") {
+        test_index index;
+        index.insert("andrew", "value");
+        index.insert("andrew", "value2");
+        index.insert("andrew", "value3");
+        index.insert("andreas", "value");
+
+        const auto values = std::vector<std::string>{ "value", "value3", "value4" };
+        CHECK(index.remove("andrew", std::begin(values), std::end(values)) == 2u);
+        assertMatches(index, "andrew", { "value2" });
+        assertMatches(index, "andreas", { "value" });
+
+        CHECK(index.remove("andrew", std::begin(values), std::begin(values)) == 0u);
+
+        const auto remainingValues = std::vector<std::string>{ "value2" };
+        CHECK(index.remove("andrew", std::begin(remainingValues), std::end(remainingValues)) == 1u);
+        assertMatches(index, "andr*", { "value" });
+    }
+
     TEST_CASE("compact_trie_test.find_matches_with_exact_pattern", "[compact_trie_test]") {
         test_index index;
         index.insert("key", "value");
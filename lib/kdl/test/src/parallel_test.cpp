@@ -19,6 +19,7 @@
 
 #include <array>
 #include <atomic>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -61,6 +62,21 @@ namespace kdl {
         }
     }
 
+    TEST_CASE("for throwing", "[parallel_test]") {
+        constexpr size_t TestSize = 10'000;
+
+        std::atomic<size_t> count(0);
+        CHECK_THROWS_AS(kdl::parallel_for(TestSize, [&](const size_t i) {
+            ++count;
+            if (i == TestSize / 2u) {
+                throw std::runtime_error("test");
+            }
+        }), std::runtime_error);
+
+        // the exception is only rethrown after all threads have finished
+        CHECK(count > TestSize / 2u);
+    }
+
     TEST_CASE("transform", "[parallel_test]") {
         const auto L = [](const int& v) { return v * 10; };
 